@@ -0,0 +1,34 @@
+#ifndef ARTNET_RECEIVER_H
+#define ARTNET_RECEIVER_H
+
+#include <Arduino.h>
+
+// Raw lwIP UDP receiver - datagrams are handed to the parser straight from the
+// pbuf inside the lwIP thread, without the AsyncUDP packet queue and per-packet
+// AsyncUDPPacket copy. Set to 0 to fall back to the AsyncUDP listener.
+#ifndef ARTNET_RAW_RECEIVER
+#define ARTNET_RAW_RECEIVER 1
+#endif
+
+// Largest datagram flattened when lwIP delivers a chained pbuf (ArtDmx is 530 bytes)
+#define ARTNET_MAX_PACKET_SIZE 600
+
+// Called from the lwIP thread for every datagram; data is only valid during the call
+typedef void (*ArtNetDatagramHandler)(const uint8_t *data, size_t len);
+
+// Bind a UDP pcb on the port (all interfaces) and route datagrams to handler
+bool artnetReceiverBegin(uint16_t port, ArtNetDatagramHandler handler);
+
+// Unbind and release the pcb - no handler call is in flight once this returns
+void artnetReceiverEnd();
+
+bool artnetReceiverRunning();
+
+// Send a datagram from the receiver's pcb (IPv4, address in network byte order).
+// Blocks until the lwIP thread has queued it; the data is copied.
+bool artnetReceiverSendTo(const uint8_t *data, uint16_t length, uint32_t address, uint16_t port);
+
+// Datagrams that arrived as a chained pbuf and had to be copied
+uint32_t artnetReceiverChainedCount();
+
+#endif // ARTNET_RECEIVER_H
@@ -0,0 +1,432 @@
+#include "E131Receiver.h"
+#include "ESP_GPT_I2C_Common.h"
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include "lwip/igmp.h"
+#include "lwip/priv/tcpip_priv.h"
+
+// Root layer
+#define E131_ROOT_VECTOR 18
+#define E131_ROOT_CID 22
+#define E131_CID_SIZE 16
+#define E131_ROOT_SIZE 38
+#define E131_VECTOR_ROOT_DATA 0x00000004
+#define E131_VECTOR_ROOT_EXTENDED 0x00000008
+
+// Framing layer of a data packet
+#define E131_FRAMING_VECTOR 40
+#define E131_FRAMING_PRIORITY 108
+#define E131_FRAMING_SYNC_ADDRESS 109
+#define E131_FRAMING_SEQUENCE 111
+#define E131_FRAMING_OPTIONS 112
+#define E131_FRAMING_UNIVERSE 113
+#define E131_VECTOR_DATA_PACKET 0x00000002
+#define E131_OPTION_PREVIEW 0x80
+#define E131_OPTION_TERMINATED 0x40
+
+// DMP layer
+#define E131_DMP_VECTOR 117
+#define E131_DMP_ADDRESS_TYPE 118
+#define E131_DMP_FIRST_ADDRESS 119
+#define E131_DMP_INCREMENT 121
+#define E131_DMP_COUNT 123
+#define E131_DMP_START_CODE 125
+#define E131_DMP_DATA 126
+#define E131_VECTOR_DMP_SET_PROPERTY 0x02
+#define E131_DMP_ADDRESS_TYPE_DATA 0xA1
+
+// Synchronization packet (extended framing layer)
+#define E131_SYNC_ADDRESS 45
+#define E131_SYNC_SIZE 49
+#define E131_VECTOR_EXTENDED_SYNC 0x00000001
+
+static const uint8_t acnPacketIdentifier[12] = {0x41, 0x53, 0x43, 0x2D, 0x45, 0x31, 0x2E, 0x31, 0x37, 0x00, 0x00, 0x00};
+
+// The source that owns a universe
+struct E131Source
+{
+  uint8_t cid[E131_CID_SIZE];
+  uint8_t priority;
+  uint8_t sequence;
+  uint32_t lastMs;
+  bool active;
+};
+
+// Only touched from the lwIP thread once bound
+static struct udp_pcb *receiverPcb = NULL;
+static uint8_t chainScratch[E131_MAX_PACKET_SIZE];
+static E131Source sources[FRAME_MAX_UNIVERSES];
+static uint16_t firstUniverse = 0;
+static uint8_t universeCount = 0;
+static uint16_t syncUniverse = 0;
+static bool syncJoined = false;
+
+static E131Stats stats;
+
+struct E131Call
+{
+  struct tcpip_api_call_data call;
+  err_t err;
+};
+
+static inline uint16_t readUint16(const uint8_t *data)
+{
+  return (data[0] << 8) | data[1];
+}
+
+static inline uint32_t readUint32(const uint8_t *data)
+{
+  return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+}
+
+static err_t changeGroup(uint16_t universe, bool join)
+{
+  ip4_addr_t group;
+  IP4_ADDR(&group, 239, 255, universe >> 8, universe & 0xFF);
+  return join ? igmp_joingroup(IP4_ADDR_ANY4, &group) : igmp_leavegroup(IP4_ADDR_ANY4, &group);
+}
+
+// Universe synchronization: latch the frame once the controller says so
+static void processSync(const uint8_t *data, size_t len)
+{
+  if (len < E131_SYNC_SIZE || readUint32(data + E131_FRAMING_VECTOR) != E131_VECTOR_EXTENDED_SYNC)
+  {
+    perfCountMalformed();
+    return;
+  }
+
+  uint16_t address = readUint16(data + E131_SYNC_ADDRESS);
+  if (address != 0 && address == syncUniverse)
+  {
+    stats.syncs++;
+    framePipelineSync();
+  }
+}
+
+// Priority and sequence arbitration - true if the packet is live data of the owning source
+static bool acceptSource(E131Source &source, const uint8_t *cid, uint8_t priority, uint8_t sequence, uint8_t options)
+{
+  uint32_t now = millis();
+  if (source.active && now - source.lastMs > E131_SOURCE_TIMEOUT_MS)
+  {
+    source.active = false;
+    stats.timeouts++;
+  }
+  bool owner = source.active && memcmp(source.cid, cid, E131_CID_SIZE) == 0;
+
+  if (options & E131_OPTION_TERMINATED)
+  {
+    if (owner)
+    {
+      source.active = false;
+      stats.terminated++;
+    }
+    return false;
+  }
+  if (options & E131_OPTION_PREVIEW)
+  {
+    stats.preview++;
+    return false;
+  }
+
+  if (owner)
+  {
+    // E1.31 6.7.2: a sequence number up to 20 behind the last one is stale
+    int8_t diff = (int8_t)(sequence - source.sequence);
+    if (diff <= 0 && diff > -E131_SEQUENCE_WINDOW)
+    {
+      stats.outOfOrder++;
+      return false;
+    }
+  }
+  else if (source.active && priority <= source.priority)
+  {
+    stats.lowerPriority++;
+    return false;
+  }
+  else
+  {
+    memcpy(source.cid, cid, E131_CID_SIZE);
+    source.active = true;
+    stats.sourceChanges++;
+  }
+
+  source.priority = priority;
+  source.sequence = sequence;
+  source.lastMs = now;
+  return true;
+}
+
+// Parse one sACN datagram. Runs in the lwIP thread, so it must never block.
+static void processE131Data(const uint8_t *data, size_t len)
+{
+  uint32_t parseStart = perfTimestamp();
+
+  // Root layer - anything that is not ACN is not ours
+  if (len < E131_ROOT_SIZE || readUint16(data) != 0x0010 || readUint16(data + 2) != 0 ||
+      memcmp(data + 4, acnPacketIdentifier, sizeof(acnPacketIdentifier)) != 0)
+  {
+    perfCountMalformed();
+    return;
+  }
+
+  uint32_t rootVector = readUint32(data + E131_ROOT_VECTOR);
+  if (rootVector == E131_VECTOR_ROOT_EXTENDED)
+  {
+    processSync(data, len);
+    return;
+  }
+
+  if (rootVector != E131_VECTOR_ROOT_DATA || len < E131_DMP_DATA ||
+      readUint32(data + E131_FRAMING_VECTOR) != E131_VECTOR_DATA_PACKET ||
+      data[E131_DMP_VECTOR] != E131_VECTOR_DMP_SET_PROPERTY || data[E131_DMP_ADDRESS_TYPE] != E131_DMP_ADDRESS_TYPE_DATA ||
+      readUint16(data + E131_DMP_FIRST_ADDRESS) != 0 || readUint16(data + E131_DMP_INCREMENT) != 1 ||
+      readUint16(data + E131_DMP_COUNT) == 0)
+  {
+    perfCountMalformed();
+    return;
+  }
+
+  uint16_t universe = readUint16(data + E131_FRAMING_UNIVERSE);
+  if (universe < firstUniverse || universe >= firstUniverse + universeCount)
+  {
+    perfCountOutOfUniverse();
+    perfRecord(PERF_STAGE_PARSE, parseStart);
+    return;
+  }
+  stats.packets++;
+
+  // Start code 0 is dimmer levels - per-address priority (0xDD) and the rest are ignored
+  if (data[E131_DMP_START_CODE] != 0)
+  {
+    stats.otherStartCode++;
+    perfRecord(PERF_STAGE_PARSE, parseStart);
+    return;
+  }
+
+  if (!acceptSource(sources[universe - firstUniverse], data + E131_ROOT_CID,
+                    min(data[E131_FRAMING_PRIORITY], (uint8_t)E131_MAX_PRIORITY),
+                    data[E131_FRAMING_SEQUENCE], data[E131_FRAMING_OPTIONS]))
+  {
+    perfRecord(PERF_STAGE_PARSE, parseStart);
+    return;
+  }
+
+  // The property count includes the start code; never trust it beyond what was received
+  uint16_t dataLength = readUint16(data + E131_DMP_COUNT) - 1;
+  if (dataLength > len - E131_DMP_DATA)
+  {
+    perfCountMalformed();
+    dataLength = len - E131_DMP_DATA;
+  }
+
+  // A controller that synchronizes its universes sends the sync packets to that
+  // universe's group - join it once, on top of the data groups
+  uint16_t address = readUint16(data + E131_FRAMING_SYNC_ADDRESS);
+  if (address != syncUniverse)
+  {
+    if (syncJoined && changeGroup(syncUniverse, false) == ERR_OK)
+    {
+      stats.groups--;
+    }
+    syncJoined = false;
+    syncUniverse = address;
+    if (address >= E131_MIN_UNIVERSE && address <= E131_MAX_UNIVERSE &&
+        (address < firstUniverse || address >= firstUniverse + universeCount))
+    {
+      syncJoined = changeGroup(address, true) == ERR_OK;
+      if (syncJoined)
+      {
+        stats.groups++;
+      }
+      else
+      {
+        stats.joinErrors++;
+      }
+    }
+  }
+
+  // Same universe map as ArtNet - the pipeline latches once the frame is complete
+  if (!framePipelineWriteUniverse(universe - E131_UNIVERSE_OFFSET, data + E131_DMP_DATA, dataLength))
+  {
+    perfCountOutOfUniverse();
+    perfRecord(PERF_STAGE_PARSE, parseStart);
+    return;
+  }
+  stats.accepted++;
+
+  // Shared with ArtNet - both parsers run in the lwIP thread
+  if (state.artnetPacketCount == 0)
+  {
+    bootMark(BOOT_STAGE_FIRST_PACKET);
+  }
+  state.artnetPacketCount++;
+  state.lastArtnetPacket = millis();
+  perfRecord(PERF_STAGE_PARSE, parseStart);
+}
+
+// Runs in the lwIP thread: parse directly out of the pbuf, then release it
+static void receiverRecv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+  if (p == NULL)
+  {
+    return;
+  }
+
+  heapMonitorSetPath(HEAP_PATH_PACKET);
+  if (p->len == p->tot_len)
+  {
+    processE131Data((const uint8_t *)p->payload, p->len);
+  }
+  else
+  {
+    uint16_t copied = pbuf_copy_partial(p, chainScratch, sizeof(chainScratch), 0);
+    processE131Data(chainScratch, copied);
+  }
+  heapMonitorSetPath(HEAP_PATH_NONE);
+
+  pbuf_free(p);
+}
+
+static err_t receiverBind(struct tcpip_api_call_data *data)
+{
+  E131Call *call = (E131Call *)data;
+
+  receiverPcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+  if (receiverPcb == NULL)
+  {
+    call->err = ERR_MEM;
+    return call->err;
+  }
+
+  call->err = udp_bind(receiverPcb, IP_ANY_TYPE, E131_PORT);
+  if (call->err != ERR_OK)
+  {
+    udp_remove(receiverPcb);
+    receiverPcb = NULL;
+    return call->err;
+  }
+
+  // lwIP has a handful of IGMP groups - universes past that still get unicast sACN
+  for (uint8_t i = 0; i < universeCount; i++)
+  {
+    if (changeGroup(firstUniverse + i, true) == ERR_OK)
+    {
+      stats.groups++;
+    }
+    else
+    {
+      stats.joinErrors++;
+    }
+  }
+
+  udp_recv(receiverPcb, receiverRecv, NULL);
+  return call->err;
+}
+
+static err_t receiverUnbind(struct tcpip_api_call_data *data)
+{
+  E131Call *call = (E131Call *)data;
+
+  if (receiverPcb != NULL)
+  {
+    udp_recv(receiverPcb, NULL, NULL);
+    udp_remove(receiverPcb);
+    receiverPcb = NULL;
+
+    for (uint8_t i = 0; i < universeCount; i++)
+    {
+      changeGroup(firstUniverse + i, false);
+    }
+    if (syncJoined)
+    {
+      changeGroup(syncUniverse, false);
+    }
+    syncJoined = false;
+    syncUniverse = 0;
+    stats.groups = 0;
+  }
+
+  call->err = ERR_OK;
+  return call->err;
+}
+
+bool e131ReceiverBegin(uint16_t first, uint8_t count)
+{
+  if (receiverPcb != NULL)
+  {
+    e131ReceiverEnd();
+  }
+
+  count = min(count, (uint8_t)FRAME_MAX_UNIVERSES);
+  if (first < E131_MIN_UNIVERSE || first + count - 1 > E131_MAX_UNIVERSE)
+  {
+    debugLog("sACN setup failed - universes " + String(first) + "+" + String(count) + " out of range");
+    return false;
+  }
+
+  firstUniverse = first;
+  universeCount = count;
+  memset(sources, 0, sizeof(sources));
+  memset(&stats, 0, sizeof(stats));
+
+  E131Call call;
+  call.err = ERR_OK;
+  tcpip_api_call(receiverBind, &call.call);
+
+  if (stats.joinErrors > 0)
+  {
+    debugLog("sACN: joined " + String(stats.groups) + " of " + String(count) + " multicast groups");
+  }
+  return call.err == ERR_OK;
+}
+
+void e131ReceiverEnd()
+{
+  // Runs in the lwIP thread, so no receiverRecv can be executing afterwards
+  E131Call call;
+  call.err = ERR_OK;
+  tcpip_api_call(receiverUnbind, &call.call);
+}
+
+bool e131ReceiverRunning()
+{
+  return receiverPcb != NULL;
+}
+
+void e131ReceiverGetStats(E131Stats *copy)
+{
+  *copy = stats;
+
+  uint32_t now = millis();
+  copy->activeSources = 0;
+  for (uint8_t i = 0; i < universeCount; i++)
+  {
+    if (sources[i].active && now - sources[i].lastMs <= E131_SOURCE_TIMEOUT_MS)
+    {
+      copy->activeSources++;
+    }
+  }
+}
+
+String e131StatsJson()
+{
+  E131Stats copy;
+  e131ReceiverGetStats(&copy);
+
+  String json = "{\"running\":" + String(e131ReceiverRunning() ? "true" : "false");
+  json += ",\"packets\":" + String(copy.packets);
+  json += ",\"accepted\":" + String(copy.accepted);
+  json += ",\"outOfOrder\":" + String(copy.outOfOrder);
+  json += ",\"lowerPriority\":" + String(copy.lowerPriority);
+  json += ",\"preview\":" + String(copy.preview);
+  json += ",\"otherStartCode\":" + String(copy.otherStartCode);
+  json += ",\"terminated\":" + String(copy.terminated);
+  json += ",\"timeouts\":" + String(copy.timeouts);
+  json += ",\"sourceChanges\":" + String(copy.sourceChanges);
+  json += ",\"syncs\":" + String(copy.syncs);
+  json += ",\"groups\":" + String(copy.groups);
+  json += ",\"joinErrors\":" + String(copy.joinErrors);
+  json += ",\"activeSources\":" + String(copy.activeSources) + "}";
+  return json;
+}
@@ -0,0 +1,67 @@
+#ifndef E131_RECEIVER_H
+#define E131_RECEIVER_H
+
+#include <Arduino.h>
+#include "FramePipeline.h"
+
+// sACN (ANSI E1.31) receiver - a second input next to ArtNet feeding the same
+// universe map and frame pipeline. A raw lwIP pcb on port 5568 joins the
+// multicast group 239.255.<hi>.<lo> of every mapped universe; unicast sACN is
+// accepted as well. Datagrams are parsed in the lwIP thread like ArtNet.
+//
+// Per universe the highest-priority source wins, a tie keeps the current one
+// (no HTP merge). A source is dropped once it terminates its stream or has been
+// silent for E131_SOURCE_TIMEOUT_MS; packets that are out of order by the
+// sequence number rule of E1.31 6.7.2 are discarded.
+
+#define E131_PORT 5568
+
+// sACN numbers universes from 1 - universe u of the map is sACN universe
+// u + E131_UNIVERSE_OFFSET, so ArtNet 0 and sACN 1 address the same pixels
+#ifndef E131_UNIVERSE_OFFSET
+#define E131_UNIVERSE_OFFSET 1
+#endif
+
+#define E131_MIN_UNIVERSE 1
+#define E131_MAX_UNIVERSE 63999
+#define E131_MAX_PRIORITY 200
+#define E131_SOURCE_TIMEOUT_MS 2500
+
+// Sequence numbers up to this far behind the last one are late, anything
+// further back is a restarted source
+#define E131_SEQUENCE_WINDOW 20
+
+// Largest datagram flattened when lwIP delivers a chained pbuf (a full universe is 638 bytes)
+#define E131_MAX_PACKET_SIZE 640
+
+struct E131Stats
+{
+  uint32_t packets;        // Data packets for a mapped universe
+  uint32_t accepted;       // Written into the frame pipeline
+  uint32_t outOfOrder;     // Discarded by the sequence number check
+  uint32_t lowerPriority;  // From a source that does not own the universe
+  uint32_t preview;        // Preview data, not for live output
+  uint32_t otherStartCode; // Non-zero start codes (per-address priority and others)
+  uint32_t terminated;     // Stream terminated by the owning source
+  uint32_t timeouts;       // Owning source silent for E131_SOURCE_TIMEOUT_MS
+  uint32_t sourceChanges;  // A new source took a universe over
+  uint32_t syncs;          // Universe synchronization packets
+  uint8_t groups;          // Multicast groups joined
+  uint8_t joinErrors;      // Groups lwIP could not join (MEMP_NUM_IGMP_GROUP)
+  uint8_t activeSources;   // Universes currently owned by a source
+};
+
+// Bind the pcb and join the groups of count sACN universes starting at firstUniverse
+bool e131ReceiverBegin(uint16_t firstUniverse, uint8_t count);
+
+// Leave the groups and release the pcb - no packet is being parsed once this returns
+void e131ReceiverEnd();
+
+bool e131ReceiverRunning();
+
+void e131ReceiverGetStats(E131Stats *stats);
+
+// {"packets":..,"accepted":..,"outOfOrder":..,..,"groups":..,"activeSources":..}
+String e131StatsJson();
+
+#endif // E131_RECEIVER_H
@@ -0,0 +1,248 @@
+#ifndef EMBEDDED_WEB_UI_H
+#define EMBEDDED_WEB_UI_H
+
+#include <Arduino.h>
+
+// Generated by scripts/embed_web_ui.py from web/embedded_ui.html - do not edit.
+// Gzip-compressed, served as-is with Content-Encoding: gzip
+// (12415 bytes uncompressed).
+#define EMBEDDED_UI_GZ_LENGTH 3732
+
+static const uint8_t EMBEDDED_UI_GZ[EMBEDDED_UI_GZ_LENGTH] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x1b, 0x6b, 0x73, 0xdb, 0x36,
+    0xf2, 0xbb, 0x7e, 0x05, 0x92, 0x3e, 0x28, 0x5d, 0x2c, 0xea, 0x65, 0xab, 0x3e, 0x5b, 0xd2, 0x8d,
+    0xe3, 0xd8, 0x17, 0xcf, 0x39, 0x8e, 0x27, 0x4a, 0xae, 0x73, 0x93, 0x7a, 0xc6, 0x10, 0x09, 0x4a,
+    0xb8, 0x50, 0xa4, 0x8e, 0x84, 0xfc, 0x68, 0xaa, 0xff, 0x7e, 0xbb, 0x0b, 0xf0, 0x29, 0xca, 0xa1,
+    0xfb, 0x68, 0xa6, 0x0d, 0x09, 0xec, 0x7b, 0x17, 0xbb, 0x8b, 0xa5, 0x3a, 0x7a, 0xf1, 0xe6, 0xfd,
+    0xe9, 0xc7, 0xff, 0x5c, 0x9f, 0xb1, 0x85, 0x5a, 0xfa, 0x93, 0x91, 0xf9, 0xaf, 0xe0, 0xee, 0xa4,
+    0x31, 0x52, 0x52, 0xf9, 0x62, 0x72, 0x36, 0xbd, 0x1e, 0xf4, 0xd9, 0x45, 0xff, 0x94, 0x9d, 0x86,
+    0x81, 0x8a, 0x42, 0xdf, 0x17, 0xd1, 0xa8, 0xa3, 0xf7, 0x1a, 0xa3, 0xa5, 0x50, 0x9c, 0x05, 0x7c,
+    0x29, 0xc6, 0xd6, 0x9d, 0x14, 0xf7, 0xab, 0x30, 0x52, 0x16, 0x73, 0x00, 0x50, 0x04, 0x6a, 0x6c,
+    0xdd, 0x4b, 0x57, 0x2d, 0xc6, 0xae, 0xb8, 0x93, 0x8e, 0x68, 0xd3, 0xcb, 0x1e, 0x93, 0x81, 0x54,
+    0x92, 0xfb, 0xed, 0xd8, 0xe1, 0xbe, 0x18, 0xf7, 0x2c, 0x20, 0x12, 0xab, 0x47, 0x24, 0x36, 0x0b,
+    0xdd, 0x47, 0xf6, 0x95, 0x79, 0x80, 0xdd, 0xf6, 0xf8, 0x52, 0xfa, 0x8f, 0x47, 0xec, 0x24, 0x02,
+    0xd8, 0x3d, 0x16, 0xf3, 0x20, 0x6e, 0xc7, 0x22, 0x92, 0xde, 0x31, 0x5b, 0xf2, 0x68, 0x2e, 0x83,
+    0x23, 0xd6, 0xef, 0xae, 0x1e, 0x8e, 0xd9, 0x8c, 0x3b, 0x5f, 0xe6, 0x51, 0xb8, 0x0e, 0xdc, 0xb6,
+    0x13, 0xfa, 0x61, 0x74, 0xc4, 0xbe, 0xf3, 0x0e, 0xf0, 0xcf, 0x31, 0xdb, 0x34, 0x6c, 0x94, 0x84,
+    0xcb, 0x40, 0x44, 0x40, 0x77, 0xc9, 0x1f, 0xb4, 0x0c, 0x47, 0xec, 0xb0, 0x4b, 0xb8, 0x09, 0xa5,
+    0x2e, 0xe3, 0x6b, 0x15, 0x56, 0xd1, 0xba, 0x5f, 0x48, 0x25, 0x8e, 0xd9, 0x8a, 0xbb, 0xae, 0x0c,
+    0xe6, 0x29, 0xcf, 0x30, 0x72, 0x45, 0xd4, 0x8e, 0xb8, 0x2b, 0xd7, 0xf1, 0x11, 0x3b, 0xd0, 0x6b,
+    0x0f, 0xed, 0x78, 0xc1, 0xdd, 0xf0, 0x1e, 0xe9, 0xf5, 0x57, 0x0f, 0xac, 0x07, 0xb0, 0x2c, 0x9a,
+    0xcf, 0x78, 0xb3, 0xbb, 0x47, 0x7f, 0xec, 0x5e, 0x8b, 0x84, 0xf2, 0xc2, 0x68, 0xd9, 0x46, 0x3e,
+    0x2b, 0x92, 0x0a, 0x65, 0x68, 0xcf, 0x42, 0xa5, 0xc2, 0xe5, 0x11, 0xeb, 0x11, 0xb1, 0x4d, 0xc3,
+    0xe7, 0x33, 0xe1, 0xc3, 0xb6, 0x2b, 0xe3, 0x95, 0xcf, 0xc1, 0x10, 0x32, 0xf0, 0x41, 0x8f, 0xf6,
+    0xcc, 0x0f, 0x9d, 0x2f, 0xc7, 0xcc, 0xe8, 0xd1, 0x3b, 0x20, 0x79, 0xc8, 0x62, 0xf7, 0x42, 0xce,
+    0x17, 0xea, 0x08, 0x04, 0xf1, 0x5d, 0xa4, 0x20, 0x83, 0xd5, 0x5a, 0x7d, 0x56, 0x8f, 0x2b, 0x70,
+    0x4d, 0xb0, 0x5e, 0xce, 0x44, 0x64, 0xdd, 0xa0, 0xf5, 0xb3, 0x55, 0x25, 0x1e, 0x54, 0x79, 0x6d,
+    0xc5, 0xe3, 0xf8, 0x1e, 0xd4, 0xb3, 0x6e, 0x80, 0xb9, 0xe1, 0xd2, 0xd7, 0xd6, 0x4a, 0x8d, 0x70,
+    0x98, 0xd9, 0x00, 0x44, 0x00, 0x25, 0xe3, 0xd0, 0x97, 0x2e, 0xfb, 0xce, 0x75, 0xdd, 0x2d, 0xdb,
+    0xec, 0x6b, 0x75, 0xf2, 0x2c, 0x22, 0x1e, 0xcc, 0x45, 0x05, 0xfd, 0x22, 0x94, 0xb3, 0x10, 0xce,
+    0x17, 0x30, 0x2a, 0x01, 0x1a, 0x23, 0x45, 0x5a, 0x43, 0x63, 0xa2, 0xd9, 0x1a, 0x4c, 0x16, 0xc0,
+    0x6e, 0xe6, 0x36, 0x70, 0xfe, 0xfe, 0xe9, 0xc9, 0xf9, 0x41, 0xf7, 0x98, 0xed, 0x70, 0x20, 0x39,
+    0x25, 0xef, 0xc5, 0x23, 0x16, 0x84, 0x81, 0xa8, 0x96, 0xdb, 0x59, 0x47, 0x31, 0x12, 0x59, 0x85,
+    0x12, 0x02, 0x3a, 0x32, 0x86, 0x8e, 0xe5, 0xaf, 0x02, 0x08, 0x0d, 0xf3, 0x52, 0x1c, 0x2d, 0xc2,
+    0x3b, 0x0a, 0xb2, 0xa2, 0x2c, 0x07, 0xbc, 0xbb, 0xff, 0x77, 0x1d, 0x88, 0x3c, 0x72, 0x4b, 0xdb,
+    0x46, 0xb4, 0x2a, 0xc6, 0x99, 0xb8, 0x07, 0x59, 0x9c, 0x96, 0x62, 0xa4, 0x18, 0x70, 0xe8, 0x86,
+    0xc1, 0x8e, 0x78, 0x23, 0xde, 0x8b, 0x41, 0x66, 0x47, 0x15, 0xae, 0x00, 0x27, 0x65, 0x9d, 0xd2,
+    0xcd, 0x5c, 0x29, 0x44, 0x66, 0xb4, 0x6c, 0x9f, 0xcc, 0x96, 0x9c, 0xb2, 0xc1, 0x60, 0x40, 0xd4,
+    0x63, 0xc5, 0xd5, 0x3a, 0x4e, 0xce, 0xad, 0x31, 0xce, 0x7e, 0x1e, 0x72, 0x38, 0x1c, 0x12, 0xa4,
+    0xe2, 0xb3, 0x38, 0x1f, 0xd2, 0x9e, 0x2f, 0xb6, 0x95, 0xeb, 0x9b, 0x58, 0x40, 0x68, 0x00, 0xae,
+    0x72, 0xdc, 0x96, 0x5b, 0xbe, 0x11, 0x8b, 0x09, 0xe9, 0x5d, 0x8e, 0xa6, 0x7f, 0xbb, 0x64, 0x90,
+    0xbc, 0xf7, 0xbc, 0x43, 0xfc, 0x93, 0xc8, 0x62, 0x73, 0x47, 0xc9, 0x3b, 0xf1, 0xa4, 0x0f, 0x53,
+    0x1d, 0x52, 0x39, 0xcc, 0x7e, 0x49, 0xc7, 0x76, 0x2f, 0xd3, 0xb1, 0x6d, 0x92, 0x65, 0xde, 0x30,
+    0x79, 0x41, 0xb7, 0xb5, 0x2a, 0x27, 0xa3, 0x6d, 0x71, 0x8a, 0x94, 0x33, 0xc9, 0x53, 0x06, 0x26,
+    0x8b, 0x00, 0x9c, 0x0f, 0x3b, 0xed, 0x58, 0x45, 0x72, 0x95, 0x9d, 0xc7, 0x5e, 0xb7, 0xfb, 0xc3,
+    0x31, 0x5b, 0x98, 0x7c, 0xd2, 0x27, 0x5f, 0xca, 0x25, 0x9f, 0x8b, 0x76, 0x24, 0x02, 0x10, 0x89,
+    0x98, 0xaf, 0xe4, 0x83, 0xf0, 0xb9, 0x12, 0xee, 0x6e, 0x41, 0x81, 0x7c, 0x10, 0xaa, 0xb2, 0xc9,
+    0xbe, 0xf3, 0x3c, 0xcf, 0x15, 0x3f, 0x95, 0xce, 0x64, 0x6a, 0x43, 0x5f, 0x78, 0xfa, 0x88, 0x27,
+    0xa4, 0x00, 0x7a, 0xd8, 0xed, 0xee, 0x8c, 0x93, 0x51, 0xc7, 0x54, 0x8f, 0x51, 0x87, 0xca, 0xd6,
+    0x08, 0xab, 0x08, 0xbc, 0xb9, 0xf2, 0x8e, 0x39, 0x3e, 0x64, 0x33, 0x48, 0x25, 0x49, 0x11, 0xc0,
+    0x5a, 0xb3, 0xe8, 0xef, 0xa8, 0x68, 0xb0, 0xd1, 0x68, 0x8c, 0x5e, 0xb4, 0xdb, 0xec, 0x0a, 0x85,
+    0xe6, 0xb3, 0x70, 0xad, 0x98, 0x80, 0xbc, 0xe9, 0xba, 0xc2, 0x65, 0x14, 0x69, 0x1e, 0x77, 0x04,
+    0x6b, 0xb7, 0x8b, 0xd4, 0x51, 0x45, 0x5d, 0xc4, 0xa2, 0x30, 0x98, 0x4f, 0x10, 0xf9, 0x08, 0x85,
+    0xa2, 0x37, 0xf6, 0x29, 0x06, 0x15, 0x33, 0x32, 0x6f, 0x3f, 0xbe, 0xbb, 0xcc, 0x68, 0xd9, 0xec,
+    0x3c, 0x8c, 0x18, 0x67, 0xde, 0xda, 0xf7, 0xdb, 0x9e, 0x80, 0x73, 0x14, 0xe5, 0x59, 0xed, 0xb1,
+    0xf5, 0xca, 0x0f, 0xb9, 0xcb, 0x3c, 0xe9, 0x8b, 0x98, 0xa9, 0x90, 0x4d, 0xaf, 0x2f, 0xce, 0xcf,
+    0xa7, 0x36, 0xe8, 0x0a, 0x02, 0x24, 0xe2, 0x7e, 0xc4, 0x63, 0x15, 0xf0, 0x3b, 0x39, 0xe7, 0x4a,
+    0x42, 0x42, 0x2c, 0x0b, 0x88, 0xc7, 0xce, 0xda, 0x5a, 0x62, 0x3a, 0x2a, 0x2c, 0x16, 0x06, 0x8e,
+    0x2f, 0x9d, 0x2f, 0x63, 0x2b, 0x5e, 0x84, 0xf7, 0x40, 0xab, 0xf9, 0x12, 0xec, 0xe5, 0xc9, 0xf9,
+    0xcb, 0x96, 0x35, 0x39, 0xa5, 0xa7, 0x75, 0x44, 0x84, 0x0d, 0xd3, 0x12, 0x9d, 0x2a, 0x02, 0x3a,
+    0x25, 0x20, 0x81, 0x29, 0x3d, 0xd5, 0xc7, 0xc4, 0x70, 0x44, 0xbc, 0x4b, 0xf8, 0xfb, 0x19, 0x58,
+    0xe1, 0x9c, 0xb8, 0x5d, 0xc2, 0xdf, 0x09, 0x56, 0xde, 0x42, 0x05, 0x35, 0x18, 0x2a, 0xdf, 0x66,
+    0x6a, 0x21, 0x20, 0x02, 0xe7, 0x82, 0xc9, 0x98, 0xa1, 0xbc, 0xd2, 0xd9, 0x63, 0x77, 0xdc, 0x5f,
+    0x83, 0xa1, 0x79, 0x24, 0xd0, 0xe4, 0x3e, 0xf9, 0x82, 0x79, 0x51, 0xb8, 0x64, 0x9d, 0x58, 0x28,
+    0x05, 0x9e, 0x8c, 0x33, 0xeb, 0x4a, 0x97, 0x22, 0x0b, 0x08, 0x5b, 0x39, 0xf1, 0xd2, 0xe3, 0x6c,
+    0xcc, 0x0b, 0xc0, 0x58, 0xee, 0x73, 0xd0, 0xe0, 0xf2, 0xa5, 0xc5, 0xa0, 0x6f, 0x5a, 0x84, 0xb0,
+    0x76, 0xfd, 0x7e, 0xfa, 0xd1, 0x22, 0xe0, 0x30, 0x18, 0x5b, 0x1d, 0x43, 0x10, 0x05, 0xcf, 0x07,
+    0x30, 0x24, 0x70, 0x8a, 0xdd, 0xc1, 0xe4, 0x67, 0x79, 0x2e, 0xd9, 0xd4, 0x08, 0x03, 0x41, 0x3b,
+    0x28, 0x1a, 0x28, 0x6b, 0x2d, 0xac, 0xc9, 0x88, 0x7a, 0x88, 0xc9, 0x74, 0x7a, 0xf1, 0x06, 0x02,
+    0x52, 0xbf, 0x8c, 0xa8, 0xc4, 0xb2, 0x5c, 0xfd, 0x37, 0xcd, 0x5b, 0x1c, 0x4b, 0x60, 0x51, 0x61,
+    0xf2, 0x0a, 0x8a, 0xd7, 0xa6, 0x47, 0xa8, 0xa6, 0x9a, 0x76, 0x10, 0x86, 0x72, 0xf6, 0x0e, 0xb9,
+    0xc7, 0x11, 0x0b, 0x68, 0x4f, 0x44, 0x34, 0xb6, 0xd6, 0x81, 0xb3, 0xc0, 0x46, 0xa0, 0x36, 0xd7,
+    0xb3, 0x80, 0xcf, 0x7c, 0xc1, 0xd0, 0x00, 0xd5, 0x8c, 0xd3, 0x8e, 0xc1, 0x30, 0x5e, 0xc7, 0x02,
+    0x81, 0xeb, 0xd2, 0xbf, 0x0a, 0x5d, 0xc1, 0xae, 0x00, 0xf3, 0xdb, 0xc6, 0x0a, 0x00, 0x14, 0x21,
+    0x33, 0xd2, 0x49, 0xb4, 0x55, 0x3b, 0xed, 0xf2, 0xec, 0x0d, 0x2b, 0x1d, 0xa5, 0x1a, 0x8e, 0xd3,
+    0x58, 0xeb, 0x40, 0x55, 0x0b, 0x64, 0x7a, 0x3a, 0x23, 0x12, 0x04, 0x2b, 0xc1, 0xd6, 0xd5, 0x16,
+    0x89, 0x5f, 0x43, 0xef, 0x5b, 0x8f, 0x34, 0x40, 0xd6, 0x25, 0xfc, 0x9a, 0x9a, 0xb4, 0x40, 0xc4,
+    0x71, 0x35, 0x6d, 0xdd, 0xfd, 0xb1, 0xa5, 0x84, 0x70, 0xef, 0x5a, 0xd8, 0x94, 0x8f, 0xad, 0xfe,
+    0xc1, 0x41, 0xc2, 0x6c, 0x96, 0xa2, 0xd7, 0x65, 0xf8, 0x4f, 0xbe, 0x5c, 0xf2, 0xa7, 0xf5, 0x88,
+    0x95, 0x58, 0x01, 0x37, 0xbb, 0x97, 0xf0, 0xb5, 0x0f, 0x0c, 0xe7, 0x41, 0xc2, 0x77, 0x8e, 0x54,
+    0xea, 0xb2, 0x7c, 0xc7, 0x1f, 0xd8, 0xf9, 0xf5, 0xf4, 0x69, 0xa6, 0x89, 0x86, 0x9a, 0x3e, 0x70,
+    0x3b, 0x5f, 0xd5, 0xd6, 0x69, 0xba, 0x0c, 0x43, 0xb5, 0x60, 0xe7, 0xdc, 0x15, 0x71, 0xbd, 0x60,
+    0xa7, 0xa2, 0xb1, 0x0a, 0xb1, 0x22, 0x9f, 0x47, 0xb0, 0x52, 0x9b, 0xd5, 0x39, 0x8f, 0x15, 0x7b,
+    0x0d, 0xec, 0xea, 0xf1, 0xf1, 0x00, 0x1c, 0xa1, 0xeb, 0x86, 0xfe, 0x49, 0xa4, 0xae, 0x84, 0x7a,
+    0x5e, 0xc6, 0x32, 0x27, 0x5d, 0xa3, 0xd6, 0x13, 0x8b, 0x47, 0x10, 0x33, 0x4a, 0x23, 0x3e, 0x37,
+    0xa3, 0xc4, 0x27, 0xa7, 0x57, 0xac, 0x79, 0xd6, 0xb3, 0x07, 0xbd, 0x56, 0x3d, 0x6e, 0x31, 0x77,
+    0x82, 0x67, 0xf2, 0x82, 0x42, 0x18, 0x29, 0xf6, 0x29, 0x80, 0x9a, 0x10, 0xc5, 0xa2, 0xce, 0xb1,
+    0xd3, 0x2a, 0x25, 0x18, 0x75, 0xf9, 0x24, 0xf0, 0x75, 0x32, 0x07, 0x45, 0x68, 0xaf, 0x9a, 0x5f,
+    0x29, 0x99, 0x24, 0x4e, 0x36, 0x77, 0x2e, 0x4d, 0x27, 0x5e, 0xcf, 0x96, 0x12, 0x80, 0xa6, 0xfc,
+    0x4e, 0x94, 0xf3, 0x9b, 0x06, 0x44, 0x4c, 0x14, 0xb2, 0x54, 0x8f, 0x75, 0x57, 0xa0, 0x0b, 0x71,
+    0xbe, 0x9c, 0xea, 0xbe, 0xa1, 0xaa, 0x9c, 0x96, 0xfa, 0x97, 0x5c, 0x80, 0x4d, 0x1f, 0xe1, 0x74,
+    0x2f, 0x59, 0xd2, 0x68, 0xa4, 0xe1, 0x45, 0xf4, 0x68, 0x4f, 0x6f, 0x61, 0x77, 0xc0, 0xb1, 0xdf,
+    0xb4, 0x6d, 0xbb, 0xa8, 0xd5, 0x0e, 0xc2, 0x10, 0x7b, 0x50, 0xb6, 0xbe, 0x54, 0x53, 0x0e, 0xf4,
+    0xe6, 0xef, 0x24, 0x9d, 0x1c, 0x8a, 0x2a, 0xca, 0xda, 0x0d, 0xdf, 0x24, 0x6c, 0x1c, 0x91, 0xf6,
+    0x42, 0x91, 0xf0, 0x22, 0x11, 0x2f, 0x34, 0x5e, 0x13, 0x7a, 0xa1, 0x0f, 0x7a, 0x21, 0x65, 0x92,
+    0x39, 0x24, 0xe7, 0x08, 0x6c, 0xb3, 0x4c, 0x3f, 0x34, 0x93, 0x01, 0x8f, 0x1e, 0xd9, 0xcf, 0x62,
+    0x36, 0x85, 0xbb, 0x81, 0x50, 0x7b, 0x2c, 0x16, 0x82, 0x00, 0xfe, 0x2d, 0xc5, 0xbd, 0xbd, 0x80,
+    0xeb, 0x5d, 0x44, 0x4d, 0x13, 0xe4, 0x96, 0x18, 0xfb, 0x26, 0xb8, 0x48, 0x60, 0x87, 0x5c, 0x70,
+    0xa0, 0x4f, 0x1d, 0xe5, 0x73, 0xdc, 0x47, 0x12, 0x20, 0x07, 0x63, 0x06, 0x87, 0x07, 0x77, 0x3c,
+    0x4e, 0x89, 0x4d, 0xf1, 0x66, 0x92, 0x52, 0xcc, 0x2e, 0x2b, 0x96, 0xbe, 0xab, 0x40, 0xf8, 0xf6,
+    0x0f, 0x2d, 0x73, 0x55, 0xc1, 0x58, 0x86, 0x80, 0xd5, 0x14, 0x4a, 0x42, 0xa1, 0x15, 0xb2, 0xc0,
+    0x32, 0x71, 0x86, 0xed, 0x6d, 0x20, 0x1c, 0xf5, 0x0c, 0xcf, 0x99, 0x0b, 0x43, 0xad, 0x34, 0xf6,
+    0x0e, 0xba, 0x84, 0xec, 0x00, 0xc6, 0xc2, 0x07, 0x56, 0xa9, 0x40, 0xb8, 0x49, 0xad, 0x2c, 0x35,
+    0x41, 0x20, 0x12, 0xdc, 0xac, 0x0c, 0xf1, 0x66, 0xf7, 0xa1, 0xd7, 0xdf, 0x63, 0x9f, 0xaf, 0xe8,
+    0x98, 0x36, 0xd5, 0x42, 0xc6, 0x36, 0x75, 0xa6, 0xad, 0x9b, 0x16, 0x8a, 0x11, 0xae, 0xa8, 0x8d,
+    0xa5, 0x25, 0xac, 0x30, 0x93, 0xf7, 0x9e, 0x37, 0xea, 0xe8, 0xd5, 0x49, 0x69, 0x17, 0x2c, 0xa2,
+    0x83, 0x6d, 0x17, 0x40, 0x5f, 0xf7, 0xe8, 0xd2, 0x81, 0x03, 0x0c, 0xb7, 0xf5, 0x0c, 0xac, 0xa3,
+    0x05, 0xfe, 0xab, 0xab, 0x7e, 0x62, 0x8f, 0x8c, 0x00, 0x5a, 0x85, 0x50, 0xb7, 0x8c, 0xd2, 0xdd,
+    0x69, 0x94, 0x7a, 0x42, 0x92, 0x86, 0x3b, 0x32, 0x3c, 0x6e, 0x65, 0xd2, 0x9c, 0xea, 0x57, 0x63,
+    0x23, 0xbc, 0xb1, 0xc2, 0x3f, 0x5b, 0x82, 0x01, 0x4c, 0x5e, 0x90, 0x72, 0xb6, 0x2c, 0x9e, 0x34,
+    0xb8, 0x9a, 0x6c, 0x27, 0x3c, 0xbc, 0xb8, 0xfc, 0xae, 0x74, 0xa7, 0x6f, 0x3a, 0x85, 0xc4, 0x01,
+    0xb4, 0xce, 0xc0, 0x54, 0x52, 0x64, 0x69, 0x83, 0x21, 0xfd, 0xda, 0xb9, 0x03, 0x69, 0xe6, 0x33,
+    0x87, 0xe6, 0xb1, 0x95, 0x37, 0x62, 0x07, 0xce, 0x9f, 0x9a, 0x34, 0x3a, 0x1d, 0xbc, 0x79, 0xb2,
+    0xf8, 0x5e, 0x2a, 0x67, 0x81, 0xcc, 0x3c, 0x68, 0xe9, 0x31, 0x76, 0x1a, 0xc9, 0x03, 0x4b, 0x2e,
+    0x68, 0xa0, 0x19, 0xb6, 0xcb, 0x2d, 0xf6, 0xb5, 0xc1, 0x98, 0x1b, 0x3a, 0xeb, 0x25, 0x8e, 0x25,
+    0xfe, 0xb7, 0x16, 0xd1, 0xe3, 0x94, 0xa2, 0x2c, 0x8c, 0x4e, 0x7c, 0xbf, 0x69, 0xe5, 0xa7, 0x16,
+    0x56, 0x0b, 0xe7, 0xa4, 0x67, 0xdc, 0x59, 0x20, 0x3a, 0x1b, 0x4f, 0xd0, 0x7a, 0x36, 0x19, 0xe4,
+    0x52, 0xc6, 0xca, 0x8e, 0xc4, 0x32, 0xbc, 0x13, 0x4d, 0xcb, 0xdc, 0xb3, 0x5a, 0xad, 0xe3, 0x6f,
+    0xd3, 0xfe, 0x63, 0x34, 0xe7, 0xd0, 0x60, 0xf8, 0x02, 0x1f, 0x5f, 0x3f, 0x5e, 0xb8, 0xa9, 0x52,
+    0x39, 0x7c, 0xee, 0xba, 0x19, 0xf2, 0x6e, 0x79, 0xb4, 0x30, 0x9f, 0x13, 0xfb, 0xbf, 0x4c, 0xcc,
+    0xf4, 0x8b, 0x65, 0xb1, 0x57, 0xcc, 0xd0, 0x85, 0x27, 0xeb, 0x17, 0xab, 0xf5, 0xf2, 0xc6, 0x7a,
+    0x92, 0x83, 0xf4, 0x58, 0x22, 0x09, 0x1b, 0x8f, 0xc7, 0x2c, 0xc9, 0x6d, 0x2d, 0x56, 0xaa, 0x08,
+    0x95, 0xc0, 0x14, 0x7f, 0x29, 0xa8, 0x0e, 0x80, 0x6a, 0x40, 0x62, 0xc8, 0xc2, 0x95, 0x08, 0x92,
+    0x92, 0x00, 0x90, 0x4c, 0xf8, 0xd0, 0x69, 0x38, 0x7e, 0x18, 0x8b, 0xdc, 0x6a, 0x63, 0xd3, 0xc0,
+    0xe0, 0xa0, 0xcc, 0x8e, 0xdf, 0x04, 0xa0, 0xb8, 0x84, 0x81, 0xff, 0x88, 0x5f, 0x05, 0x30, 0xdb,
+    0x0a, 0x9a, 0x8a, 0x41, 0xdf, 0x85, 0xc5, 0x04, 0xdd, 0x00, 0x17, 0x70, 0xa4, 0x0b, 0x05, 0x27,
+    0x84, 0x40, 0xf6, 0xf5, 0xb5, 0x3c, 0x06, 0x70, 0x68, 0x4c, 0x03, 0x68, 0x83, 0x21, 0xb6, 0x1a,
+    0x3e, 0x94, 0x4b, 0xca, 0xe3, 0x54, 0x9b, 0xd8, 0x98, 0x05, 0x6b, 0xdf, 0x3f, 0xce, 0x22, 0xad,
+    0x28, 0x18, 0xc5, 0x19, 0xea, 0x90, 0xa1, 0xa0, 0x92, 0x6a, 0x1d, 0x05, 0xa8, 0x5d, 0x91, 0x10,
+    0x08, 0x98, 0x16, 0xbd, 0xe6, 0xed, 0x7d, 0x7c, 0xd4, 0xe9, 0x7c, 0xff, 0xd5, 0x0f, 0x1d, 0x6a,
+    0x64, 0xec, 0x05, 0x48, 0xb1, 0xe9, 0xdc, 0xc7, 0xb7, 0xad, 0x22, 0xa6, 0xad, 0xeb, 0xe5, 0x47,
+    0xc8, 0x1e, 0x40, 0x04, 0xaa, 0x76, 0xc4, 0x1f, 0x67, 0x6b, 0xcf, 0x83, 0xbe, 0xaa, 0x04, 0x18,
+    0x06, 0x49, 0xc5, 0x1c, 0x33, 0x71, 0x87, 0xa3, 0x01, 0x88, 0x3b, 0x37, 0xe2, 0xf7, 0x28, 0x2f,
+    0xf5, 0xea, 0x4d, 0x94, 0xe1, 0x0d, 0x57, 0x9c, 0xa4, 0x27, 0x18, 0xdb, 0x85, 0xd7, 0x56, 0x6b,
+    0x8b, 0x14, 0xd9, 0x1a, 0x08, 0x81, 0x8e, 0x40, 0x05, 0xd5, 0x64, 0x55, 0x76, 0xc1, 0xe5, 0x5d,
+    0x71, 0x9b, 0xab, 0x87, 0x2d, 0x1b, 0x6f, 0xb5, 0xa7, 0x66, 0x62, 0x01, 0x6a, 0xbc, 0x91, 0x71,
+    0xea, 0x25, 0xd2, 0x63, 0x43, 0xde, 0x4c, 0xcd, 0x5c, 0x72, 0x75, 0xa5, 0x9d, 0x73, 0xf2, 0x12,
+    0xb8, 0x89, 0x88, 0x94, 0x46, 0x51, 0x75, 0x0c, 0x90, 0x8c, 0x0e, 0xbe, 0xd9, 0xb3, 0x47, 0x25,
+    0x2e, 0x45, 0x30, 0x87, 0x0b, 0xd0, 0x88, 0x0d, 0x86, 0xec, 0xb7, 0xdf, 0x28, 0x8c, 0x50, 0x8f,
+    0x4f, 0x70, 0xcd, 0x39, 0x6c, 0x76, 0x5b, 0xec, 0x05, 0x04, 0x65, 0xf7, 0xa1, 0xdb, 0xcb, 0xbb,
+    0x15, 0x24, 0x87, 0x88, 0x59, 0xe2, 0x35, 0x7e, 0x5c, 0xc2, 0x18, 0xb4, 0x32, 0x80, 0xec, 0x86,
+    0xb9, 0x05, 0xb6, 0x9f, 0x03, 0xf3, 0x56, 0xe5, 0xfd, 0xde, 0xb0, 0x39, 0xdc, 0x63, 0x2a, 0x82,
+    0x54, 0xcf, 0x3a, 0xac, 0xd7, 0xcd, 0x60, 0x55, 0xa8, 0xb8, 0xbf, 0x0d, 0x7d, 0x68, 0xa0, 0x33,
+    0x40, 0x07, 0xbb, 0xea, 0x6d, 0x40, 0x2c, 0xf7, 0x25, 0xc8, 0x15, 0x47, 0x0b, 0x96, 0x45, 0x18,
+    0xf4, 0x9b, 0xbd, 0xe1, 0x16, 0xac, 0x1b, 0x85, 0xab, 0x15, 0x1c, 0xab, 0x2d, 0xd8, 0xfe, 0xfe,
+    0x16, 0xec, 0x42, 0xf0, 0x55, 0x05, 0x60, 0x26, 0xaa, 0xf1, 0x84, 0x96, 0x74, 0xc2, 0xba, 0x2d,
+    0x13, 0x65, 0x46, 0x01, 0xdd, 0x9e, 0x8d, 0xbf, 0x15, 0x5d, 0xd8, 0xa2, 0xb5, 0x74, 0x1c, 0x6a,
+    0x14, 0x9b, 0xfa, 0x35, 0x40, 0x24, 0xc2, 0xc7, 0x79, 0x92, 0xea, 0x01, 0x97, 0x35, 0x14, 0x50,
+    0xa3, 0x70, 0x7c, 0x50, 0x4d, 0xab, 0xef, 0xa6, 0x24, 0x08, 0x90, 0x46, 0xd0, 0x08, 0xaa, 0x1e,
+    0x6c, 0x27, 0x12, 0x70, 0xd3, 0xbd, 0xc0, 0x15, 0x3c, 0x38, 0x5a, 0xdc, 0x3d, 0xd6, 0x33, 0x08,
+    0xd8, 0xab, 0x36, 0x31, 0x67, 0x48, 0x80, 0xef, 0x1e, 0xc3, 0x5f, 0x23, 0xc3, 0x98, 0xc9, 0x57,
+    0xaf, 0x12, 0x95, 0x98, 0x26, 0x49, 0x67, 0xed, 0xb3, 0x64, 0x7f, 0x63, 0xfb, 0x37, 0xdb, 0x91,
+    0x33, 0x84, 0x44, 0x8c, 0x7b, 0x03, 0x43, 0x7a, 0x1b, 0x09, 0x00, 0x7a, 0x15, 0x88, 0x3f, 0xd5,
+    0x41, 0xec, 0x57, 0x20, 0x1e, 0xd6, 0x41, 0x1c, 0x20, 0x22, 0x74, 0x50, 0x1a, 0x64, 0xa3, 0xcd,
+    0x04, 0x86, 0x81, 0xf6, 0x24, 0xb3, 0x0a, 0xe1, 0xed, 0x31, 0xe8, 0x9b, 0xba, 0x44, 0x6b, 0xd3,
+    0x68, 0xfc, 0x9e, 0xbc, 0x40, 0xc4, 0x6f, 0xbf, 0xff, 0x0a, 0x47, 0xc2, 0x56, 0xe1, 0xb9, 0x7c,
+    0x10, 0x6e, 0xb3, 0xd7, 0xda, 0xe0, 0x11, 0xd9, 0x63, 0xdf, 0x7f, 0xa5, 0xe8, 0xdf, 0xe8, 0x0f,
+    0x02, 0xb4, 0x60, 0x62, 0x77, 0x93, 0x04, 0x31, 0xae, 0x99, 0x18, 0xdd, 0x24, 0xc1, 0x8a, 0x6b,
+    0xd8, 0xa2, 0x71, 0x60, 0xae, 0x44, 0xdc, 0xc4, 0xb8, 0x44, 0x92, 0x91, 0x10, 0xb7, 0x49, 0x05,
+    0x4a, 0x25, 0xd5, 0x05, 0xcf, 0x08, 0x6b, 0x4b, 0x97, 0x8e, 0x7f, 0xd6, 0x46, 0xb7, 0x9e, 0xd6,
+    0x49, 0xc3, 0xe8, 0x26, 0x0d, 0x8c, 0x86, 0x09, 0xe2, 0x19, 0x1c, 0x72, 0x8d, 0xe9, 0x37, 0xf8,
+    0xe4, 0x21, 0x53, 0x6e, 0x59, 0xb6, 0x29, 0x66, 0xc1, 0x7c, 0x6b, 0xeb, 0x84, 0xcb, 0x25, 0x0f,
+    0xdc, 0x64, 0xfe, 0x5c, 0x95, 0x56, 0xd9, 0x8f, 0x3f, 0xe6, 0x13, 0x2b, 0x44, 0xbf, 0xfb, 0x88,
+    0xbe, 0xd2, 0xe5, 0x39, 0xad, 0x5f, 0xf6, 0xfb, 0xeb, 0xb3, 0xab, 0xd6, 0x56, 0x5d, 0xb0, 0x91,
+    0x1b, 0x55, 0x19, 0x0a, 0xb1, 0x13, 0x2c, 0x56, 0xcd, 0xcf, 0x29, 0x5b, 0xe8, 0x10, 0x35, 0xe7,
+    0x9b, 0x96, 0x09, 0x93, 0x6d, 0x49, 0xb1, 0xd7, 0x5d, 0x88, 0x07, 0x4d, 0x5b, 0x9f, 0xc7, 0x44,
+    0xc5, 0x15, 0x8f, 0x62, 0x71, 0x11, 0x28, 0xdc, 0xb7, 0x63, 0x68, 0x69, 0x04, 0x44, 0x07, 0x9c,
+    0xc5, 0x21, 0x11, 0x2b, 0xf5, 0xf0, 0x3d, 0xe8, 0xe1, 0x9b, 0x1a, 0x73, 0x32, 0x41, 0x18, 0xf6,
+    0x23, 0x24, 0x72, 0xcf, 0xdb, 0x63, 0xd9, 0xea, 0x61, 0xb6, 0xa8, 0xd7, 0xf4, 0xdb, 0x4d, 0xda,
+    0x5a, 0x9c, 0x4b, 0xdf, 0xa7, 0xf6, 0xc1, 0x29, 0x0c, 0xf6, 0x69, 0xd0, 0x4e, 0xe3, 0x7a, 0xda,
+    0x5b, 0x47, 0x11, 0x86, 0x6f, 0x32, 0xb9, 0xcf, 0x34, 0xc2, 0x6f, 0x2a, 0xc9, 0x40, 0xca, 0x14,
+    0x31, 0x4f, 0x40, 0x13, 0xdb, 0xb4, 0xd2, 0x31, 0xbf, 0xd5, 0x22, 0x13, 0xda, 0x40, 0x28, 0x68,
+    0x42, 0x6f, 0xb4, 0x02, 0x8d, 0x05, 0x96, 0xdc, 0xe4, 0xd9, 0xfe, 0x6f, 0x1c, 0x06, 0xcd, 0x56,
+    0x1e, 0x0c, 0xcf, 0x67, 0x56, 0x95, 0xd3, 0x3a, 0x82, 0x42, 0x3d, 0x91, 0x2f, 0x73, 0x1f, 0x05,
+    0xd2, 0xf3, 0xfe, 0x59, 0x8f, 0xe3, 0xf7, 0x58, 0x36, 0x69, 0x86, 0xe7, 0x74, 0xc4, 0xab, 0x9f,
+    0x71, 0x26, 0x0b, 0x4f, 0xb9, 0x81, 0x29, 0xbc, 0x99, 0x31, 0xe3, 0x9e, 0x21, 0xc4, 0xca, 0x53,
+    0xa4, 0x3d, 0x56, 0x39, 0xe7, 0xb9, 0x49, 0xfb, 0xe2, 0x80, 0x5a, 0xbe, 0x09, 0x89, 0x6d, 0x0b,
+    0x2d, 0x68, 0xfc, 0x19, 0x57, 0x6f, 0xd2, 0x98, 0xa6, 0x44, 0x44, 0x4b, 0xa9, 0xc4, 0x05, 0x70,
+    0x9b, 0x86, 0xa9, 0x29, 0xb8, 0xb9, 0xb2, 0x21, 0x96, 0xde, 0x69, 0xe5, 0xb2, 0x48, 0x35, 0x01,
+    0x33, 0xba, 0xb7, 0x69, 0xf0, 0x46, 0x95, 0x8d, 0xb0, 0xcd, 0x72, 0x35, 0x4e, 0x61, 0x04, 0x58,
+    0xc6, 0x2c, 0x6c, 0x56, 0xe3, 0xe7, 0x86, 0x7a, 0x65, 0xec, 0xdc, 0x56, 0x35, 0xee, 0xd6, 0xf4,
+    0xb5, 0x4c, 0x61, 0x0b, 0xa0, 0x9a, 0x4e, 0x32, 0x5d, 0x2d, 0xa3, 0x27, 0xeb, 0xd5, 0x58, 0xda,
+    0xe9, 0xf8, 0x57, 0x02, 0xaf, 0x57, 0x2e, 0xe5, 0x52, 0xaa, 0xa7, 0x8c, 0x55, 0x08, 0x82, 0x12,
+    0x7e, 0xb2, 0x67, 0x24, 0xdd, 0x98, 0x48, 0x87, 0xb6, 0x18, 0xa2, 0x44, 0x44, 0x11, 0x54, 0x58,
+    0x08, 0x13, 0x8c, 0xf1, 0xd0, 0x17, 0x36, 0x2d, 0x34, 0xad, 0x33, 0x5a, 0xa7, 0xc3, 0x84, 0x37,
+    0xc2, 0xe4, 0x34, 0x1d, 0x41, 0xdc, 0x11, 0x44, 0x2b, 0x3d, 0xc2, 0x66, 0x04, 0x68, 0x6e, 0x1e,
+    0x15, 0x77, 0xc7, 0xd2, 0xf5, 0xe5, 0x2f, 0x3b, 0xa5, 0xd8, 0x25, 0xe8, 0x39, 0xe1, 0x5b, 0xb5,
+    0xc4, 0x26, 0xee, 0x36, 0x39, 0x3b, 0x2c, 0x7f, 0x05, 0x4f, 0x46, 0x46, 0x9f, 0x56, 0x4a, 0x2e,
+    0xc5, 0x51, 0x5a, 0xbd, 0xf4, 0xbb, 0x0e, 0xee, 0x35, 0x3d, 0xb7, 0x36, 0xe6, 0xaa, 0xfc, 0x14,
+    0x99, 0x73, 0xa8, 0x73, 0xec, 0x1d, 0x5c, 0x37, 0xa3, 0xc7, 0xa3, 0x52, 0x25, 0xd4, 0x0e, 0x87,
+    0xfd, 0xb7, 0x54, 0x12, 0x0b, 0xc4, 0x6e, 0x13, 0x6f, 0xee, 0x4c, 0x27, 0x85, 0x91, 0x67, 0x0b,
+    0xe2, 0x2e, 0x10, 0x11, 0x7d, 0x74, 0x1e, 0xe7, 0xb4, 0x3c, 0xce, 0xe9, 0x6e, 0x26, 0x99, 0xb5,
+    0x94, 0xd7, 0x1f, 0x1f, 0xe9, 0x05, 0xa5, 0x26, 0x49, 0xef, 0xa5, 0x27, 0x4f, 0xd3, 0x9b, 0xdd,
+    0x3f, 0x98, 0x95, 0xbe, 0x58, 0xec, 0xa8, 0x74, 0xa3, 0xa8, 0x63, 0x99, 0x8b, 0x6b, 0x76, 0xe2,
+    0xba, 0x11, 0x4e, 0x92, 0x12, 0x16, 0x72, 0x65, 0x56, 0xea, 0xe0, 0x7f, 0x98, 0x4e, 0x2f, 0x76,
+    0x0a, 0x47, 0x8b, 0x11, 0x24, 0x57, 0xbc, 0x5d, 0x33, 0xf7, 0xf5, 0x92, 0x64, 0xbc, 0xea, 0x9c,
+    0x58, 0xcf, 0xb5, 0x73, 0x71, 0x00, 0x5c, 0x34, 0x74, 0xce, 0xa4, 0x79, 0x4b, 0xeb, 0x33, 0x57,
+    0xcb, 0xd0, 0x85, 0x01, 0x71, 0xaa, 0x8d, 0x26, 0xf0, 0x61, 0x1d, 0x04, 0x78, 0xb8, 0xc0, 0xd4,
+    0xe6, 0x91, 0x94, 0x98, 0x2a, 0xea, 0xab, 0x6a, 0xd9, 0x38, 0x3d, 0xdb, 0x25, 0xd2, 0xc9, 0xfa,
+    0x06, 0xae, 0xec, 0x95, 0x1b, 0x60, 0xb6, 0x8a, 0x55, 0x4a, 0x1f, 0x80, 0xd2, 0xab, 0xc3, 0xfb,
+    0xda, 0x5c, 0x6c, 0x3e, 0x08, 0x47, 0x00, 0xba, 0x5b, 0x12, 0x41, 0x6f, 0x13, 0xc5, 0x3a, 0xd4,
+    0x2e, 0xf1, 0xeb, 0x95, 0xc6, 0xc9, 0xce, 0x11, 0x2e, 0xea, 0x35, 0x7d, 0x98, 0x00, 0x45, 0x9d,
+    0xe4, 0xa8, 0x3f, 0xfb, 0x50, 0x15, 0x66, 0xf2, 0x45, 0x5f, 0x67, 0x4e, 0x7d, 0x32, 0x4f, 0xe6,
+    0x7b, 0x82, 0x27, 0xf2, 0xa5, 0xf6, 0x77, 0x9a, 0x2d, 0xff, 0xc8, 0x69, 0xb7, 0x72, 0xe6, 0x4a,
+    0x7e, 0x90, 0x31, 0xd1, 0xfc, 0x7c, 0x33, 0x1d, 0x8c, 0x73, 0x3f, 0xce, 0xb0, 0x12, 0xf1, 0xd3,
+    0xf1, 0x0d, 0x0e, 0x2c, 0xbf, 0x99, 0x9e, 0xf5, 0xc8, 0xa8, 0x90, 0x9c, 0xf5, 0x4c, 0xe9, 0xcf,
+    0x49, 0xcc, 0x48, 0xcb, 0x1c, 0x18, 0xad, 0x0f, 0xfd, 0xd6, 0x67, 0xfc, 0x32, 0xf9, 0x6d, 0xd2,
+    0x40, 0xff, 0x72, 0x10, 0x7f, 0x7b, 0xe7, 0xf9, 0xe1, 0x7d, 0x1b, 0x92, 0x29, 0xfd, 0x92, 0xf3,
+    0x65, 0xa2, 0x8f, 0x69, 0xf3, 0x29, 0x0a, 0x50, 0x21, 0x68, 0xa3, 0xd3, 0x17, 0xdb, 0xd7, 0x43,
+    0x86, 0xdc, 0x25, 0x97, 0x8c, 0x9d, 0xee, 0x27, 0x3d, 0x11, 0xbc, 0xe4, 0x05, 0x23, 0xe1, 0x12,
+    0xc1, 0x5e, 0xc1, 0x51, 0xae, 0xb2, 0x34, 0x8e, 0x90, 0xe6, 0x26, 0xce, 0xd2, 0x00, 0xd3, 0xf6,
+    0x35, 0x4f, 0x7a, 0x78, 0x96, 0x11, 0xcd, 0x93, 0xac, 0x74, 0xde, 0x55, 0x48, 0x30, 0x8c, 0xdf,
+    0x71, 0xe9, 0x63, 0x33, 0x52, 0xf0, 0x5c, 0x72, 0x09, 0x2c, 0x13, 0x2a, 0xc2, 0xec, 0xbe, 0xc0,
+    0x64, 0xd3, 0xe3, 0x62, 0x1c, 0x25, 0xd4, 0xfe, 0x84, 0xf0, 0x46, 0x52, 0xcf, 0x08, 0xee, 0x9d,
+    0x22, 0xd5, 0x08, 0x6d, 0x3f, 0xfd, 0x25, 0xd0, 0x56, 0x60, 0xbf, 0x15, 0xfe, 0x4a, 0x44, 0x69,
+    0x48, 0xe7, 0xee, 0x05, 0x85, 0x8a, 0x1e, 0x0b, 0x50, 0xc6, 0x8d, 0xf3, 0x17, 0x9e, 0x45, 0xb8,
+    0x8e, 0x70, 0xf6, 0xf1, 0x8e, 0xab, 0x85, 0x0d, 0xf1, 0x06, 0x2a, 0x1a, 0x28, 0xd6, 0x61, 0x83,
+    0x61, 0xb7, 0x9b, 0x9b, 0xb3, 0x2c, 0x65, 0xb0, 0x86, 0x6a, 0x5e, 0x84, 0x4e, 0xc1, 0x7f, 0xd0,
+    0xe0, 0x80, 0x36, 0xcc, 0x23, 0xc1, 0x36, 0x62, 0x64, 0x50, 0x43, 0x1a, 0x32, 0xe9, 0x11, 0x17,
+    0xde, 0xc0, 0x49, 0x82, 0xcd, 0x02, 0x32, 0x9d, 0xa1, 0xbf, 0x59, 0xc2, 0x33, 0xa2, 0x6d, 0xe2,
+    0xdb, 0xe2, 0x05, 0x33, 0xdf, 0x52, 0xe0, 0x44, 0x2d, 0x77, 0xad, 0xa4, 0x57, 0x36, 0x62, 0xbd,
+    0x6e, 0x7f, 0x3f, 0x19, 0xa0, 0x31, 0xbd, 0x88, 0x65, 0x91, 0x9e, 0xc8, 0x6c, 0x14, 0xa1, 0x45,
+    0x8c, 0xfd, 0xc3, 0x83, 0x9f, 0x86, 0x29, 0x92, 0xd9, 0xe8, 0x68, 0x52, 0x69, 0x5b, 0xdf, 0x6f,
+    0x11, 0xa1, 0x7f, 0xbd, 0xce, 0xa8, 0x6c, 0x23, 0x68, 0x4a, 0x65, 0x9c, 0x77, 0x88, 0xb3, 0xad,
+    0x47, 0x2e, 0xa5, 0xa3, 0x77, 0xc0, 0xe9, 0xcb, 0x55, 0xa6, 0xd0, 0x8b, 0xdc, 0x9a, 0x61, 0x64,
+    0x5d, 0x89, 0x3b, 0x33, 0x8b, 0xd5, 0xb6, 0x0d, 0xc2, 0x7b, 0x33, 0xed, 0x7d, 0x03, 0x4d, 0x78,
+    0xb3, 0x85, 0xe1, 0xf6, 0x11, 0x1d, 0x9d, 0x1f, 0xa4, 0x49, 0xcf, 0x2b, 0x79, 0x0c, 0xd1, 0xda,
+    0x2c, 0x47, 0x1f, 0x45, 0x37, 0x9e, 0xa6, 0xd4, 0x82, 0x28, 0x23, 0x74, 0x63, 0xce, 0x4d, 0xb8,
+    0xb8, 0x49, 0xdd, 0xc8, 0xe7, 0xe1, 0x6d, 0xc1, 0x9a, 0x06, 0x47, 0x87, 0x40, 0x86, 0x95, 0x63,
+    0x8b, 0x10, 0x1d, 0xa0, 0xb9, 0x49, 0xe3, 0xa8, 0x40, 0x64, 0x37, 0x0e, 0xd1, 0xdc, 0x98, 0x48,
+    0xd5, 0x38, 0x3a, 0xea, 0x2f, 0xf4, 0xaf, 0xee, 0xe5, 0xaf, 0x7a, 0xbc, 0xde, 0xc8, 0x26, 0x1f,
+    0xae, 0x7b, 0x86, 0x13, 0x67, 0xfc, 0xbc, 0x20, 0xe0, 0x8c, 0x35, 0xad, 0x37, 0xef, 0xdf, 0x99,
+    0xd1, 0x0f, 0x7e, 0x46, 0x12, 0x78, 0x0f, 0x4d, 0xbc, 0x61, 0x52, 0x7d, 0xf2, 0xc1, 0x22, 0xf9,
+    0xfd, 0x9b, 0x9e, 0x53, 0x17, 0x6e, 0xd5, 0xc0, 0x17, 0xfe, 0x1d, 0x75, 0x92, 0xaf, 0x45, 0xe9,
+    0x27, 0x28, 0xfa, 0x79, 0xe6, 0xa8, 0x43, 0xff, 0xa3, 0x41, 0xe3, 0xff, 0x98, 0x40, 0x2f, 0x44,
+    0x7f, 0x30, 0x00, 0x00,
+};
+
+#endif // EMBEDDED_WEB_UI_H
@@ -0,0 +1,199 @@
+#include "HeapMonitor.h"
+#include "esp_heap_caps.h"
+
+struct HeapTaskPath
+{
+  TaskHandle_t task;
+  volatile uint8_t path;
+};
+
+// A task keeps its slot while it changes paths; slots off any path are reused
+static HeapTaskPath taskPaths[HEAP_MONITOR_MAX_TASKS];
+static volatile uint8_t taskPathCount = 0;
+static portMUX_TYPE taskPathMux = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool steadyState = false;
+static volatile uint32_t allocCount = 0;
+static volatile uint32_t freeCount = 0;
+static volatile uint32_t steadyAllocCount = 0;
+static volatile uint32_t pathAllocCount[HEAP_PATH_COUNT];
+static volatile uint32_t lastPathAllocSize = 0;
+static volatile uint8_t lastPath = HEAP_PATH_NONE;
+static uint32_t steadyBlocks = 0;
+
+static const char *pathNames[HEAP_PATH_COUNT] = {"none", "packet", "render", "uart", "status"};
+
+#if HEAP_MONITOR_HOOKS
+
+// Called by the heap after every allocation, from any task and with the cache
+// possibly disabled - counters only, no locks, no logging
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void *ptr, size_t size, uint32_t caps)
+{
+  __atomic_add_fetch(&allocCount, 1, __ATOMIC_RELAXED);
+  if (!steadyState)
+  {
+    return;
+  }
+  __atomic_add_fetch(&steadyAllocCount, 1, __ATOMIC_RELAXED);
+
+  if (xPortInIsrContext())
+  {
+    return;
+  }
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  uint8_t count = taskPathCount;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    if (taskPaths[i].task == current)
+    {
+      uint8_t path = taskPaths[i].path;
+      if (path != HEAP_PATH_NONE)
+      {
+        __atomic_add_fetch(&pathAllocCount[path], 1, __ATOMIC_RELAXED);
+        lastPathAllocSize = size;
+        lastPath = path;
+      }
+      return;
+    }
+  }
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void *ptr)
+{
+  __atomic_add_fetch(&freeCount, 1, __ATOMIC_RELAXED);
+}
+
+#endif
+
+void heapMonitorSetPath(HeapPath path)
+{
+#if HEAP_MONITOR_HOOKS
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  HeapTaskPath *free = NULL;
+
+  // Setters are serialized; the hook reads without the lock and at worst sees
+  // a taken-over slot with no path yet
+  portENTER_CRITICAL(&taskPathMux);
+  for (uint8_t i = 0; i < taskPathCount; i++)
+  {
+    if (taskPaths[i].task == current)
+    {
+      taskPaths[i].path = path;
+      portEXIT_CRITICAL(&taskPathMux);
+      return;
+    }
+    if (free == NULL && taskPaths[i].path == HEAP_PATH_NONE)
+    {
+      free = &taskPaths[i];
+    }
+  }
+
+  // First path of this task - a slot off any path is taken over (its owner gets
+  // a new one when it sets a path again), otherwise one is added once complete
+  if (path != HEAP_PATH_NONE)
+  {
+    if (free != NULL)
+    {
+      free->task = current;
+      free->path = path;
+    }
+    else if (taskPathCount < HEAP_MONITOR_MAX_TASKS)
+    {
+      taskPaths[taskPathCount].task = current;
+      taskPaths[taskPathCount].path = path;
+      taskPathCount++;
+    }
+  }
+  portEXIT_CRITICAL(&taskPathMux);
+#endif
+}
+
+void heapMonitorForgetTask(TaskHandle_t task)
+{
+  portENTER_CRITICAL(&taskPathMux);
+  for (uint8_t i = 0; i < taskPathCount; i++)
+  {
+    if (taskPaths[i].task == task)
+    {
+      taskPaths[i].path = HEAP_PATH_NONE;
+    }
+  }
+  portEXIT_CRITICAL(&taskPathMux);
+}
+
+void heapMonitorSteadyState()
+{
+  if (steadyState)
+  {
+    return;
+  }
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  steadyBlocks = info.allocated_blocks;
+  steadyState = true;
+}
+
+void heapMonitorGetStats(HeapMonitorStats *stats)
+{
+  stats->hooks = HEAP_MONITOR_HOOKS;
+  stats->steady = steadyState;
+  stats->allocs = allocCount;
+  stats->frees = freeCount;
+  stats->steadyAllocs = steadyAllocCount;
+  for (int i = 0; i < HEAP_PATH_COUNT; i++)
+  {
+    stats->pathAllocs[i] = pathAllocCount[i];
+  }
+  stats->lastPathAllocSize = lastPathAllocSize;
+  stats->lastPath = lastPath;
+
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  stats->freeBytes = info.total_free_bytes;
+  stats->minFreeBytes = info.minimum_free_bytes;
+  stats->largestFreeBlock = info.largest_free_block;
+  stats->allocatedBlocks = info.allocated_blocks;
+  stats->blocksSinceSteady = steadyState ? (int32_t)(info.allocated_blocks - steadyBlocks) : 0;
+}
+
+uint32_t heapMonitorPathAllocs()
+{
+  uint32_t total = 0;
+  for (int i = HEAP_PATH_NONE + 1; i < HEAP_PATH_COUNT; i++)
+  {
+    total += pathAllocCount[i];
+  }
+  return total;
+}
+
+const char *heapPathName(uint8_t path)
+{
+  return path < HEAP_PATH_COUNT ? pathNames[path] : "?";
+}
+
+String heapMonitorJson()
+{
+  HeapMonitorStats copy;
+  heapMonitorGetStats(&copy);
+
+  String json = "{\"hooks\":" + String(copy.hooks ? "true" : "false");
+  json += ",\"steady\":" + String(copy.steady ? "true" : "false");
+  json += ",\"allocs\":" + String(copy.allocs);
+  json += ",\"frees\":" + String(copy.frees);
+  json += ",\"steadyAllocs\":" + String(copy.steadyAllocs);
+  json += ",\"paths\":{";
+  for (int i = HEAP_PATH_NONE + 1; i < HEAP_PATH_COUNT; i++)
+  {
+    if (i > HEAP_PATH_NONE + 1)
+      json += ",";
+    json += "\"" + String(pathNames[i]) + "\":" + String(copy.pathAllocs[i]);
+  }
+  json += "},\"lastPath\":\"" + String(heapPathName(copy.lastPath)) + "\"";
+  json += ",\"lastPathAllocSize\":" + String(copy.lastPathAllocSize);
+  json += ",\"freeBytes\":" + String(copy.freeBytes);
+  json += ",\"minFreeBytes\":" + String(copy.minFreeBytes);
+  json += ",\"largestFreeBlock\":" + String(copy.largestFreeBlock);
+  json += ",\"allocatedBlocks\":" + String(copy.allocatedBlocks);
+  json += ",\"blocksSinceSteady\":" + String(copy.blocksSinceSteady) + "}";
+  return json;
+}
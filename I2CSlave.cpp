@@ -0,0 +1,236 @@
+#include "I2CSlave.h"
+#include "ESP_GPT_I2C_Common.h"
+
+static_assert(sizeof(I2CRegisterMap) == I2C_REG_PREVIEW + I2C_PREVIEW_PIXELS * 3, "I2C register offsets out of sync");
+
+// Published block - the I2C task copies out of it under the lock, publishers swap a
+// complete new block in, so a master never sees a half-updated map. The render task
+// and the I2C task (stale refresh) both publish, so the frame rate window and the
+// preview below are only touched under the same lock.
+static I2CRegisterMap publishedMap;
+static portMUX_TYPE registerMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t i2cTaskHandle = NULL;
+static volatile bool slaveRunning = false;
+
+// Sketch status, frame counting and preview window
+static volatile uint8_t statusFlags = 0;
+static volatile uint8_t statusMode = 0;
+static volatile uint8_t statusBrightness = 0;
+static volatile uint8_t statusError = 0;
+static volatile uint32_t framesShown = 0;
+static volatile uint16_t previewOffset = 0;
+static uint8_t previewPixels[I2C_PREVIEW_PIXELS * 3];
+static uint8_t previewCount = 0;
+static volatile uint32_t lastPublishMs = 0;
+static uint32_t fpsWindowStart = 0;
+static uint32_t fpsWindowFrames = 0;
+static uint16_t currentFpsX10 = 0;
+static uint8_t publishSequence = 0;
+
+// Build a complete block on the stack and swap it in
+static void publishRegisters()
+{
+  FramePipelineStats stats;
+  framePipelineGetStats(&stats);
+
+  I2CRegisterMap map;
+  map.version = I2C_REGISTER_MAP_VERSION;
+  map.flags = statusFlags;
+  map.mode = statusMode;
+  map.brightness = statusBrightness;
+  map.lastError = statusError;
+  map.artnetPackets = state.artnetPacketCount;
+  map.framesDropped = stats.framesCoalesced;
+  map.malformed = perfMalformedCount();
+  map.outOfUniverse = perfOutOfUniverseCount();
+  map.freeHeap = ESP.getFreeHeap();
+  map.previewOffset = previewOffset;
+  map.reserved = 0;
+
+  portENTER_CRITICAL(&registerMux);
+  // Frame rate over the time since the last publish
+  uint32_t now = millis();
+  uint32_t frames = framesShown;
+  uint32_t elapsed = now - fpsWindowStart;
+  if (elapsed >= I2C_SLAVE_PUBLISH_MS)
+  {
+    currentFpsX10 = (uint32_t)(frames - fpsWindowFrames) * 10000UL / elapsed;
+    fpsWindowStart = now;
+    fpsWindowFrames = frames;
+  }
+  map.fpsX10 = currentFpsX10;
+  map.framesRendered = frames;
+  map.uptime = now / 1000;
+  map.previewCount = previewCount;
+  memcpy(map.preview, previewPixels, sizeof(map.preview));
+  map.sequence = ++publishSequence;
+  publishedMap = map;
+  lastPublishMs = now;
+  portEXIT_CRITICAL(&registerMux);
+}
+
+static bool installDriver()
+{
+  i2c_config_t config = {};
+  config.mode = I2C_MODE_SLAVE;
+  config.sda_io_num = I2C_SLAVE_SDA_PIN;
+  config.scl_io_num = I2C_SLAVE_SCL_PIN;
+  config.sda_pullup_en = GPIO_PULLUP_ENABLE;
+  config.scl_pullup_en = GPIO_PULLUP_ENABLE;
+  config.slave.addr_10bit_en = 0;
+  config.slave.slave_addr = I2C_SLAVE_ADDRESS;
+
+  return i2c_param_config(I2C_SLAVE_PORT, &config) == ESP_OK &&
+         i2c_driver_install(I2C_SLAVE_PORT, I2C_MODE_SLAVE, I2C_SLAVE_RX_BUFFER_SIZE, I2C_SLAVE_TX_BUFFER_SIZE, 0) == ESP_OK;
+}
+
+// Waits for the master to write a register address, then preloads the TX buffer
+// with the block from that address on - reads themselves are served by the driver
+// ISR without waking anything. The driver's TX ringbuffer cannot be flushed
+// (i2c_reset_tx_fifo only clears the hardware FIFO), so the master reads every
+// preloaded block to its end and the buffer is empty again at the next write.
+static void i2cSlaveTask(void *parameter)
+{
+  uint8_t request[I2C_SLAVE_RX_BUFFER_SIZE];
+  uint8_t response[sizeof(I2CRegisterMap)];
+  heapMonitorSetPath(HEAP_PATH_STATUS);
+
+  for (;;)
+  {
+    int received = i2c_slave_read_buffer(I2C_SLAVE_PORT, request, 1, portMAX_DELAY);
+    if (received < 0)
+    {
+      // Driver gone - i2cSlaveEnd() is about to delete this task
+      vTaskDelay(pdMS_TO_TICKS(I2C_SLAVE_STALE_MS));
+      continue;
+    }
+    if (received == 0)
+    {
+      continue;
+    }
+    // Collect the rest of this write, if any
+    int more = i2c_slave_read_buffer(I2C_SLAVE_PORT, request + 1, sizeof(request) - 1, pdMS_TO_TICKS(1));
+    if (more > 0)
+    {
+      received += more;
+    }
+
+    uint8_t reg = request[0];
+    if (reg == I2C_REG_PREVIEW_OFFSET && received >= 3)
+    {
+      previewOffset = request[1] | (request[2] << 8);
+    }
+    // Only a bare register address is followed by a read
+    if (received > 1)
+    {
+      continue;
+    }
+    if (reg >= sizeof(I2CRegisterMap))
+    {
+      reg = I2C_REG_VERSION;
+    }
+
+    // Nothing has published for a while - refresh uptime, heap and counters here
+    if (millis() - lastPublishMs >= I2C_SLAVE_STALE_MS)
+    {
+      publishRegisters();
+    }
+
+    uint16_t length = sizeof(I2CRegisterMap) - reg;
+    portENTER_CRITICAL(&registerMux);
+    memcpy(response, (uint8_t *)&publishedMap + reg, length);
+    portEXIT_CRITICAL(&registerMux);
+    i2c_slave_write_buffer(I2C_SLAVE_PORT, response, length, 0);
+  }
+}
+
+bool i2cSlaveBegin()
+{
+  if (slaveRunning)
+  {
+    return true;
+  }
+
+  if (!installDriver())
+  {
+    debugLog("ERROR: I2C slave driver install failed");
+    return false;
+  }
+
+  fpsWindowStart = millis();
+  publishRegisters();
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      i2cSlaveTask,              // Task function
+      "I2CSlaveTask",            // Task name
+      I2C_SLAVE_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                      // Task parameter
+      I2C_SLAVE_TASK_PRIORITY,   // Task priority
+      &i2cTaskHandle,            // Task handle
+      NETWORK_CORE               // Core to run the task on
+  );
+
+  if (created != pdPASS)
+  {
+    debugLog("ERROR: Failed to create I2C slave task");
+    i2c_driver_delete(I2C_SLAVE_PORT);
+    return false;
+  }
+
+  slaveRunning = true;
+  debugLog("I2C slave listening at 0x" + String(I2C_SLAVE_ADDRESS, HEX));
+  return true;
+}
+
+void i2cSlaveEnd()
+{
+  if (!slaveRunning)
+  {
+    return;
+  }
+
+  slaveRunning = false;
+  heapMonitorForgetTask(i2cTaskHandle);
+  vTaskDelete(i2cTaskHandle);
+  i2cTaskHandle = NULL;
+  i2c_driver_delete(I2C_SLAVE_PORT);
+}
+
+bool i2cSlaveRunning()
+{
+  return slaveRunning;
+}
+
+void i2cSlaveSetStatus(uint8_t flags, uint8_t mode, uint8_t brightness, uint8_t lastError)
+{
+  statusFlags = flags;
+  statusMode = mode;
+  statusBrightness = brightness;
+  statusError = lastError;
+}
+
+void i2cSlaveFrameShown(const uint8_t *frame, uint16_t numChannels)
+{
+  if (!slaveRunning)
+  {
+    return;
+  }
+
+  framesShown++;
+  if (millis() - lastPublishMs < I2C_SLAVE_PUBLISH_MS)
+  {
+    return;
+  }
+
+  // Only the publishing frame pays for the preview copy
+  uint32_t start = (uint32_t)previewOffset * 3;
+  uint32_t available = start < numChannels ? numChannels - start : 0;
+  uint32_t length = min(available, (uint32_t)sizeof(previewPixels));
+  portENTER_CRITICAL(&registerMux);
+  memcpy(previewPixels, frame + start, length);
+  memset(previewPixels + length, 0, sizeof(previewPixels) - length);
+  previewCount = length / 3;
+  portEXIT_CRITICAL(&registerMux);
+
+  publishRegisters();
+}
@@ -0,0 +1,301 @@
+#include "LedEffects.h"
+#include "ESP_GPT_I2C_Common.h"
+
+struct EffectSlot
+{
+  const char *name;
+  EffectRenderFn render;
+};
+
+struct EffectCost
+{
+  uint32_t frames;
+  uint32_t pixels;
+  uint32_t lastCycles;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+};
+
+static EffectSlot registry[EFFECT_MAX_COUNT];
+static EffectCost costs[EFFECT_MAX_COUNT];
+static portMUX_TYPE costMux = portMUX_INITIALIZER_UNLOCKED;
+static bool tablesBuilt = false;
+
+// Lookup tables - built once, so rendering never touches floats or HSV math
+static uint8_t sineTable[256];
+static CRGB rainbowTable[256];
+static CRGB heatTable[256];
+
+// Animation state - phase is kept in 1/16 units so slow speeds still advance
+static uint8_t effectSpeed = 50;
+static CRGB effectColor = CRGB(255, 255, 255);
+static uint32_t phaseAccumulator = 0;
+static uint32_t lastRenderMs = 0;
+static uint32_t framesRendered = 0;
+static uint32_t randomState = 0x9E3779B9;
+
+uint8_t effectSine(uint8_t angle)
+{
+  return sineTable[angle];
+}
+
+CRGB effectRainbow(uint8_t hue)
+{
+  return rainbowTable[hue];
+}
+
+CRGB effectHeat(uint8_t heat)
+{
+  return heatTable[heat];
+}
+
+CRGB effectScale(CRGB color, uint8_t scale)
+{
+  return CRGB(scale8(color.r, scale), scale8(color.g, scale), scale8(color.b, scale));
+}
+
+uint32_t effectRandom()
+{
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+// Hue sweeps once along each strip and scrolls with the phase
+static void renderRainbow(CRGB *pixels, uint16_t count, const EffectContext &ctx)
+{
+  uint16_t hue = ctx.phase;
+  uint16_t step = (uint16_t)(65536UL / count);
+  for (uint16_t i = 0; i < count; i++)
+  {
+    pixels[i] = rainbowTable[hue >> 8];
+    hue += step;
+  }
+}
+
+// Whole strip breathes on a fixed 6.4 s period while the hue drifts at half speed
+static void renderPulse(CRGB *pixels, uint16_t count, const EffectContext &ctx)
+{
+  uint8_t brightness = sineTable[(uint8_t)(ctx.timeMs / 25)];
+  fill_solid(pixels, count, effectScale(rainbowTable[ctx.phase >> 9], brightness));
+}
+
+// Independent flicker per pixel over the red - yellow part of the heat palette
+static void renderFire(CRGB *pixels, uint16_t count, const EffectContext &ctx)
+{
+  uint32_t bits = 0;
+  for (uint16_t i = 0; i < count; i++)
+  {
+    if ((i & 3) == 0)
+    {
+      bits = effectRandom();
+    }
+    pixels[i] = heatTable[80 + (bits & 0x5F)];
+    bits >>= 8;
+  }
+}
+
+// A head in the base color running along the strip with a linear fading tail
+static void renderChase(CRGB *pixels, uint16_t count, const EffectContext &ctx)
+{
+  uint16_t tail = count / 8 > 0 ? count / 8 : 1;
+  uint16_t head = (uint16_t)(((uint32_t)ctx.phase * count) >> 16);
+  uint32_t fadeStep = 65535UL / tail;
+
+  fill_solid(pixels, count, CRGB::Black);
+  for (uint16_t k = 0; k < tail; k++)
+  {
+    uint16_t index = head >= k ? head - k : head + count - k;
+    pixels[index] = effectScale(ctx.color, 255 - ((k * fadeStep) >> 8));
+  }
+}
+
+// Every pixel follows the sine at its own offset and one of four rates,
+// lighting up only near the crest - stateless, so it costs no buffer
+static void renderTwinkle(CRGB *pixels, uint16_t count, const EffectContext &ctx)
+{
+  uint8_t angle = ctx.phase >> 8;
+  for (uint16_t i = 0; i < count; i++)
+  {
+    uint32_t hash = (i + ctx.strip * 7919U) * 2654435761U;
+    uint8_t level = sineTable[(uint8_t)(angle * (1 + (hash & 3)) + (hash >> 24))];
+    pixels[i] = level > 192 ? effectScale(ctx.color, (level - 192) * 4) : CRGB(0, 0, 0);
+  }
+}
+
+void effectsBegin()
+{
+  if (tablesBuilt)
+  {
+    return;
+  }
+
+  for (int i = 0; i < 256; i++)
+  {
+    sineTable[i] = (uint8_t)lroundf(127.5f + 127.5f * sinf(i * (2.0f * PI / 256.0f)));
+    rainbowTable[i] = CHSV(i, 255, 255);
+
+    // Heat ramps red, then green, then blue in thirds
+    uint16_t t = i * 3;
+    heatTable[i] = t < 256 ? CRGB(t, 0, 0) : t < 512 ? CRGB(255, t - 256, 0) : CRGB(255, 255, t - 512);
+  }
+  tablesBuilt = true;
+
+  effectsRegister(EFFECT_ID_RAINBOW, "Rainbow", renderRainbow);
+  effectsRegister(EFFECT_ID_PULSE, "Pulse", renderPulse);
+  effectsRegister(EFFECT_ID_FIRE, "Fire", renderFire);
+  effectsRegister(EFFECT_ID_CHASE, "Chase", renderChase);
+  effectsRegister(EFFECT_ID_TWINKLE, "Twinkle", renderTwinkle);
+}
+
+bool effectsRegister(uint8_t id, const char *name, EffectRenderFn render)
+{
+  if (id == 0 || id >= EFFECT_MAX_COUNT || render == NULL)
+  {
+    return false;
+  }
+
+  registry[id].name = name;
+  registry[id].render = render;
+
+  portENTER_CRITICAL(&costMux);
+  memset(&costs[id], 0, sizeof(costs[id]));
+  portEXIT_CRITICAL(&costMux);
+  return true;
+}
+
+const char *effectsName(uint8_t id)
+{
+  return id < EFFECT_MAX_COUNT ? registry[id].name : NULL;
+}
+
+void effectsSetParams(uint8_t speed, CRGB color)
+{
+  effectSpeed = constrain(speed, 1, 100);
+  effectColor = color;
+}
+
+bool effectsRender(uint8_t id, const LedLayout *layout, CRGB *pixels, uint16_t numPixels, uint32_t nowMs)
+{
+  if (id >= EFFECT_MAX_COUNT || registry[id].render == NULL || pixels == NULL)
+  {
+    return false;
+  }
+
+  uint32_t start = ESP.getCycleCount();
+
+  // 21/16 phase units per ms and speed step: speed 50 is ~one cycle per second
+  // whatever the frame rate
+  phaseAccumulator += (nowMs - lastRenderMs) * effectSpeed * 21;
+  lastRenderMs = nowMs;
+
+  EffectContext ctx;
+  ctx.timeMs = nowMs;
+  ctx.phase = (uint16_t)(phaseAccumulator >> 4);
+  ctx.strip = 0;
+  ctx.frame = framesRendered++;
+  ctx.color = effectColor;
+
+  uint32_t drawn = 0;
+  if (layout == NULL || layout->numOutputs == 0)
+  {
+    if (numPixels > 0)
+    {
+      registry[id].render(pixels, numPixels, ctx);
+      drawn = numPixels;
+    }
+  }
+  else
+  {
+    // Each strip gets the whole pattern, so they line up side by side
+    for (uint8_t i = 0; i < layout->numOutputs; i++)
+    {
+      const LedOutputConfig &output = layout->outputs[i];
+      if (output.pin < 0 || output.length == 0 || output.startOffset + output.length > numPixels)
+      {
+        continue;
+      }
+      ctx.strip = i;
+      registry[id].render(pixels + output.startOffset, output.length, ctx);
+      drawn += output.length;
+    }
+  }
+
+  uint32_t cycles = ESP.getCycleCount() - start;
+  perfRecord(PERF_STAGE_EFFECT, start);
+
+  portENTER_CRITICAL(&costMux);
+  EffectCost &cost = costs[id];
+  cost.frames++;
+  cost.pixels = drawn;
+  cost.lastCycles = cycles;
+  cost.totalCycles += cycles;
+  if (cycles > cost.maxCycles)
+  {
+    cost.maxCycles = cycles;
+  }
+  portEXIT_CRITICAL(&costMux);
+  return true;
+}
+
+void effectsGetStats(uint8_t id, EffectStats *stats)
+{
+  *stats = EffectStats();
+  if (id >= EFFECT_MAX_COUNT)
+  {
+    return;
+  }
+
+  EffectCost snapshot;
+  portENTER_CRITICAL(&costMux);
+  snapshot = costs[id];
+  portEXIT_CRITICAL(&costMux);
+
+  if (snapshot.frames == 0)
+  {
+    return;
+  }
+
+  float cyclesPerUs = ESP.getCpuFreqMHz();
+  stats->frames = snapshot.frames;
+  stats->pixels = snapshot.pixels;
+  stats->lastUs = snapshot.lastCycles / cyclesPerUs;
+  stats->avgUs = (float)(snapshot.totalCycles / snapshot.frames) / cyclesPerUs;
+  stats->maxUs = snapshot.maxCycles / cyclesPerUs;
+}
+
+void effectsResetStats()
+{
+  portENTER_CRITICAL(&costMux);
+  memset(costs, 0, sizeof(costs));
+  portEXIT_CRITICAL(&costMux);
+}
+
+String effectsStatsJson()
+{
+  String json = "{";
+  bool first = true;
+  for (uint8_t id = 1; id < EFFECT_MAX_COUNT; id++)
+  {
+    if (registry[id].render == NULL)
+    {
+      continue;
+    }
+
+    EffectStats stats;
+    effectsGetStats(id, &stats);
+    if (!first)
+      json += ",";
+    first = false;
+
+    json += "\"" + String(registry[id].name) + "\":{\"frames\":" + String(stats.frames);
+    json += ",\"pixels\":" + String(stats.pixels);
+    json += ",\"lastUs\":" + String(stats.lastUs, 2);
+    json += ",\"avgUs\":" + String(stats.avgUs, 2);
+    json += ",\"maxUs\":" + String(stats.maxUs, 2);
+    json += ",\"nsPerPixel\":" + String(stats.pixels > 0 ? stats.avgUs * 1000.0f / stats.pixels : 0.0f, 1) + "}";
+  }
+  json += "}";
+  return json;
+}
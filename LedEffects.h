@@ -0,0 +1,74 @@
+#ifndef LED_EFFECTS_H
+#define LED_EFFECTS_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include "LedLayout.h"
+
+// Local effects engine: effects are render functions in a registry, drawn strip
+// by strip into the shared pixel buffer. All per-pixel math is 8/16-bit fixed
+// point on tables built once by effectsBegin().
+
+// Registry slots - id 0 is reserved for "no effect" (static color)
+#define EFFECT_MAX_COUNT 8
+
+// Built-in effects, registered by effectsBegin()
+#define EFFECT_ID_RAINBOW 1
+#define EFFECT_ID_PULSE 2
+#define EFFECT_ID_FIRE 3
+#define EFFECT_ID_CHASE 4
+#define EFFECT_ID_TWINKLE 5
+
+// What an effect gets to draw one strip. The phases wrap at 65536 (one cycle).
+struct EffectContext
+{
+  uint32_t timeMs;   // Frame time
+  uint16_t phase;    // Animation phase, advanced by elapsed time scaled by speed
+  uint16_t strip;    // Output being drawn (0 when the buffer has no layout)
+  uint32_t frame;    // Frames rendered by the engine
+  CRGB color;        // Base color for single-color effects
+};
+
+// Draw pixels[0..count), the strip's slice of the pixel buffer
+typedef void (*EffectRenderFn)(CRGB *pixels, uint16_t count, const EffectContext &ctx);
+
+// Render cost of one effect since the last effectsResetStats()
+struct EffectStats
+{
+  uint32_t frames = 0;
+  uint32_t pixels = 0;   // Pixels drawn by the last frame
+  float lastUs = 0;
+  float avgUs = 0;
+  float maxUs = 0;
+};
+
+// Build the sine and palette tables and register the built-in effects (idempotent)
+void effectsBegin();
+
+// Add or replace an effect; fails for id 0 or ids outside the registry
+bool effectsRegister(uint8_t id, const char *name, EffectRenderFn render);
+
+// Name of a registered effect, NULL for an empty slot
+const char *effectsName(uint8_t id);
+
+// Speed 1-100 (50 is about one cycle per second) and the base color
+void effectsSetParams(uint8_t speed, CRGB color);
+
+// Draw one frame of effect id into every output of the layout (the whole buffer
+// when the layout has none). Returns false if no such effect is registered.
+bool effectsRender(uint8_t id, const LedLayout *layout, CRGB *pixels, uint16_t numPixels, uint32_t nowMs);
+
+void effectsGetStats(uint8_t id, EffectStats *stats);
+void effectsResetStats();
+
+// {"<name>":{"frames":..,"pixels":..,"lastUs":..,"avgUs":..,"maxUs":..,"nsPerPixel":..},..}
+String effectsStatsJson();
+
+// Shared tables, for effects registered by the sketch
+uint8_t effectSine(uint8_t angle);        // 0-255 over one period, centered on 128
+CRGB effectRainbow(uint8_t hue);
+CRGB effectHeat(uint8_t heat);            // Black - red - yellow - white
+CRGB effectScale(CRGB color, uint8_t scale);
+uint32_t effectRandom();                  // xorshift32, four random bytes per call
+
+#endif // LED_EFFECTS_H
@@ -0,0 +1,74 @@
+#ifndef LED_LAYOUT_H
+#define LED_LAYOUT_H
+
+#include <Arduino.h>
+
+// Output limits - these mirror src/Config.h so the sketch folders build without it
+#ifndef MAX_LED_STRIPS
+#define MAX_LED_STRIPS 12
+#endif
+#ifndef MAX_LEDS_PER_STRIP
+#define MAX_LEDS_PER_STRIP 300
+#endif
+
+#define LED_LAYOUT_NAMESPACE "led-layout"
+#define LED_LAYOUT_VERSION 1
+
+// Wire color orders - the bytes a strip expects, in transmission order
+enum LedColorOrder
+{
+  LED_ORDER_RGB = 0,
+  LED_ORDER_RBG = 1,
+  LED_ORDER_GRB = 2,
+  LED_ORDER_GBR = 3,
+  LED_ORDER_BRG = 4,
+  LED_ORDER_BGR = 5,
+  LED_ORDER_COUNT
+};
+
+// One physical output: a data pin fed from a slice of the pixel buffer
+struct LedOutputConfig
+{
+  int8_t pin = -1;                   // GPIO, -1 when the output is unused
+  uint8_t colorOrder = LED_ORDER_GRB; // LedColorOrder
+  uint16_t length = 0;               // Pixels on the strip
+  uint16_t startOffset = 0;          // First pixel of the strip in the pixel buffer
+};
+
+struct LedLayout
+{
+  uint8_t numOutputs = 0;
+  LedOutputConfig outputs[MAX_LED_STRIPS];
+};
+
+// Strips of equal length laid out back to back - the pre-layout configuration
+void ledLayoutSetUniform(LedLayout *layout, const int *pins, uint8_t numStrips, uint16_t ledsPerStrip);
+
+// Load the stored layout; returns false (layout untouched) if none is stored
+bool ledLayoutLoad(LedLayout *layout);
+bool ledLayoutSave(const LedLayout *layout);
+
+// Check pins, lengths and buffer extents; logs the first problem found
+bool ledLayoutValidate(const LedLayout *layout);
+
+bool ledLayoutEquals(const LedLayout *a, const LedLayout *b);
+
+// Pixels the shared buffer must hold (end of the furthest output)
+uint16_t ledLayoutPixelCount(const LedLayout *layout);
+
+// Longest output, the per-strip stride of parallel drivers
+uint16_t ledLayoutMaxLength(const LedLayout *layout);
+
+// Pixels across all outputs when packed back to back
+uint16_t ledLayoutWireCount(const LedLayout *layout);
+
+// Convert each output's slice of the RGB pixel buffer into the wire buffer in the
+// strip's color order, with brightness and gamma applied by pixelConvert(). With
+// stride 0 outputs are packed back to back, otherwise output i starts at pixel
+// i * stride (the tail of shorter strips is left alone).
+void ledLayoutPack(const LedLayout *layout, const uint8_t *pixels, uint16_t numPixels, uint8_t *wire, uint16_t stride);
+
+const char *ledColorOrderName(uint8_t order);
+uint8_t ledColorOrderFromName(const String &name);
+
+#endif // LED_LAYOUT_H
@@ -0,0 +1,119 @@
+#include "LiveView.h"
+#include "ESP_GPT_I2C_Common.h"
+
+static_assert(sizeof(LiveViewHeader) == 36, "Live view header layout is shared with web/embedded_ui.html");
+
+// Capture buffer - written by the render task, read by the web server under the lock
+static uint8_t capturedPixels[LIVE_VIEW_MAX_PIXELS * 3];
+static uint16_t capturedCount = 0;
+static uint16_t capturedTotal = 0;
+static uint16_t capturedStride = 1;
+static uint8_t captureSequence = 0;
+static uint8_t sentSequence = 0;
+static portMUX_TYPE captureMux = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile uint8_t subscribers = 0;
+static volatile uint8_t statusMode = 0;
+static volatile uint8_t statusBrightness = 0;
+static volatile uint32_t framesShown = 0;
+static uint32_t lastCaptureMs = 0;
+
+// Frame rate between two messages
+static uint32_t fpsWindowStart = 0;
+static uint32_t fpsWindowFrames = 0;
+static uint16_t currentFpsX10 = 0;
+
+void liveViewSetSubscribers(uint8_t count)
+{
+  subscribers = count;
+}
+
+void liveViewSetStatus(uint8_t mode, uint8_t brightness)
+{
+  statusMode = mode;
+  statusBrightness = brightness;
+}
+
+void liveViewFrameShown(const uint8_t *frame, uint16_t numChannels)
+{
+  framesShown++;
+  if (subscribers == 0)
+  {
+    return;
+  }
+
+  uint32_t now = millis();
+  if (now - lastCaptureMs < LIVE_VIEW_INTERVAL_MS)
+  {
+    return;
+  }
+  lastCaptureMs = now;
+
+  // Point-sample an evenly spaced subset, one pixel per stride
+  uint16_t total = numChannels / 3;
+  uint16_t stride = (total + LIVE_VIEW_MAX_PIXELS - 1) / LIVE_VIEW_MAX_PIXELS;
+  if (stride == 0)
+  {
+    stride = 1;
+  }
+  uint16_t count = total / stride;
+
+  portENTER_CRITICAL(&captureMux);
+  for (uint16_t i = 0; i < count; i++)
+  {
+    memcpy(&capturedPixels[i * 3], &frame[(uint32_t)i * stride * 3], 3);
+  }
+  capturedCount = count;
+  capturedTotal = total;
+  capturedStride = stride;
+  captureSequence++;
+  portEXIT_CRITICAL(&captureMux);
+}
+
+uint16_t liveViewBuildMessage(uint8_t *buffer, uint16_t size)
+{
+  if (size < LIVE_VIEW_MAX_MESSAGE_SIZE)
+  {
+    return 0;
+  }
+
+  uint32_t now = millis();
+  uint32_t frames = framesShown;
+  uint32_t elapsed = now - fpsWindowStart;
+  if (elapsed > 0)
+  {
+    currentFpsX10 = (uint32_t)(frames - fpsWindowFrames) * 10000UL / elapsed;
+    fpsWindowStart = now;
+    fpsWindowFrames = frames;
+  }
+
+  FramePipelineStats stats;
+  framePipelineGetStats(&stats);
+
+  LiveViewHeader header;
+  header.type = LIVE_VIEW_MSG_FRAME;
+  header.version = LIVE_VIEW_PROTOCOL_VERSION;
+  header.mode = statusMode;
+  header.brightness = statusBrightness;
+  header.reserved = 0;
+  header.fpsX10 = currentFpsX10;
+  header.reserved2 = 0;
+  header.artnetPackets = state.artnetPacketCount;
+  header.framesRendered = frames;
+  header.framesDropped = stats.framesCoalesced;
+  header.freeHeap = ESP.getFreeHeap();
+  header.uptime = now / 1000;
+
+  portENTER_CRITICAL(&captureMux);
+  header.sequence = captureSequence;
+  header.totalPixels = capturedTotal;
+  header.stride = capturedStride;
+  // Stats only when nothing new was captured - the viewer keeps its last pixels
+  header.count = captureSequence != sentSequence ? capturedCount : 0;
+  memcpy(buffer + sizeof(header), capturedPixels, header.count * 3);
+  sentSequence = captureSequence;
+  portEXIT_CRITICAL(&captureMux);
+
+  memcpy(buffer, &header, sizeof(header));
+  return sizeof(header) + header.count * 3;
+}
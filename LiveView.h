@@ -0,0 +1,66 @@
+#ifndef LIVE_VIEW_H
+#define LIVE_VIEW_H
+
+#include <Arduino.h>
+
+// Live pixel preview for the web UI. The output stage hands every shown frame to
+// liveViewFrameShown(); while somebody is watching, a downsampled copy is taken
+// at most every LIVE_VIEW_INTERVAL_MS and the web server pushes it as one binary
+// WebSocket message. Nothing is copied while there are no subscribers.
+#define LIVE_VIEW_MAX_PIXELS 128
+#define LIVE_VIEW_INTERVAL_MS 100 // 10 previews per second at most
+#define LIVE_VIEW_PROTOCOL_VERSION 1
+
+// Server -> client message types
+#define LIVE_VIEW_MSG_FRAME 0x01 // LiveViewHeader followed by count RGB triplets
+
+// Client -> server control messages, first byte is the command
+#define LIVE_VIEW_CMD_BRIGHTNESS 0x10 // [brightness]
+#define LIVE_VIEW_CMD_COLOR 0x11      // [r][g][b]
+#define LIVE_VIEW_CMD_MODE 0x12       // [mode] - sketch-defined, see LIVE_VIEW_MODE_*
+
+// Modes understood by the default control handler in WebServerManager
+#define LIVE_VIEW_MODE_OFF 0
+#define LIVE_VIEW_MODE_ARTNET 1
+#define LIVE_VIEW_MODE_STATIC 2
+#define LIVE_VIEW_MODE_EFFECT 3 // Full build only - color cycle effects
+
+// Frame message header - multi-byte values are little endian
+struct __attribute__((packed)) LiveViewHeader
+{
+  uint8_t type;            // LIVE_VIEW_MSG_FRAME
+  uint8_t version;         // LIVE_VIEW_PROTOCOL_VERSION
+  uint8_t sequence;        // Incremented per captured preview
+  uint8_t mode;            // As set with liveViewSetStatus()
+  uint8_t brightness;
+  uint8_t reserved;
+  uint16_t fpsX10;         // Rendered frames per second x10
+  uint16_t totalPixels;    // Pixels in the source frame
+  uint16_t stride;         // Preview pixel i is source pixel i * stride
+  uint16_t count;          // RGB triplets after the header, 0 = pixels unchanged
+  uint16_t reserved2;
+  uint32_t artnetPackets;
+  uint32_t framesRendered;
+  uint32_t framesDropped;  // Coalesced before they were shown
+  uint32_t freeHeap;
+  uint32_t uptime;         // Seconds
+};
+
+#define LIVE_VIEW_MAX_MESSAGE_SIZE (sizeof(LiveViewHeader) + LIVE_VIEW_MAX_PIXELS * 3)
+
+// Number of connected viewers - previews are only captured while this is non-zero
+void liveViewSetSubscribers(uint8_t count);
+
+// Values only the sketch knows, reported in the next message
+void liveViewSetStatus(uint8_t mode, uint8_t brightness);
+
+// Call from the output stage with every frame shown (RGB triplets). Counts frames
+// and, when a preview is due, samples it into the capture buffer.
+void liveViewFrameShown(const uint8_t *frame, uint16_t numChannels);
+
+// Compose the next frame message into buffer (at least LIVE_VIEW_MAX_MESSAGE_SIZE).
+// The pixels are only included when a new preview was captured since the last call.
+// Returns the message length, 0 if the buffer is too small.
+uint16_t liveViewBuildMessage(uint8_t *buffer, uint16_t size);
+
+#endif // LIVE_VIEW_H
@@ -0,0 +1,257 @@
+#include "LogRing.h"
+#include <stdarg.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static LogRecord logRing[LOG_RING_SIZE];
+static volatile uint32_t writeIndex = 0;
+static volatile uint32_t readIndex = 0; // Advanced by the formatter task only
+static volatile uint32_t droppedRecords = 0;
+static TaskHandle_t logTaskHandle = NULL;
+
+// Claim the next slot - the only shared write is this one atomic add
+static LogRecord *claimRecord(uint32_t *index)
+{
+  *index = __atomic_fetch_add(&writeIndex, 1, __ATOMIC_RELAXED);
+  LogRecord *record = &logRing[*index & (LOG_RING_SIZE - 1)];
+  __atomic_store_n(&record->sequence, 0, __ATOMIC_RELAXED);
+  return record;
+}
+
+static void commitRecord(LogRecord *record, uint32_t index)
+{
+  __atomic_store_n(&record->sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+void logRingWrite(uint8_t level, const char *format, ...)
+{
+  uint32_t index;
+  LogRecord *record = claimRecord(&index);
+  record->timestamp = millis();
+  record->level = level;
+  record->format = format;
+
+  // One argument per conversion, "%%" excluded
+  uint8_t argCount = 0;
+  for (const char *p = format; *p != '\0' && argCount < LOG_RING_MAX_ARGS; p++)
+  {
+    if (*p == '%')
+    {
+      if (p[1] == '%')
+        p++;
+      else
+        argCount++;
+    }
+  }
+
+  va_list args;
+  va_start(args, format);
+  for (uint8_t i = 0; i < argCount; i++)
+  {
+    record->args[i] = va_arg(args, uint32_t);
+  }
+  va_end(args);
+  record->argCount = argCount;
+
+  commitRecord(record, index);
+}
+
+void logRingText(uint8_t level, const char *text)
+{
+  uint32_t index;
+  LogRecord *record = claimRecord(&index);
+  record->timestamp = millis();
+  record->level = level;
+  record->format = NULL;
+  record->argCount = LOG_RING_TEXT;
+  strlcpy(record->text, text, sizeof(record->text));
+  commitRecord(record, index);
+}
+
+// Copy a record out only if it is still the one for index (seqlock-style re-check)
+static bool readRecord(uint32_t index, LogRecord *copy)
+{
+  const LogRecord *record = &logRing[index & (LOG_RING_SIZE - 1)];
+  if (__atomic_load_n(&record->sequence, __ATOMIC_ACQUIRE) != index + 1)
+  {
+    return false;
+  }
+  memcpy(copy, record, sizeof(LogRecord));
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&record->sequence, __ATOMIC_RELAXED) == index + 1;
+}
+
+const char *logLevelName(uint8_t level)
+{
+  switch (level)
+  {
+  case LOG_LEVEL_VERBOSE:
+    return "VERBOSE";
+  case LOG_LEVEL_DEBUG:
+    return "DEBUG";
+  case LOG_LEVEL_INFO:
+    return "INFO";
+  case LOG_LEVEL_WARNING:
+    return "WARNING";
+  case LOG_LEVEL_ERROR:
+    return "ERROR";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+// "HH:MM:SS.mmm [LEVEL] message"
+static void formatRecord(const LogRecord *record, char *line, size_t size)
+{
+  uint32_t t = record->timestamp;
+  int used = snprintf(line, size, "%02lu:%02lu:%02lu.%03lu [%s] ",
+                      (unsigned long)(t / 3600000UL % 24), (unsigned long)(t / 60000UL % 60),
+                      (unsigned long)(t / 1000UL % 60), (unsigned long)(t % 1000),
+                      logLevelName(record->level));
+  if (used < 0 || (size_t)used >= size)
+  {
+    return;
+  }
+
+  if (record->argCount == LOG_RING_TEXT)
+  {
+    strlcpy(line + used, record->text, size - used);
+  }
+  else
+  {
+    // Every argument is a 32-bit word, so passing all of them is safe for any format
+    snprintf(line + used, size - used, record->format,
+             record->args[0], record->args[1], record->args[2], record->args[3]);
+  }
+}
+
+// Print everything committed since the last call
+static void drainToSerial()
+{
+  char line[LOG_RING_LINE_SIZE];
+  LogRecord record;
+
+  for (;;)
+  {
+    uint32_t head = __atomic_load_n(&writeIndex, __ATOMIC_ACQUIRE);
+    if (readIndex == head)
+    {
+      return;
+    }
+
+    // Lapped - everything older than one ring is gone
+    if (head - readIndex > LOG_RING_SIZE)
+    {
+      droppedRecords += head - readIndex - LOG_RING_SIZE;
+      readIndex = head - LOG_RING_SIZE;
+    }
+
+    if (!readRecord(readIndex, &record))
+    {
+      const LogRecord *slot = &logRing[readIndex & (LOG_RING_SIZE - 1)];
+      uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+      if (sequence == 0 || sequence <= readIndex)
+      {
+        return; // Still being written, pick it up next time
+      }
+      droppedRecords++; // Overwritten by a newer record
+      readIndex++;
+      continue;
+    }
+
+    formatRecord(&record, line, sizeof(line));
+    Serial.println(line);
+    readIndex++;
+  }
+}
+
+static void logRingTask(void *parameter)
+{
+  for (;;)
+  {
+    drainToSerial();
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_RING_FLUSH_MS));
+  }
+}
+
+bool logRingBegin()
+{
+  if (logTaskHandle != NULL)
+  {
+    return true;
+  }
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      logRingTask,              // Task function
+      "LogTask",                // Task name
+      LOG_RING_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                     // Task parameter
+      LOG_RING_TASK_PRIORITY,   // Task priority
+      &logTaskHandle,           // Task handle
+      NETWORK_CORE              // Core to run the task on
+  );
+
+  return created == pdPASS;
+}
+
+void logRingFlush()
+{
+  if (logTaskHandle == NULL)
+  {
+    drainToSerial();
+    Serial.flush();
+    return;
+  }
+
+  // Only the formatter task drains once it runs - wake it and give it a moment to catch up
+  for (int i = 0; i < 10 && readIndex != writeIndex; i++)
+  {
+    xTaskNotifyGive(logTaskHandle);
+    vTaskDelay(pdMS_TO_TICKS(5));
+  }
+  Serial.flush();
+}
+
+uint32_t logRingHead()
+{
+  return __atomic_load_n(&writeIndex, __ATOMIC_ACQUIRE);
+}
+
+uint32_t logRingOldest(uint16_t count)
+{
+  uint32_t head = logRingHead();
+  return head - min((uint32_t)count, min(head, (uint32_t)LOG_RING_SIZE));
+}
+
+bool logRingLine(uint32_t index, char *line, size_t size)
+{
+  LogRecord record;
+  if (!readRecord(index, &record))
+  {
+    return false;
+  }
+  formatRecord(&record, line, size);
+  return true;
+}
+
+uint16_t logRingRecent(uint16_t count, LogRingLineCallback callback, void *context)
+{
+  char line[LOG_RING_LINE_SIZE];
+
+  uint32_t head = logRingHead();
+  uint16_t visited = 0;
+  for (uint32_t index = logRingOldest(count); index != head; index++)
+  {
+    if (logRingLine(index, line, sizeof(line)))
+    {
+      callback(line, context);
+      visited++;
+    }
+  }
+  return visited;
+}
+
+uint32_t logRingDropped()
+{
+  return droppedRecords;
+}
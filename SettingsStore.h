@@ -0,0 +1,74 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#include <Arduino.h>
+
+// Settings persisted as one versioned binary blob in NVS: read once at boot,
+// written in one putBytes() per commit. Callers change their settings in RAM and
+// mark the touched field groups dirty; the blob is packed and committed once no
+// change has arrived for SETTINGS_STORE_QUIET_MS, and a commit that would write
+// the bytes already in flash is skipped.
+#define SETTINGS_STORE_NAMESPACE "settings"
+#define SETTINGS_STORE_KEY "blob"
+#define SETTINGS_STORE_MAX_SIZE 384 // Sketch settings record, header not included
+#define SETTINGS_STORE_QUIET_MS 2000
+#define SETTINGS_STORE_MAGIC 0x5347 // "SG"
+
+// System flags, kept in the blob header so shared code can set them without
+// knowing the sketch's record
+#define SETTINGS_FLAG_NET_FAILED 0x01  // Network stack disabled after a failure
+#define SETTINGS_FLAG_NET_RESTART 0x02 // WiFi credentials changed
+
+// Dirty bit for header flag changes - the lower bits are the sketch's field groups
+#define SETTINGS_FIELD_FLAGS 0x80000000UL
+
+struct SettingsStoreHeader
+{
+  uint16_t magic;
+  uint8_t version;    // Sketch record version
+  uint8_t flags;      // SETTINGS_FLAG_*
+  uint16_t size;      // Record bytes following the header
+  uint16_t reserved;
+  uint32_t hash;      // pixelHash() of the record
+};
+
+struct SettingsStoreStats
+{
+  uint32_t commits = 0;       // Blobs written
+  uint32_t skipped = 0;       // Commits that matched the stored bytes
+  uint32_t dirtyFields = 0;   // Field groups changed since the last commit
+  uint32_t lastCommitMs = 0;
+  uint16_t size = 0;          // Record bytes
+  uint8_t loadedVersion = 0;  // Version read at boot, 0 if nothing was stored
+};
+
+// Fill record from the current settings, called right before it is written
+typedef void (*SettingsPackFn)(void *record);
+
+// Register the RAM record (already holding defaults) and load the stored blob into
+// it. Records only ever grow by appending fields, so an older, shorter blob loads
+// as a prefix and the new fields keep their defaults. Returns false when nothing
+// usable was stored.
+bool settingsStoreBegin(void *record, uint16_t size, uint8_t version, SettingsPackFn pack);
+
+// Changes of the given field groups, committed after the quiet period
+void settingsStoreMarkDirty(uint32_t fields);
+uint32_t settingsStoreDirtyFields();
+
+// True once something is dirty and the quiet period has passed
+bool settingsStoreCommitDue();
+
+// Pack and write now if anything is dirty. Returns false if the write failed.
+bool settingsStoreCommit();
+
+bool settingsStoreFlag(uint8_t flag);
+
+// commitNow writes straight away, for state that must survive an imminent crash
+void settingsStoreSetFlag(uint8_t flag, bool set, bool commitNow = false);
+
+void settingsStoreGetStats(SettingsStoreStats *stats);
+
+// {"commits":..,"skipped":..,"dirty":..,"lastCommitMs":..,"bytes":..,"version":..}
+String settingsStoreStatsJson();
+
+#endif // SETTINGS_STORE_H
@@ -0,0 +1,45 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Per-task runtime statistics from uxTaskGetSystemState(): CPU share over the
+// last sampling interval, core affinity and stack high-water mark. Sampling is
+// done by the housekeeping task; readers only copy the last snapshot.
+
+#define TASK_MONITOR_MAX_TASKS 24
+#define TASK_MONITOR_INTERVAL_MS 1000
+#define TASK_MONITOR_NAME_SIZE 16
+
+// Core of a task that may run on either one
+#define TASK_MONITOR_ANY_CORE -1
+
+struct TaskMonitorEntry
+{
+  char name[TASK_MONITOR_NAME_SIZE];
+  uint8_t priority;
+  int8_t core;            // TASK_MONITOR_ANY_CORE when unpinned
+  uint32_t stackFree;     // Stack high-water mark, bytes never used
+  float cpuPercent;       // Share of one core over the last interval
+};
+
+struct TaskMonitorSnapshot
+{
+  uint32_t timestamp;     // millis() of the sample
+  uint8_t taskCount;
+  float coreLoad[portNUM_PROCESSORS]; // Busy percentage, 100 - idle task share
+  TaskMonitorEntry tasks[TASK_MONITOR_MAX_TASKS];
+};
+
+// Take a sample - the first call only sets the baseline for the CPU shares.
+// Returns false when the build lacks trace facility / run time stats.
+bool taskMonitorSample();
+
+void taskMonitorGetSnapshot(TaskMonitorSnapshot *snapshot);
+
+// {"cores":[..],"tasks":[{"name":..,"core":..,"priority":..,"cpu":..,"stackFree":..},..]}
+String taskMonitorJson();
+
+#endif // TASK_MONITOR_H
@@ -1,7 +1,21 @@
 #include "WebServerManager.h"
+#include "EmbeddedWebUI.h"
 
 // Define global web server
 AsyncWebServer server(80);
+AsyncWebSocket liveSocket(WEB_LIVE_VIEW_PATH);
+
+// Control messages are only recorded by the socket handler (AsyncTCP task) and
+// applied from webServerLoop(), latest value wins
+static WebControlHandler controlHandler = NULL;
+static volatile int16_t pendingBrightness = -1;
+static volatile int16_t pendingMode = -1;
+static volatile bool pendingColor = false;
+static uint8_t pendingColorRGB[3];
+static uint8_t liveMode = LIVE_VIEW_MODE_ARTNET;
+static CRGB liveColor = CRGB::White;
+static unsigned long lastLivePushMs = 0;
+static uint8_t liveMessage[LIVE_VIEW_MAX_MESSAGE_SIZE];
 
 // Debug logging function with timestamps
 void logWithTimestamp(const String &message)
@@ -19,7 +33,7 @@ void logWithTimestamp(const String &message)
 }
 
 // Main function to set up the web server
-void setupWebServer()
+void setupWebServer(WebRouteSetup sketchRoutes)
 {
   // Initialize SPIFFS first
   bool spiffsInitialized = SPIFFS.begin(true);
@@ -58,6 +72,12 @@ void setupWebServer()
     }
   }
 
+  // Sketch routes first so they take precedence over the defaults below
+  if (sketchRoutes != NULL)
+  {
+    sketchRoutes(server);
+  }
+
   // Set up root route handler based on whether SPIFFS is available
   if (spiffsInitialized && SPIFFS.exists("/index.html"))
   {
@@ -87,23 +107,25 @@ void setupWebServer()
 
     // Serve the root page using embedded HTML
     server.on("/", HTTP_GET, [](AsyncWebServerRequest *request)
-              {
-      logWithTimestamp("Serving embedded HTML content");
-      request->send(200, "text/html", generateEmbeddedHTML()); });
+              { handleEmbeddedUI(request); });
   }
 
   // Always set up the /settings endpoint for JSON API
   server.on("/settings", HTTP_GET, [](AsyncWebServerRequest *request)
             {
-    logWithTimestamp("Serving /settings endpoint (JSON)");
+    logRingWrite(LOG_LEVEL_DEBUG, "Serving /settings endpoint (JSON)");
     handleSettings(request); });
 
   // Set up endpoint for debug logs
   server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request)
             {
-    logWithTimestamp("Serving /logs endpoint (JSON)");
+    logRingWrite(LOG_LEVEL_DEBUG, "Serving /logs endpoint (JSON)");
     handleLog(request); });
 
+  // Hot-path timings and packet/frame counters, ?reset=1 clears them after reading
+  server.on("/stats", HTTP_GET, [](AsyncWebServerRequest *request)
+            { handleStats(request); });
+
   // Set up POST handler for config updates
   server.on("/config", HTTP_POST, [](AsyncWebServerRequest *request)
             {
@@ -117,6 +139,10 @@ void setupWebServer()
               // This handler processes POST body data - implement if needed for JSON data
             });
 
+  // Live view and control channel, see LiveView.h for the binary message format
+  liveSocket.onEvent(onLiveSocketEvent);
+  server.addHandler(&liveSocket);
+
   // Set up a handler for 404 errors
   server.onNotFound([](AsyncWebServerRequest *request)
                     {
@@ -128,26 +154,200 @@ void setupWebServer()
   logWithTimestamp("AsyncWebServer started on port 80");
 }
 
+// Connects and binary control messages on the live view socket
+void onLiveSocketEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type,
+                       void *arg, uint8_t *data, size_t len)
+{
+  switch (type)
+  {
+  case WS_EVT_CONNECT:
+    if (socket->count() > WEB_LIVE_VIEW_MAX_CLIENTS)
+    {
+      client->close();
+      return;
+    }
+    liveViewSetSubscribers(socket->count());
+    break;
+
+  case WS_EVT_DATA:
+  {
+    // Control messages are a few bytes - only whole, unfragmented binary frames are accepted
+    AwsFrameInfo *info = (AwsFrameInfo *)arg;
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_BINARY || len < 2)
+    {
+      return;
+    }
+    if (data[0] == LIVE_VIEW_CMD_BRIGHTNESS)
+    {
+      pendingBrightness = data[1];
+    }
+    else if (data[0] == LIVE_VIEW_CMD_MODE)
+    {
+      pendingMode = data[1];
+    }
+    else if (data[0] == LIVE_VIEW_CMD_COLOR && len >= 4)
+    {
+      memcpy(pendingColorRGB, data + 1, 3);
+      pendingColor = true;
+    }
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+// Fill the strip directly - used while no receiver or render task owns the LEDs.
+// FastLED runs at full brightness (the pixel kernel applies it), so scale here.
+static void showLiveColor(const CRGB &color)
+{
+  uint16_t scale = settings.brightness + 1;
+  CRGB scaled((color.r * scale) >> 8, (color.g * scale) >> 8, (color.b * scale) >> 8);
+  uint16_t count = min(settings.ledCount, ledBufferSize);
+  fill_solid(leds, count, scaled);
+  FastLED.show();
+  liveViewFrameShown((const uint8_t *)leds, count * 3);
+}
+
+// Default control handler - off, ArtNet or a static color
+static void applyLiveControl(uint8_t command, const uint8_t *data, size_t length)
+{
+  switch (command)
+  {
+  case LIVE_VIEW_CMD_BRIGHTNESS:
+    // ArtNet frames pick it up through the pixel kernel LUT on the next frame
+    settings.brightness = data[0];
+    if (liveMode == LIVE_VIEW_MODE_STATIC)
+    {
+      showLiveColor(liveColor);
+    }
+    break;
+
+  case LIVE_VIEW_CMD_COLOR:
+    liveColor = CRGB(data[0], data[1], data[2]);
+    if (liveMode == LIVE_VIEW_MODE_STATIC)
+    {
+      showLiveColor(liveColor);
+    }
+    break;
+
+  case LIVE_VIEW_CMD_MODE:
+    if (data[0] == LIVE_VIEW_MODE_ARTNET)
+    {
+      liveMode = setupArtNet() ? LIVE_VIEW_MODE_ARTNET : liveMode;
+    }
+    else if (data[0] == LIVE_VIEW_MODE_OFF || data[0] == LIVE_VIEW_MODE_STATIC)
+    {
+      stopArtNet();
+      liveMode = data[0];
+      showLiveColor(liveMode == LIVE_VIEW_MODE_STATIC ? liveColor : CRGB::Black);
+    }
+    break;
+  }
+}
+
+void webServerSetControlHandler(WebControlHandler handler)
+{
+  controlHandler = handler;
+}
+
+// Apply pending control messages and push the live view at its capped rate
+void webServerLoop()
+{
+  WebControlHandler handler = controlHandler != NULL ? controlHandler : applyLiveControl;
+
+  if (pendingMode >= 0)
+  {
+    uint8_t mode = pendingMode;
+    pendingMode = -1;
+    handler(LIVE_VIEW_CMD_MODE, &mode, 1);
+  }
+  if (pendingColor)
+  {
+    pendingColor = false;
+    handler(LIVE_VIEW_CMD_COLOR, pendingColorRGB, 3);
+  }
+  if (pendingBrightness >= 0)
+  {
+    uint8_t brightness = pendingBrightness;
+    pendingBrightness = -1;
+    handler(LIVE_VIEW_CMD_BRIGHTNESS, &brightness, 1);
+  }
+  if (handler == applyLiveControl)
+  {
+    liveViewSetStatus(liveMode, settings.brightness);
+  }
+
+  unsigned long now = millis();
+  if (now - lastLivePushMs < LIVE_VIEW_INTERVAL_MS)
+  {
+    return;
+  }
+  lastLivePushMs = now;
+  liveSocket.cleanupClients(WEB_LIVE_VIEW_MAX_CLIENTS);
+  // Disconnects are picked up here, captures stop once the last viewer is gone
+  liveViewSetSubscribers(liveSocket.count());
+
+  // Skip this push rather than queue behind a slow client
+  if (liveSocket.count() == 0 || !liveSocket.availableForWriteAll())
+  {
+    return;
+  }
+
+  uint16_t length = liveViewBuildMessage(liveMessage, sizeof(liveMessage));
+  if (length > 0)
+  {
+    liveSocket.binaryAll(liveMessage, length);
+  }
+}
+
+// Handler for the /stats endpoint
+void handleStats(AsyncWebServerRequest *request)
+{
+  request->send(200, "application/json", perfStatsJson());
+
+  if (request->hasParam("reset"))
+  {
+    perfReset();
+  }
+}
+
 // Handler for the /settings endpoint
 void handleSettings(AsyncWebServerRequest *request)
 {
-  AsyncResponseStream *response = request->beginResponseStream("application/json");
-  StaticJsonDocument<512> doc;
+  // Serialized once into a fixed buffer owned by the response, then copied
+  // straight into the TCP send buffer as the connection drains
+  JsonSnapshot snapshot;
+  StaticJsonDocument<WEB_SETTINGS_DOC_SIZE> doc;
 
   // Add basic settings
-  doc["ssid"] = settings.ssid;
+  doc["ssid"] = (const char *)settings.ssid;
   doc["useWiFi"] = settings.useWiFi;
-  doc["nodeName"] = settings.nodeName;
+  doc["nodeName"] = (const char *)settings.nodeName;
   doc["artnetUniverse"] = settings.artnetUniverse;
+  doc["artnetUniverseCount"] = settings.artnetUniverseCount;
   doc["ledCount"] = settings.ledCount;
   doc["ledPin"] = settings.ledPin;
   doc["brightness"] = settings.brightness;
+  doc["gamma"] = settings.gamma;
+  doc["maxFps"] = settings.maxFps;
+  doc["interpolateFrames"] = settings.interpolateFrames;
+  doc["fastBoot"] = settings.fastBoot;
   doc["artnetEnabled"] = settings.artnetEnabled;
+  doc["sacnEnabled"] = settings.sacnEnabled;
+
+  // Limits for the embedded UI form
+  doc["maxFpsLimit"] = FRAME_MAX_FPS_LIMIT;
+  doc["maxUniverses"] = FRAME_MAX_UNIVERSES;
 
   // Add runtime information
-  doc["ipAddress"] = WiFi.status() == WL_CONNECTED ? WiFi.localIP().toString() : "Not connected";
-  doc["wifiConnected"] = WiFi.status() == WL_CONNECTED;
-  doc["rssi"] = WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0;
+  bool connected = WiFi.status() == WL_CONNECTED;
+  char ipAddress[16];
+  snprintf(ipAddress, sizeof(ipAddress), "%s", connected ? WiFi.localIP().toString().c_str() : "Not connected");
+  doc["ipAddress"] = ipAddress;
+  doc["wifiConnected"] = connected;
+  doc["rssi"] = connected ? WiFi.RSSI() : 0;
   doc["uptime"] = millis() / 1000;
   doc["freeHeap"] = ESP.getFreeHeap();
 
@@ -156,241 +356,108 @@ void handleSettings(AsyncWebServerRequest *request)
   doc["artnetPacketCount"] = state.artnetPacketCount;
   doc["lastArtnetPacket"] = state.lastArtnetPacket;
 
-  serializeJson(doc, *response);
-  request->send(response);
+  snapshot.length = serializeJson(doc, snapshot.json, sizeof(snapshot.json));
+
+  request->send(request->beginResponse("application/json", snapshot.length,
+                                       [snapshot](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+                                       {
+                                         size_t count = min(maxLen, snapshot.length - index);
+                                         memcpy(buffer, snapshot.json + index, count);
+                                         return count;
+                                       }));
 }
 
-// Handler for the /logs endpoint
-void handleLog(AsyncWebServerRequest *request)
+// Escape one log line as a JSON string element, with a leading comma unless it is the first
+static uint16_t appendLogJsonLine(char *out, const char *line, bool first)
 {
-  AsyncResponseStream *response = request->beginResponseStream("application/json");
-  StaticJsonDocument<2048> doc;
-  JsonArray logs = doc.createNestedArray("logs");
+  uint16_t length = 0;
+  if (!first)
+  {
+    out[length++] = ',';
+  }
+  out[length++] = '"';
+  for (const char *c = line; *c != '\0'; c++)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      out[length++] = '\\';
+      out[length++] = *c;
+    }
+    else
+    {
+      out[length++] = (uint8_t)*c < 0x20 ? ' ' : *c; // Control characters are replaced, not escaped
+    }
+  }
+  out[length++] = '"';
+  return length;
+}
 
-  // Add logs from the circular buffer
-  for (int i = 0; i < MAX_LOG_ENTRIES; i++)
+// Produce the next piece of the /logs document into stream->pending, false once it is complete
+static bool nextLogJsonPiece(LogJsonStream &stream)
+{
+  stream.pendingPos = 0;
+  stream.pendingLen = 0;
+  if (!stream.opened)
   {
-    int idx = (state.logIndex + i) % MAX_LOG_ENTRIES;
-    if (state.logs[idx].length() > 0)
+    stream.opened = true;
+    stream.pendingLen = strlcpy(stream.pending, "{\"logs\":[", sizeof(stream.pending));
+    return true;
+  }
+
+  char line[LOG_RING_LINE_SIZE];
+  while (stream.next != stream.end)
+  {
+    if (logRingLine(stream.next++, line, sizeof(line)))
     {
-      logs.add(state.logs[idx]);
+      stream.pendingLen = appendLogJsonLine(stream.pending, line, stream.first);
+      stream.first = false;
+      return true;
     }
   }
 
-  serializeJson(doc, *response);
-  request->send(response);
+  if (!stream.closed)
+  {
+    stream.closed = true;
+    stream.pendingLen = strlcpy(stream.pending, "]}", sizeof(stream.pending));
+    return true;
+  }
+  return false;
 }
 
-// Generate embedded HTML for when SPIFFS is not available
-String generateEmbeddedHTML()
+// Handler for the /logs endpoint
+void handleLog(AsyncWebServerRequest *request)
 {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<title>ESP32 I2C Controller</title>";
-  html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-  html += "<style>";
-  // Embed minimal CSS here
-  html += "body { font-family: Arial, sans-serif; margin: 20px; background-color: #f5f5f5; }";
-  html += ".container { max-width: 800px; margin: 0 auto; background-color: white; padding: 20px; border-radius: 5px; box-shadow: 0 2px 10px rgba(0,0,0,0.1); }";
-  html += ".form-group { margin-bottom: 15px; }";
-  html += "label { display: inline-block; width: 150px; font-weight: bold; }";
-  html += "input[type='number'], input[type='text'], input[type='password'] { width: 200px; padding: 8px; border: 1px solid #ddd; border-radius: 4px; }";
-  html += "input[type='range'] { width: 200px; }";
-  html += "input[type='checkbox'] { margin-right: 5px; }";
-  html += "button { background: #4CAF50; color: white; padding: 10px 20px; border: none; border-radius: 4px; cursor: pointer; font-size: 16px; }";
-  html += "button:hover { background: #45a049; }";
-  html += ".card { background: white; border-radius: 4px; padding: 15px; margin-bottom: 15px; box-shadow: 0 1px 3px rgba(0,0,0,0.1); }";
-  html += ".card h3 { margin-top: 0; border-bottom: 1px solid #eee; padding-bottom: 10px; color: #333; }";
-  html += ".status { font-size: 14px; color: #666; }";
-  html += ".tabs { display: flex; margin-bottom: 20px; }";
-  html += ".tab { padding: 10px 20px; cursor: pointer; border: 1px solid #ddd; border-bottom: none; border-radius: 4px 4px 0 0; background: #f8f8f8; }";
-  html += ".tab.active { background: white; border-bottom: 2px solid white; margin-bottom: -1px; }";
-  html += ".tab-content { display: none; border: 1px solid #ddd; padding: 20px; background: white; }";
-  html += ".tab-content.active { display: block; }";
-  html += ".note { background: #fffde7; padding: 10px; border-left: 5px solid #ffd600; margin-bottom: 20px; }";
-  html += "</style>";
-  html += "</head><body>";
-  html += "<div class='container'>";
-  html += "<h2>ESP32 I2C Controller</h2>";
-
-  // Note about embedded interface
-  html += "<div class='note'>";
-  html += "<strong>Note:</strong> Using embedded HTML interface. For a full-featured interface, upload files to SPIFFS.";
-  html += "</div>";
-
-  // Tabs navigation
-  html += "<div class='tabs'>";
-  html += "<div class='tab active' onclick='showTab(\"config\")'>Configuration</div>";
-  html += "<div class='tab' onclick='showTab(\"status\")'>Status</div>";
-  html += "<div class='tab' onclick='showTab(\"logs\")'>Logs</div>";
-  html += "</div>";
-
-  // Configuration tab
-  html += "<div id='config' class='tab-content active'>";
-  html += "<form id='configForm' method='POST' action='/config'>";
-
-  // WiFi section
-  html += "<div class='card'>";
-  html += "<h3>WiFi Settings</h3>";
-  html += "<div class='form-group'><label>SSID:</label><input type='text' name='ssid' value='" + settings.ssid + "'></div>";
-  html += "<div class='form-group'><label>Password:</label><input type='password' name='password' value='" + settings.password + "'></div>";
-
-  // Fix string concatenation error
-  String wifiChecked = settings.useWiFi ? "checked" : "";
-  html += "<div class='form-group'><label>Enable WiFi:</label><input type='checkbox' name='useWiFi' " + wifiChecked + "></div>";
-
-  html += "<div class='form-group'><label>Node Name:</label><input type='text' name='nodeName' value='" + settings.nodeName + "'></div>";
-  html += "</div>";
-
-  // LED section
-  html += "<div class='card'>";
-  html += "<h3>LED Configuration</h3>";
-  html += "<div class='form-group'><label>LED Count:</label><input type='number' name='ledCount' value='" + String(settings.ledCount) + "'></div>";
-  html += "<div class='form-group'><label>LED Pin:</label><input type='number' name='ledPin' value='" + String(settings.ledPin) + "'></div>";
-  html += "<div class='form-group'><label>Brightness:</label><input type='range' min='0' max='255' name='brightness' value='" + String(settings.brightness) + "'></div>";
-  html += "</div>";
-
-  // ArtNet section
-  html += "<div class='card'>";
-  html += "<h3>ArtNet Settings</h3>";
-
-  // Fix string concatenation error
-  String artnetChecked = settings.artnetEnabled ? "checked" : "";
-  html += "<div class='form-group'><label>Enable ArtNet:</label><input type='checkbox' name='artnetEnabled' " + artnetChecked + "></div>";
-
-  html += "<div class='form-group'><label>Universe:</label><input type='number' name='artnetUniverse' value='" + String(settings.artnetUniverse) + "'></div>";
-  html += "</div>";
-
-  // Submit button
-  html += "<button type='submit'>Save Configuration</button>";
-  html += "</form>";
-  html += "</div>";
-
-  // Status tab
-  html += "<div id='status' class='tab-content'>";
-  html += "<div class='card'>";
-  html += "<h3>System Status</h3>";
-  html += "<div id='systemStatus'>Loading...</div>";
-  html += "</div>";
-  html += "<div class='card'>";
-  html += "<h3>Network Status</h3>";
-  html += "<div id='networkStatus'>Loading...</div>";
-  html += "</div>";
-  html += "<div class='card'>";
-  html += "<h3>ArtNet Status</h3>";
-  html += "<div id='artnetStatus'>Loading...</div>";
-  html += "</div>";
-  html += "<button onclick='refreshStatus()'>Refresh Status</button>";
-  html += "</div>";
-
-  // Logs tab
-  html += "<div id='logs' class='tab-content'>";
-  html += "<div class='card'>";
-  html += "<h3>System Logs</h3>";
-  html += "<div id='logEntries'>Loading logs...</div>";
-  html += "</div>";
-  html += "<button onclick='refreshLogs()'>Refresh Logs</button>";
-  html += "</div>";
-
-  // JavaScript for tab handling and status updates
-  html += "<script>";
-
-  // Tab switching function
-  html += "function showTab(tabName) {";
-  html += "  document.querySelectorAll('.tab-content').forEach(tab => tab.classList.remove('active'));";
-  html += "  document.querySelectorAll('.tab').forEach(tab => tab.classList.remove('active'));";
-  html += "  document.getElementById(tabName).classList.add('active');";
-  html += "  document.querySelector('.tab[onclick=\"showTab(\\'' + tabName + '\\')\"]').classList.add('active');";
-  html += "  if (tabName === 'status') refreshStatus();";
-  html += "  if (tabName === 'logs') refreshLogs();";
-  html += "}";
-
-  // Status refresh function
-  html += "function refreshStatus() {";
-  html += "  fetch('/settings')";
-  html += "    .then(response => response.json())";
-  html += "    .then(data => {";
-  html += "      let systemHtml = `";
-  html += "        <div class='status'>Uptime: ${formatUptime(data.uptime)}</div>";
-  html += "        <div class='status'>Free Memory: ${formatBytes(data.freeHeap)}</div>";
-  html += "      `;";
-  html += "      document.getElementById('systemStatus').innerHTML = systemHtml;";
-
-  html += "      let networkHtml = `";
-  html += "        <div class='status'>WiFi Status: ${data.wifiConnected ? 'Connected' : 'Disconnected'}</div>";
-  html += "        <div class='status'>IP Address: ${data.ipAddress}</div>";
-  html += "        <div class='status'>RSSI: ${data.wifiConnected ? data.rssi + ' dBm' : 'N/A'}</div>";
-  html += "      `;";
-  html += "      document.getElementById('networkStatus').innerHTML = networkHtml;";
-
-  html += "      let artnetHtml = `";
-  html += "        <div class='status'>ArtNet Status: ${data.artnetRunning ? 'Running' : 'Stopped'}</div>";
-  html += "        <div class='status'>Universe: ${data.artnetUniverse}</div>";
-  html += "        <div class='status'>Packets Received: ${data.artnetPacketCount}</div>";
-  html += "        <div class='status'>Last Packet: ${formatLastPacket(data.lastArtnetPacket)}</div>";
-  html += "      `;";
-  html += "      document.getElementById('artnetStatus').innerHTML = artnetHtml;";
-  html += "    })";
-  html += "    .catch(error => {";
-  html += "      console.error('Error fetching status:', error);";
-  html += "      document.getElementById('systemStatus').innerHTML = '<div class=\"status\">Error loading status</div>';";
-  html += "    });";
-  html += "}";
-
-  // Logs refresh function
-  html += "function refreshLogs() {";
-  html += "  fetch('/logs')";
-  html += "    .then(response => response.json())";
-  html += "    .then(data => {";
-  html += "      let logsHtml = '<div style=\"height: 300px; overflow-y: auto;\">';";
-  html += "      if (data.logs && data.logs.length > 0) {";
-  html += "        data.logs.forEach(log => {";
-  html += "          logsHtml += `<div class=\"status\">${log}</div>`;";
-  html += "        });";
-  html += "      } else {";
-  html += "        logsHtml += '<div class=\"status\">No logs available</div>';";
-  html += "      }";
-  html += "      logsHtml += '</div>';";
-  html += "      document.getElementById('logEntries').innerHTML = logsHtml;";
-  html += "    })";
-  html += "    .catch(error => {";
-  html += "      console.error('Error fetching logs:', error);";
-  html += "      document.getElementById('logEntries').innerHTML = '<div class=\"status\">Error loading logs</div>';";
-  html += "    });";
-  html += "}";
-
-  // Helper functions
-  html += "function formatUptime(seconds) {";
-  html += "  const hours = Math.floor(seconds / 3600);";
-  html += "  const minutes = Math.floor((seconds % 3600) / 60);";
-  html += "  const secs = seconds % 60;";
-  html += "  return `${hours}h ${minutes}m ${secs}s`;";
-  html += "}";
-
-  html += "function formatBytes(bytes) {";
-  html += "  if (bytes < 1024) return bytes + ' bytes';";
-  html += "  else if (bytes < 1048576) return (bytes / 1024).toFixed(2) + ' KB';";
-  html += "  else return (bytes / 1048576).toFixed(2) + ' MB';";
-  html += "}";
-
-  html += "function formatLastPacket(timestamp) {";
-  html += "  if (!timestamp) return 'Never';";
-  html += "  const now = new Date().getTime();";
-  html += "  const diff = Math.floor((now - timestamp) / 1000);";
-  html += "  if (diff < 60) return `${diff} seconds ago`;";
-  html += "  else if (diff < 3600) return `${Math.floor(diff/60)} minutes ago`;";
-  html += "  else return `${Math.floor(diff/3600)} hours ago`;";
-  html += "}";
-
-  // Initialize page
-  html += "document.addEventListener('DOMContentLoaded', function() {";
-  html += "  showTab('config');";
-  html += "});";
-
-  html += "</script>";
-  html += "</div>"; // Close container
-  html += "</body></html>";
-
-  return html;
+  // Chunked: each record of the log ring is formatted and escaped only when the
+  // TCP send buffer has room for it, so the response never exists in RAM as a whole
+  LogJsonStream stream;
+  stream.end = logRingHead();
+  stream.next = logRingOldest(MAX_LOG_ENTRIES);
+
+  request->send(request->beginChunkedResponse("application/json",
+                                              [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+                                              {
+                                                size_t written = 0;
+                                                while (written < maxLen)
+                                                {
+                                                  if (stream.pendingPos == stream.pendingLen && !nextLogJsonPiece(stream))
+                                                  {
+                                                    break;
+                                                  }
+                                                  size_t count = min(maxLen - written, (size_t)(stream.pendingLen - stream.pendingPos));
+                                                  memcpy(buffer + written, stream.pending + stream.pendingPos, count);
+                                                  stream.pendingPos += count;
+                                                  written += count;
+                                                }
+                                                return written;
+                                              }));
+}
+
+// Serve the gzip-compressed embedded UI straight from flash (see scripts/embed_web_ui.py)
+void handleEmbeddedUI(AsyncWebServerRequest *request)
+{
+  AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", EMBEDDED_UI_GZ, EMBEDDED_UI_GZ_LENGTH);
+  response->addHeader("Content-Encoding", "gzip");
+  request->send(response);
 }
 
 // Handle form submission
@@ -412,11 +479,15 @@ void handleConfigPost(AsyncWebServerRequest *request)
 
     if (paramName == "ssid")
     {
-      settings.ssid = paramValue;
+      strlcpy(settings.ssid, paramValue.c_str(), sizeof(settings.ssid));
     }
     else if (paramName == "password")
     {
-      settings.password = paramValue;
+      // The page never receives the stored password, so an empty field keeps it
+      if (paramValue.length() > 0)
+      {
+        strlcpy(settings.password, paramValue.c_str(), sizeof(settings.password));
+      }
     }
     else if (paramName == "useWiFi")
     {
@@ -424,7 +495,7 @@ void handleConfigPost(AsyncWebServerRequest *request)
     }
     else if (paramName == "nodeName")
     {
-      settings.nodeName = paramValue;
+      strlcpy(settings.nodeName, paramValue.c_str(), sizeof(settings.nodeName));
     }
     else if (paramName == "ledCount")
     {
@@ -438,20 +509,44 @@ void handleConfigPost(AsyncWebServerRequest *request)
     {
       settings.brightness = paramValue.toInt();
     }
+    else if (paramName == "gamma")
+    {
+      settings.gamma = constrain(paramValue.toFloat(), PIXEL_MIN_GAMMA, PIXEL_MAX_GAMMA);
+    }
+    else if (paramName == "maxFps")
+    {
+      settings.maxFps = constrain((int)paramValue.toInt(), 0, FRAME_MAX_FPS_LIMIT);
+      framePipelineSetMaxFps(settings.maxFps);
+    }
+    else if (paramName == "interpolateFrames")
+    {
+      settings.interpolateFrames = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+      framePipelineSetInterpolation(settings.interpolateFrames);
+    }
+    else if (paramName == "fastBoot")
+    {
+      settings.fastBoot = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
     else if (paramName == "artnetUniverse")
     {
       settings.artnetUniverse = paramValue.toInt();
     }
+    else if (paramName == "artnetUniverseCount")
+    {
+      settings.artnetUniverseCount = constrain((int)paramValue.toInt(), 1, FRAME_MAX_UNIVERSES);
+    }
     else if (paramName == "artnetEnabled")
     {
       settings.artnetEnabled = (paramValue == "on" || paramValue == "1" || paramValue == "true");
     }
+    else if (paramName == "sacnEnabled")
+    {
+      settings.sacnEnabled = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
   }
 
   // If network settings changed, mark for restart
-  preferences.begin("led-settings", false);
-  preferences.putBool("netRestart", true);
-  preferences.end();
+  settingsStoreSetFlag(SETTINGS_FLAG_NET_RESTART, true);
 
   // Save settings
   // Here you would typically call some function to save the settings to preferences
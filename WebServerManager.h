@@ -8,14 +8,61 @@
 #include <ArduinoJson.h>
 #include "ESP_GPT_I2C_Common.h"
 
+// Live view WebSocket - at most this many viewers, extra connections are closed
+#define WEB_LIVE_VIEW_PATH "/ws"
+#define WEB_LIVE_VIEW_MAX_CLIENTS 4
+
+// Applies a LIVE_VIEW_CMD_* control message, called from webServerLoop()
+typedef void (*WebControlHandler)(uint8_t command, const uint8_t *data, size_t length);
+
+extern AsyncWebSocket liveSocket;
+
+// Serialized /settings document; the response owns a copy of this much JSON
+#define WEB_SETTINGS_DOC_SIZE 640
+#define WEB_SETTINGS_JSON_SIZE 768
+
+struct JsonSnapshot
+{
+  size_t length = 0;
+  char json[WEB_SETTINGS_JSON_SIZE];
+};
+
+// Cursor of a chunked /logs response - one escaped line is buffered at a time
+struct LogJsonStream
+{
+  uint32_t next = 0;
+  uint32_t end = 0;
+  bool opened = false;
+  bool first = true;
+  bool closed = false;
+  uint16_t pendingPos = 0;
+  uint16_t pendingLen = 0;
+  char pending[LOG_RING_LINE_SIZE * 2 + 4]; // Worst case every character escaped, plus ,""
+};
+
+// Registers sketch-specific routes - called before the defaults are added, and the
+// first matching handler wins, so these replace e.g. "/" or "/config"
+typedef void (*WebRouteSetup)(AsyncWebServer &server);
+
 // Forward declarations
-void setupWebServer();
+// Requests are served by the AsyncTCP task; build with CONFIG_ASYNC_TCP_RUNNING_CORE=0
+// to keep it on the network core, away from rendering
+void setupWebServer(WebRouteSetup sketchRoutes = NULL);
+
+// Call from loop() - applies pending control messages and pushes the live view
+void webServerLoop();
+
+// Replace the default control handler (off / ArtNet / static color), NULL restores it
+void webServerSetControlHandler(WebControlHandler handler);
+void onLiveSocketEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type,
+                       void *arg, uint8_t *data, size_t len);
 void logWithTimestamp(const String& message);
 void handleSettings(AsyncWebServerRequest *request);
 void handleLog(AsyncWebServerRequest *request);
+void handleStats(AsyncWebServerRequest *request);
 void handleRootPage(AsyncWebServerRequest *request);
 bool serveStaticFiles();
-String generateEmbeddedHTML();
+void handleEmbeddedUI(AsyncWebServerRequest *request);
 void handleConfigPost(AsyncWebServerRequest *request);
 
 #endif // WEB_SERVER_MANAGER_H
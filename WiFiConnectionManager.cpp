@@ -66,7 +66,7 @@ void setupWiFiWithLogging()
   }
 
   logWithTimestamp("WiFi initialization starting");
-  logWithTimestamp("Connecting to SSID: " + settings.ssid);
+  logWithTimestamp("Connecting to SSID: " + String(settings.ssid));
 
   // Set WiFi mode first
   WiFi.mode(WIFI_STA);
@@ -78,15 +78,15 @@ void setupWiFiWithLogging()
   logWithTimestamp("Previous WiFi connections cleared");
 
   // Set hostname for easier identification on the network
-  WiFi.setHostname(settings.nodeName.c_str());
-  logWithTimestamp("Hostname set to: " + settings.nodeName);
+  WiFi.setHostname(settings.nodeName);
+  logWithTimestamp("Hostname set to: " + String(settings.nodeName));
 
   // Log MAC address
   wifiStatus.macAddress = WiFi.macAddress();
   logWithTimestamp("MAC Address: " + wifiStatus.macAddress);
 
   // Start WiFi connection
-  WiFi.begin(settings.ssid.c_str(), settings.password.c_str());
+  WiFi.begin(settings.ssid, settings.password);
   logWithTimestamp("WiFi connection attempt initiated");
 
   // Wait for connection with detailed logging
@@ -216,7 +216,7 @@ void reconnectIfNeeded()
     delay(100);
 
     // Begin connection
-    WiFi.begin(settings.ssid.c_str(), settings.password.c_str());
+    WiFi.begin(settings.ssid, settings.password);
 
     // Wait briefly for connection
     int shortAttempts = 0;
@@ -3,6 +3,7 @@
 # provides status visualization using the CircuitPlayground's LEDs
 
 import time
+import struct
 import board
 import busio
 import digitalio
@@ -12,6 +13,16 @@ from adafruit_circuitplayground import cp
 I2C_ADDR = 0x08  # Default ESP32 I2C address in esp-gpt-i2c project
 I2C_FREQ = 100000  # 100kHz for stability
 
+# ESP register map (I2CSlave.h) - write the register address, then read from it
+REG_VERSION = 0x00
+REG_COUNTERS = 0x08
+REG_PREVIEW = 0x28
+REGISTER_MAP_SIZE = 0x40
+PRELOAD_DELAY = 0.002  # I2C_SLAVE_PRELOAD_MS - the ESP reloads its TX buffer after a register write
+STATUS_FORMAT = "<BBBBBBHIIIIIIIHBB"  # version .. reserved, preview follows
+FLAG_NAMES = ((0x01, "wifi"), (0x02, "artnet"), (0x04, "serial"), (0x08, "benchmark"), (0x80, "error"))
+MODE_NAMES = ("off", "artnet", "static", "cycle")
+
 # Status LED configuration
 NUM_PIXELS = 10  # CPX has 10 NeoPixels
 LED_BRIGHTNESS = 0.2  # Lower brightness to save power
@@ -68,6 +79,45 @@ def receive_data(timeout=1.0):
         set_pixel_status(COLOR_ERROR)
         return None
 
+def read_registers(register, length):
+    """Read length bytes starting at a register of the ESP register map"""
+    # The ESP cannot drop unread bytes - always take the block to the end of the map
+    result = bytearray(REGISTER_MAP_SIZE - register)
+    try:
+        while not i2c.try_lock():
+            pass
+        # Separate transactions - the ESP cannot serve a repeated-start read
+        i2c.writeto(I2C_ADDR, bytes([register]))
+        time.sleep(PRELOAD_DELAY)
+        i2c.readfrom_into(I2C_ADDR, result)
+        return result[:length]
+    except Exception as e:
+        print(f"Register read error: {e}")
+        set_pixel_status(COLOR_ERROR)
+        return None
+    finally:
+        i2c.unlock()
+
+def read_status():
+    """Read and decode the whole register block"""
+    data = read_registers(REG_VERSION, REGISTER_MAP_SIZE)
+    if data is None:
+        return None
+    fields = struct.unpack_from(STATUS_FORMAT, data)
+    status = {
+        "version": fields[0], "sequence": fields[1],
+        "flags": [name for bit, name in FLAG_NAMES if fields[2] & bit],
+        "mode": MODE_NAMES[fields[3]] if fields[3] < len(MODE_NAMES) else fields[3],
+        "brightness": fields[4], "error": fields[5], "fps": fields[6] / 10,
+        "packets": fields[7], "frames": fields[8], "dropped": fields[9],
+        "malformed": fields[10], "out_of_universe": fields[11],
+        "free_heap": fields[12], "uptime": fields[13],
+        "preview_offset": fields[14], "preview_count": fields[15],
+    }
+    preview = data[REG_PREVIEW:REG_PREVIEW + fields[15] * 3]
+    status["preview"] = [tuple(preview[i:i + 3]) for i in range(0, len(preview), 3)]
+    return status
+
 # Define LED status functions
 def set_pixel_status(color):
     """Set all pixels to a specific color to indicate status"""
@@ -159,14 +209,15 @@ def main():
                 devices = scan_i2c_devices()
                 time.sleep(0.5)  # Debounce
             
-            # Button B: Request status from ESP
+            # Button B: Read the status registers from the ESP
             if button_b.value:
                 print("Requesting status from ESP...")
-                if send_command("STATUS"):
-                    time.sleep(0.1)  # Give ESP time to respond
-                    response = receive_data()
-                    if response:
-                        print(f"ESP Status: {response}")
+                status = read_status()
+                if status:
+                    print(f"ESP Status: {status}")
+                    # Mirror the ESP's preview window on the CPX pixels
+                    for i, color in enumerate(status["preview"][:NUM_PIXELS]):
+                        cp.pixels[i] = color
                 time.sleep(0.5)  # Debounce
             
             # Regular status polling (every 5 seconds)
@@ -195,11 +246,10 @@ def main():
             if abs(x) > 9 or abs(y) > 9 or abs(z) > 11:
                 # Device was shaken - run diagnostic
                 print("Running diagnostic...")
-                send_command("DIAG")
-                time.sleep(0.1)
-                response = receive_data()
-                if response:
-                    print(f"Diagnostic: {response}")
+                counters = read_registers(REG_COUNTERS, 7 * 4)
+                if counters:
+                    names = ("packets", "frames", "dropped", "malformed", "out_of_universe", "free_heap", "uptime")
+                    print(f"Diagnostic: {dict(zip(names, struct.unpack('<7I', counters)))}")
             
             time.sleep(0.1)  # Small delay to prevent CPU hogging
             
@@ -0,0 +1,243 @@
+#include "ArtNetBenchmark.h"
+#include "ESP_GPT_I2C_Common.h"
+
+#define ARTDMX_HEADER_SIZE 18
+#define ARTSYNC_SIZE 14
+
+static BenchmarkConfig activeConfig;
+static BenchmarkResult lastResult;
+static volatile bool benchmarkActive = false;
+static volatile bool stopRequested = false;
+static volatile bool resultPending = false;
+static TaskHandle_t benchmarkTaskHandle = NULL;
+
+// Shared "Art-Net" + null + OpCode layout of both packet types
+static void writeArtNetHeader(uint8_t *packet, uint8_t opHigh)
+{
+  memcpy(packet, "Art-Net", 8);
+  packet[8] = 0x00;
+  packet[9] = opHigh;
+  packet[10] = 0;  // Protocol version high byte
+  packet[11] = 14; // Protocol version low byte
+}
+
+static void benchmarkTask(void *parameter)
+{
+  static uint8_t packet[ARTDMX_HEADER_SIZE + 512];
+  uint8_t syncPacket[ARTSYNC_SIZE] = {0};
+  uint16_t pixelsPerUniverse = (activeConfig.pixels + activeConfig.universes - 1) / activeConfig.universes;
+  uint32_t periodUs = 1000000UL / activeConfig.fps;
+  uint32_t durationMs = (uint32_t)activeConfig.seconds * 1000;
+
+  writeArtNetHeader(packet, 0x50);
+  writeArtNetHeader(syncPacket, 0x52);
+
+  BenchmarkResult result;
+  result.config = activeConfig;
+  FramePipelineStats before;
+  framePipelineGetStats(&before);
+  uint32_t startHeap = ESP.getFreeHeap();
+  result.minFreeHeap = startHeap;
+
+  unsigned long startTime = millis();
+  uint32_t nextFrameUs = micros();
+  uint8_t sequence = 0;
+
+  while (!stopRequested && millis() - startTime < durationMs)
+  {
+    // One frame: every universe once, with a moving pattern so each frame differs
+    uint16_t remaining = activeConfig.pixels;
+    for (uint8_t u = 0; u < activeConfig.universes && remaining > 0; u++)
+    {
+      uint16_t pixels = min(remaining, pixelsPerUniverse);
+      uint16_t channels = pixels * FRAME_CHANNELS_PER_PIXEL;
+      uint16_t universe = settings.artnetUniverse + u;
+      remaining -= pixels;
+
+      sequence = sequence == 255 ? 1 : sequence + 1; // 0 would mean "not sequenced"
+      packet[12] = sequence;
+      packet[13] = 0;
+      packet[14] = universe & 0xFF;
+      packet[15] = universe >> 8;
+      packet[16] = channels >> 8;
+      packet[17] = channels & 0xFF;
+      for (uint16_t c = 0; c < channels; c++)
+      {
+        packet[ARTDMX_HEADER_SIZE + c] = (uint8_t)(result.framesSent + c);
+      }
+
+      processArtNetData(packet, ARTDMX_HEADER_SIZE + channels);
+      result.packetsSent++;
+    }
+
+    if (activeConfig.sync)
+    {
+      processArtNetData(syncPacket, ARTSYNC_SIZE);
+      result.packetsSent++;
+    }
+    result.framesSent++;
+    result.minFreeHeap = min(result.minFreeHeap, (uint32_t)ESP.getFreeHeap());
+
+    // Fixed cadence; if generation overran a frame, carry on without trying to catch up
+    nextFrameUs += periodUs;
+    int32_t waitUs = (int32_t)(nextFrameUs - micros());
+    if (waitUs > 0)
+    {
+      vTaskDelay(pdMS_TO_TICKS((waitUs + 999) / 1000));
+    }
+    else
+    {
+      nextFrameUs = micros();
+      taskYIELD();
+    }
+  }
+
+  // Let the last frame reach the output before reading the counters
+  delay(50);
+  result.elapsedMs = millis() - startTime;
+
+  FramePipelineStats after;
+  framePipelineGetStats(&after);
+  result.framesRendered = after.framesRendered - before.framesRendered;
+  result.framesDropped = after.framesCoalesced - before.framesCoalesced;
+  result.achievedFps = result.elapsedMs ? result.framesRendered * 1000.0f / result.elapsedMs : 0;
+  for (int i = 0; i < PERF_STAGE_COUNT; i++)
+  {
+    perfGetSummary((PerfStage)i, &result.stages[i]);
+  }
+  result.heapDelta = (int32_t)ESP.getFreeHeap() - (int32_t)startHeap;
+
+  framePipelineEnd();
+
+  lastResult = result;
+  resultPending = true;
+
+  debugLog("Benchmark: " + String(result.framesRendered) + " frames in " + String(result.elapsedMs) + " ms = " +
+           String(result.achievedFps, 1) + " fps (target " + String(activeConfig.fps) + "), dropped " +
+           String(result.framesDropped) + ", heap delta " + String(result.heapDelta));
+  for (int i = 0; i < PERF_STAGE_COUNT; i++)
+  {
+    debugLog("Benchmark " + String(perfStageName((PerfStage)i)) + ": avg " + String(result.stages[i].avgUs, 1) +
+             " us, p99 " + String(result.stages[i].p99Us, 1) + " us, max " + String(result.stages[i].maxUs, 1) + " us");
+  }
+
+  // The handle goes before the run is published as over, so a benchmarkStart()
+  // that follows can never have its new handle cleared by this task
+  benchmarkTaskHandle = NULL;
+  benchmarkActive = false;
+  vTaskDelete(NULL);
+}
+
+bool benchmarkStart(const BenchmarkConfig &config, FrameOutputCallback output)
+{
+  if (benchmarkActive)
+  {
+    debugLog("Benchmark already running");
+    return false;
+  }
+
+  // Enough universes to carry the pixels, never more than the frame can map
+  BenchmarkConfig checked = config;
+  checked.pixels = constrain(checked.pixels, 1, MAX_LEDS);
+  uint8_t minUniverses = (checked.pixels + FRAME_PIXELS_PER_UNIVERSE - 1) / FRAME_PIXELS_PER_UNIVERSE;
+  checked.universes = constrain(checked.universes, minUniverses, FRAME_MAX_UNIVERSES);
+  checked.fps = constrain(checked.fps, 1, 1000);
+  checked.seconds = constrain(checked.seconds, 1, BENCHMARK_MAX_SECONDS);
+  uint16_t pixelsPerUniverse = (checked.pixels + checked.universes - 1) / checked.universes;
+
+  if (!framePipelineMapUniverses(settings.artnetUniverse, checked.universes, pixelsPerUniverse))
+  {
+    return false;
+  }
+  framePipelineSetMaxFps(settings.maxFps);
+  if (!framePipelineBegin(checked.pixels, output ? output : updateLEDs))
+  {
+    return false;
+  }
+
+  perfReset();
+  activeConfig = checked;
+  stopRequested = false;
+  resultPending = false;
+  benchmarkActive = true;
+
+  BaseType_t created = xTaskCreatePinnedToCore(
+      benchmarkTask,             // Task function
+      "BenchmarkTask",           // Task name
+      BENCHMARK_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                      // Task parameter
+      BENCHMARK_TASK_PRIORITY,   // Task priority
+      &benchmarkTaskHandle,      // Task handle
+      NETWORK_CORE               // Core to run the task on
+  );
+
+  if (created != pdPASS)
+  {
+    debugLog("ERROR: Failed to create benchmark task");
+    benchmarkActive = false;
+    framePipelineEnd();
+    return false;
+  }
+
+  debugLog("Benchmark started: " + String(checked.fps) + " fps, " + String(checked.universes) + " universes, " +
+           String(checked.pixels) + " pixels, " + String(checked.seconds) + " s" + (checked.sync ? ", ArtSync" : ""));
+  return true;
+}
+
+void benchmarkStop()
+{
+  stopRequested = true;
+  while (benchmarkActive)
+  {
+    delay(1);
+  }
+}
+
+bool benchmarkRunning()
+{
+  return benchmarkActive;
+}
+
+bool benchmarkTakeResult(BenchmarkResult *result)
+{
+  if (!resultPending)
+  {
+    return false;
+  }
+  resultPending = false;
+  *result = lastResult;
+  return true;
+}
+
+void benchmarkGetResult(BenchmarkResult *result)
+{
+  *result = lastResult;
+}
+
+String benchmarkResultJson()
+{
+  BenchmarkResult result = lastResult;
+
+  String json = "{\"running\":" + String(benchmarkActive ? "true" : "false");
+  json += ",\"config\":{\"fps\":" + String(result.config.fps);
+  json += ",\"universes\":" + String(result.config.universes);
+  json += ",\"pixels\":" + String(result.config.pixels);
+  json += ",\"seconds\":" + String(result.config.seconds);
+  json += ",\"sync\":" + String(result.config.sync ? "true" : "false") + "}";
+  json += ",\"elapsedMs\":" + String(result.elapsedMs);
+  json += ",\"packetsSent\":" + String(result.packetsSent);
+  json += ",\"framesSent\":" + String(result.framesSent);
+  json += ",\"framesRendered\":" + String(result.framesRendered);
+  json += ",\"framesDropped\":" + String(result.framesDropped);
+  json += ",\"achievedFps\":" + String(result.achievedFps, 2);
+  json += ",\"stages\":{";
+  for (int i = 0; i < PERF_STAGE_COUNT; i++)
+  {
+    if (i > 0)
+      json += ",";
+    json += "\"" + String(perfStageName((PerfStage)i)) + "\":" + perfStageJson(result.stages[i]);
+  }
+  json += "},\"heapDelta\":" + String(result.heapDelta);
+  json += ",\"minFreeHeap\":" + String(result.minFreeHeap) + "}";
+  return json;
+}
@@ -0,0 +1,53 @@
+#ifndef ARTNET_BENCHMARK_H
+#define ARTNET_BENCHMARK_H
+
+#include <Arduino.h>
+#include "FramePipeline.h"
+#include "PerfCounters.h"
+
+// Generator task placement - alongside the network stack that normally feeds the receiver
+#ifndef NETWORK_CORE
+#define NETWORK_CORE 0
+#endif
+#define BENCHMARK_TASK_PRIORITY 3
+#define BENCHMARK_TASK_STACK_SIZE 4096
+#define BENCHMARK_MAX_SECONDS 300
+
+// Synthetic load: fps frames per second, each split over universes ArtDmx packets
+struct BenchmarkConfig
+{
+  uint16_t fps = 40;
+  uint8_t universes = 1;
+  uint16_t pixels = FRAME_PIXELS_PER_UNIVERSE;
+  uint16_t seconds = 10;
+  bool sync = false; // Follow every frame with an ArtSync
+};
+
+struct BenchmarkResult
+{
+  BenchmarkConfig config;
+  uint32_t elapsedMs = 0;
+  uint32_t packetsSent = 0;
+  uint32_t framesSent = 0;
+  uint32_t framesRendered = 0;
+  uint32_t framesDropped = 0;
+  float achievedFps = 0;
+  PerfStageSummary stages[PERF_STAGE_COUNT];
+  int32_t heapDelta = 0;  // Free heap at the end minus at the start
+  uint32_t minFreeHeap = 0; // Lowest free heap seen while running
+};
+
+// Start the frame pipeline on the configured universe range and replay
+// synthetic ArtDmx packets through processArtNetData() from a generator task.
+// The caller must have stopped the normal receiver; the pipeline is torn down when done.
+// A NULL output renders through updateLEDs().
+bool benchmarkStart(const BenchmarkConfig &config, FrameOutputCallback output);
+void benchmarkStop();
+bool benchmarkRunning();
+
+// True once per finished run, for reporting from the main loop
+bool benchmarkTakeResult(BenchmarkResult *result);
+void benchmarkGetResult(BenchmarkResult *result);
+String benchmarkResultJson();
+
+#endif // ARTNET_BENCHMARK_H
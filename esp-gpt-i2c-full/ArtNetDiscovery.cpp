@@ -0,0 +1,212 @@
+#include "ArtNetDiscovery.h"
+#include "ESP_GPT_I2C_Common.h"
+
+// ArtPollReply field offsets (Art-Net 4)
+#define REPLY_IP 10
+#define REPLY_PORT 14
+#define REPLY_VERSION 16
+#define REPLY_NET_SWITCH 18
+#define REPLY_SUB_SWITCH 19
+#define REPLY_OEM 20
+#define REPLY_STATUS1 23
+#define REPLY_SHORT_NAME 26
+#define REPLY_SHORT_NAME_SIZE 18
+#define REPLY_LONG_NAME 44
+#define REPLY_LONG_NAME_SIZE 64
+#define REPLY_NODE_REPORT 108
+#define REPLY_NODE_REPORT_SIZE 64
+#define REPLY_NUM_PORTS 172
+#define REPLY_PORT_TYPES 174
+#define REPLY_GOOD_OUTPUT_A 182
+#define REPLY_SW_OUT 190
+#define REPLY_MAC 201
+#define REPLY_BIND_IP 207
+#define REPLY_BIND_INDEX 211
+#define REPLY_STATUS2 212
+
+#define PORT_TYPE_DMX_OUTPUT 0x80
+#define GOOD_OUTPUT_TRANSMITTING 0x80
+#define STATUS1_INDICATORS_NORMAL 0xC0
+#define STATUS1_ADDRESS_BY_NETWORK 0x20
+#define STATUS2_15BIT_ADDRESS 0x08
+#define STATUS2_DHCP 0x06 // DHCP capable and in use
+
+// What the replies were built from - compared on every service pass
+struct NodeIdentity
+{
+  uint32_t ip;
+  uint32_t broadcast;
+  uint8_t mac[6];
+  uint16_t firstUniverse;
+  uint8_t universeCount;
+  uint32_t nameHash;
+};
+
+// Owned by the housekeeping task, which builds and sends them
+static uint8_t replies[ARTNET_POLL_MAX_REPLIES][ARTNET_POLL_REPLY_SIZE];
+static uint8_t replyCount = 0;
+static NodeIdentity builtIdentity;
+static bool identityValid = false;
+
+// Set by the parser in the network task
+static volatile bool pollPending = false;
+static volatile bool replyOnChange = false;
+
+static ArtNetDiscoveryStats stats;
+
+void artnetDiscoveryPoll(const uint8_t *data, size_t len)
+{
+  stats.polls++;
+  if (len >= 13 && (data[12] & ARTNET_TALK_TO_ME_REPLY_ON_CHANGE))
+  {
+    replyOnChange = true;
+  }
+  pollPending = true;
+}
+
+static bool currentIdentity(NodeIdentity *identity)
+{
+  if (WiFi.status() != WL_CONNECTED)
+  {
+    return false;
+  }
+
+  memset(identity, 0, sizeof(*identity));
+  identity->ip = (uint32_t)WiFi.localIP();
+  identity->broadcast = (uint32_t)WiFi.broadcastIP();
+  WiFi.macAddress(identity->mac);
+  identity->firstUniverse = settings.artnetUniverse;
+  identity->universeCount = min(settings.artnetUniverseCount, (uint8_t)FRAME_MAX_UNIVERSES);
+  identity->nameHash = pixelHash((const uint8_t *)settings.nodeName, strlen(settings.nodeName));
+  return true;
+}
+
+// Fields shared by every reply of the node
+static void buildReplyHeader(uint8_t *reply, const NodeIdentity &identity)
+{
+  memset(reply, 0, ARTNET_POLL_REPLY_SIZE);
+  memcpy(reply, "Art-Net", 8);
+  reply[8] = ARTNET_OP_POLL_REPLY & 0xFF;
+  reply[9] = ARTNET_OP_POLL_REPLY >> 8;
+  memcpy(reply + REPLY_IP, &identity.ip, 4);
+  reply[REPLY_PORT] = ARTNET_PORT & 0xFF;
+  reply[REPLY_PORT + 1] = ARTNET_PORT >> 8;
+  reply[REPLY_VERSION] = ARTNET_FIRMWARE_VERSION >> 8;
+  reply[REPLY_VERSION + 1] = ARTNET_FIRMWARE_VERSION & 0xFF;
+  reply[REPLY_OEM] = ARTNET_OEM_CODE >> 8;
+  reply[REPLY_OEM + 1] = ARTNET_OEM_CODE & 0xFF;
+  reply[REPLY_STATUS1] = STATUS1_INDICATORS_NORMAL | STATUS1_ADDRESS_BY_NETWORK;
+
+  strlcpy((char *)reply + REPLY_SHORT_NAME, settings.nodeName, REPLY_SHORT_NAME_SIZE);
+  snprintf((char *)reply + REPLY_LONG_NAME, REPLY_LONG_NAME_SIZE, "%s - ESP32 ArtNet LED", settings.nodeName);
+  snprintf((char *)reply + REPLY_NODE_REPORT, REPLY_NODE_REPORT_SIZE, "#0001 [0000] %u universes from %u",
+           identity.universeCount, identity.firstUniverse);
+
+  memcpy(reply + REPLY_MAC, identity.mac, 6);
+  memcpy(reply + REPLY_BIND_IP, &identity.ip, 4);
+  reply[REPLY_STATUS2] = STATUS2_15BIT_ADDRESS | STATUS2_DHCP;
+}
+
+// One reply per run of up to four universes with the same Net and Sub-Net,
+// numbered through BindIndex
+static void buildReplies(const NodeIdentity &identity)
+{
+  replyCount = 0;
+  uint8_t *reply = NULL;
+  uint8_t ports = 0;
+
+  for (uint8_t i = 0; i < identity.universeCount; i++)
+  {
+    uint16_t universe = (identity.firstUniverse + i) & 0x7FFF;
+    if (reply == NULL || ports == ARTNET_POLL_REPLY_PORTS || (universe & 0x0F) == 0)
+    {
+      if (replyCount == ARTNET_POLL_MAX_REPLIES)
+      {
+        break;
+      }
+      reply = replies[replyCount++];
+      ports = 0;
+      buildReplyHeader(reply, identity);
+      reply[REPLY_NET_SWITCH] = (universe >> 8) & 0x7F;
+      reply[REPLY_SUB_SWITCH] = (universe >> 4) & 0x0F;
+      reply[REPLY_BIND_INDEX] = replyCount;
+    }
+
+    reply[REPLY_PORT_TYPES + ports] = PORT_TYPE_DMX_OUTPUT;
+    reply[REPLY_GOOD_OUTPUT_A + ports] = GOOD_OUTPUT_TRANSMITTING;
+    reply[REPLY_SW_OUT + ports] = universe & 0x0F;
+    ports++;
+    reply[REPLY_NUM_PORTS + 1] = ports;
+  }
+
+  memcpy(&builtIdentity, &identity, sizeof(builtIdentity));
+  identityValid = true;
+  stats.rebuilds++;
+  stats.replyCount = replyCount;
+}
+
+static bool sendReply(const uint8_t *reply, uint32_t broadcast)
+{
+#if ARTNET_RAW_RECEIVER
+  if (artnetReceiverRunning())
+  {
+    return artnetReceiverSendTo(reply, ARTNET_POLL_REPLY_SIZE, broadcast, ARTNET_PORT);
+  }
+#endif
+  return artnetUdp.writeTo(reply, ARTNET_POLL_REPLY_SIZE, IPAddress(broadcast), ARTNET_PORT) == ARTNET_POLL_REPLY_SIZE;
+}
+
+void artnetDiscoveryService()
+{
+  NodeIdentity identity;
+  if (!state.artnetRunning || !currentIdentity(&identity))
+  {
+    return;
+  }
+
+  bool changed = !identityValid || memcmp(&identity, &builtIdentity, sizeof(identity)) != 0;
+  if (changed)
+  {
+    buildReplies(identity);
+  }
+
+  // Polls arriving meanwhile coalesce into one set of replies
+  if (!pollPending && !(changed && replyOnChange))
+  {
+    return;
+  }
+  pollPending = false;
+
+  // lwIP allocates the outgoing pbufs - discovery is outside the static memory budget
+  heapMonitorSetPath(HEAP_PATH_NONE);
+  for (uint8_t i = 0; i < replyCount; i++)
+  {
+    if (sendReply(replies[i], identity.broadcast))
+    {
+      stats.replies++;
+    }
+    else
+    {
+      stats.sendErrors++;
+    }
+  }
+  heapMonitorSetPath(HEAP_PATH_STATUS);
+}
+
+void artnetDiscoveryGetStats(ArtNetDiscoveryStats *copy)
+{
+  *copy = stats;
+}
+
+String artnetDiscoveryStatsJson()
+{
+  ArtNetDiscoveryStats copy;
+  artnetDiscoveryGetStats(&copy);
+
+  String json = "{\"polls\":" + String(copy.polls);
+  json += ",\"replies\":" + String(copy.replies);
+  json += ",\"sendErrors\":" + String(copy.sendErrors);
+  json += ",\"rebuilds\":" + String(copy.rebuilds);
+  json += ",\"replyCount\":" + String(copy.replyCount) + "}";
+  return json;
+}
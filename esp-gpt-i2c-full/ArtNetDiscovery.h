@@ -0,0 +1,47 @@
+#ifndef ARTNET_DISCOVERY_H
+#define ARTNET_DISCOVERY_H
+
+#include <Arduino.h>
+#include "FramePipeline.h"
+
+// ArtPoll / ArtPollReply node discovery. The parser only notes that a poll
+// arrived; the replies are prebuilt - one per group of up to four universes
+// sharing Net/Sub-Net - rebuilt only when the IP, MAC, node name or universe
+// range change, and broadcast by the housekeeping task.
+
+#define ARTNET_OP_POLL 0x2000
+#define ARTNET_OP_POLL_REPLY 0x2100
+#define ARTNET_POLL_REPLY_SIZE 239
+#define ARTNET_POLL_REPLY_PORTS 4
+#define ARTNET_FIRMWARE_VERSION 1
+#define ARTNET_OEM_CODE 0x00FF // OemUnknown
+
+// Universes of a contiguous range start a new reply every four ports and at
+// every Sub-Net boundary
+#define ARTNET_POLL_MAX_REPLIES ((FRAME_MAX_UNIVERSES + ARTNET_POLL_REPLY_PORTS - 1) / ARTNET_POLL_REPLY_PORTS + FRAME_MAX_UNIVERSES / 16 + 1)
+
+// ArtPoll TalkToMe: the controller wants replies whenever the node changes
+#define ARTNET_TALK_TO_ME_REPLY_ON_CHANGE 0x02
+
+struct ArtNetDiscoveryStats
+{
+  uint32_t polls;        // ArtPoll packets received
+  uint32_t replies;      // ArtPollReply packets sent
+  uint32_t sendErrors;
+  uint32_t rebuilds;     // Times the reply set was rebuilt
+  uint8_t replyCount;    // Replies per poll
+};
+
+// Parser hook for OpPoll - flags the reply and returns, never blocks
+void artnetDiscoveryPoll(const uint8_t *data, size_t len);
+
+// Housekeeping: rebuild the replies if the identity changed, then send them
+// if a poll is pending (or the node changed and a controller asked for that)
+void artnetDiscoveryService();
+
+void artnetDiscoveryGetStats(ArtNetDiscoveryStats *stats);
+
+// {"polls":..,"replies":..,"sendErrors":..,"rebuilds":..,"replyCount":..}
+String artnetDiscoveryStatsJson();
+
+#endif // ARTNET_DISCOVERY_H
@@ -0,0 +1,176 @@
+#include "ArtNetReceiver.h"
+#include "HeapMonitor.h"
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include "lwip/priv/tcpip_priv.h"
+
+// Only touched from the lwIP thread once bound
+static struct udp_pcb *receiverPcb = NULL;
+static ArtNetDatagramHandler receiverHandler = NULL;
+static uint8_t chainScratch[ARTNET_MAX_PACKET_SIZE];
+static volatile uint32_t chainedCount = 0;
+
+// pcb operations must run in the lwIP thread, marshalled the same way AsyncUDP does it
+struct ReceiverCall
+{
+  struct tcpip_api_call_data call;
+  uint16_t port;
+  err_t err;
+};
+
+// Runs in the lwIP thread: parse directly out of the pbuf, then release it
+static void receiverRecv(void *arg, struct udp_pcb *pcb, struct pbuf *p, const ip_addr_t *addr, u16_t port)
+{
+  if (p == NULL)
+  {
+    return;
+  }
+
+  ArtNetDatagramHandler handler = receiverHandler;
+  if (handler != NULL)
+  {
+    // The lwIP thread serves the web server as well - only the parse is on the packet path
+    heapMonitorSetPath(HEAP_PATH_PACKET);
+    if (p->len == p->tot_len)
+    {
+      // Common case - the whole datagram sits in one contiguous pbuf
+      handler((const uint8_t *)p->payload, p->len);
+    }
+    else
+    {
+      // Chained pbuf - flatten once into the scratch buffer
+      uint16_t copied = pbuf_copy_partial(p, chainScratch, sizeof(chainScratch), 0);
+      chainedCount++;
+      handler(chainScratch, copied);
+    }
+    heapMonitorSetPath(HEAP_PATH_NONE);
+  }
+
+  pbuf_free(p);
+}
+
+static err_t receiverBind(struct tcpip_api_call_data *data)
+{
+  ReceiverCall *call = (ReceiverCall *)data;
+
+  receiverPcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+  if (receiverPcb == NULL)
+  {
+    call->err = ERR_MEM;
+    return call->err;
+  }
+
+  call->err = udp_bind(receiverPcb, IP_ANY_TYPE, call->port);
+  if (call->err != ERR_OK)
+  {
+    udp_remove(receiverPcb);
+    receiverPcb = NULL;
+    return call->err;
+  }
+
+  // Accept broadcast ArtNet as well as unicast
+  ip_set_option(receiverPcb, SOF_BROADCAST);
+  udp_recv(receiverPcb, receiverRecv, NULL);
+  return call->err;
+}
+
+struct ReceiverSend
+{
+  struct tcpip_api_call_data call;
+  const uint8_t *data;
+  uint16_t length;
+  uint32_t address;
+  uint16_t port;
+  err_t err;
+};
+
+static err_t receiverSend(struct tcpip_api_call_data *data)
+{
+  ReceiverSend *send = (ReceiverSend *)data;
+
+  if (receiverPcb == NULL)
+  {
+    send->err = ERR_MEM;
+    return send->err;
+  }
+
+  struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, send->length, PBUF_RAM);
+  if (p == NULL)
+  {
+    send->err = ERR_MEM;
+    return send->err;
+  }
+  memcpy(p->payload, send->data, send->length);
+
+  ip_addr_t to;
+  const uint8_t *octets = (const uint8_t *)&send->address;
+  IP_ADDR4(&to, octets[0], octets[1], octets[2], octets[3]);
+  send->err = udp_sendto(receiverPcb, p, &to, send->port);
+  pbuf_free(p);
+  return send->err;
+}
+
+static err_t receiverUnbind(struct tcpip_api_call_data *data)
+{
+  ReceiverCall *call = (ReceiverCall *)data;
+
+  if (receiverPcb != NULL)
+  {
+    udp_recv(receiverPcb, NULL, NULL);
+    udp_remove(receiverPcb);
+    receiverPcb = NULL;
+  }
+
+  call->err = ERR_OK;
+  return call->err;
+}
+
+bool artnetReceiverBegin(uint16_t port, ArtNetDatagramHandler handler)
+{
+  if (receiverPcb != NULL)
+  {
+    artnetReceiverEnd();
+  }
+
+  receiverHandler = handler;
+  chainedCount = 0;
+
+  ReceiverCall call;
+  call.port = port;
+  call.err = ERR_OK;
+  tcpip_api_call(receiverBind, &call.call);
+
+  return call.err == ERR_OK;
+}
+
+void artnetReceiverEnd()
+{
+  // Runs in the lwIP thread, so no receiverRecv can be executing afterwards
+  ReceiverCall call;
+  call.port = 0;
+  call.err = ERR_OK;
+  tcpip_api_call(receiverUnbind, &call.call);
+}
+
+bool artnetReceiverRunning()
+{
+  return receiverPcb != NULL;
+}
+
+bool artnetReceiverSendTo(const uint8_t *data, uint16_t length, uint32_t address, uint16_t port)
+{
+  ReceiverSend send;
+  send.data = data;
+  send.length = length;
+  send.address = address;
+  send.port = port;
+  send.err = ERR_OK;
+  tcpip_api_call(receiverSend, &send.call);
+
+  return send.err == ERR_OK;
+}
+
+uint32_t artnetReceiverChainedCount()
+{
+  return chainedCount;
+}
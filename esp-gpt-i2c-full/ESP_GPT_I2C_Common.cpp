@@ -14,15 +14,52 @@ Settings settings;
 State state;
 Preferences preferences;
 AsyncUDP artnetUdp;
-CRGB leds[NUM_LEDS];
+CRGB *leds = NULL;
+uint16_t ledBufferSize = 0;
 
-void debugLog(String msg)
+// Link events networkInitTask waits on instead of polling WiFi.status()
+#define NETWORK_INIT_CONNECTED BIT0
+#define NETWORK_INIT_DISCONNECTED BIT1
+static EventGroupHandle_t networkInitEvents = NULL;
+
+// Copies the text into the log ring - Serial output happens in the formatter task,
+// which the first message starts
+void debugLog(const char *msg)
 {
   if (!DEBUG_ENABLED)
     return;
-  Serial.println(msg);
-  state.logs[state.logIndex] = msg;
-  state.logIndex = (state.logIndex + 1) % MAX_LOG_ENTRIES;
+  logRingBegin();
+  logRingText(strncmp(msg, "ERROR", 5) == 0 ? LOG_LEVEL_ERROR : LOG_LEVEL_INFO, msg);
+}
+
+void debugLog(const String &msg)
+{
+  debugLog(msg.c_str());
+}
+
+// Allocate the shared pixel buffer for the given number of LEDs.
+// Outputs keep pointers into it, so it is sized once and only ever grows.
+bool allocateLEDs(uint16_t numLeds)
+{
+  if (leds != NULL && numLeds <= ledBufferSize)
+  {
+    return true;
+  }
+  if (leds != NULL)
+  {
+    debugLog("ERROR: LED buffer already allocated for " + String(ledBufferSize) + " LEDs");
+    return false;
+  }
+
+  leds = (CRGB *)calloc(numLeds, sizeof(CRGB));
+  if (leds == NULL)
+  {
+    debugLog("ERROR: LED buffer allocation failed (" + String(numLeds * sizeof(CRGB)) + " bytes)");
+    return false;
+  }
+
+  ledBufferSize = numLeds;
+  return true;
 }
 
 void disableAllNetworkOperations()
@@ -38,14 +75,63 @@ void disableAllNetworkOperations()
   settings.useWiFi = false;
   settings.artnetEnabled = false;
 
-  // Persist the network failure state to prevent future attempts after reboot
-  preferences.begin("led-settings", false);
-  preferences.putBool("netFailed", true);
-  preferences.end();
+  // Persist the network failure state to prevent future attempts after reboot -
+  // written straight away, a crash may follow
+  settingsStoreSetFlag(SETTINGS_FLAG_NET_FAILED, true, true);
 
   debugLog("CRITICAL: Network stack disabled due to assertion failure");
 }
 
+static void onNetworkInitEvent(WiFiEvent_t event, WiFiEventInfo_t info)
+{
+  if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP)
+  {
+    xEventGroupSetBits(networkInitEvents, NETWORK_INIT_CONNECTED);
+  }
+  else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED)
+  {
+    xEventGroupSetBits(networkInitEvents, NETWORK_INIT_DISCONNECTED);
+  }
+}
+
+// Start a connection and block until it gets an IP or fails.
+// A fast attempt on a cached channel gives up on the first disconnect;
+// a full scan keeps retrying until the timeout
+static bool connectWiFi(int32_t channel, const uint8_t *bssid, uint32_t timeoutMs)
+{
+  EventBits_t waitBits = NETWORK_INIT_CONNECTED | (bssid != NULL ? NETWORK_INIT_DISCONNECTED : 0);
+
+  xEventGroupClearBits(networkInitEvents, NETWORK_INIT_CONNECTED | NETWORK_INIT_DISCONNECTED);
+  WiFi.begin(settings.ssid, settings.password, channel, bssid);
+
+  EventBits_t bits = xEventGroupWaitBits(networkInitEvents, waitBits, pdFALSE, pdFALSE, pdMS_TO_TICKS(timeoutMs));
+  return (bits & NETWORK_INIT_CONNECTED) != 0;
+}
+
+// Remember the access point so the next boot can skip the channel scan.
+// Flash is only written when it changed
+static void cacheAccessPoint()
+{
+  Preferences cache;
+  uint8_t *bssid = WiFi.BSSID();
+  uint8_t channel = (uint8_t)WiFi.channel();
+  uint8_t stored[6];
+
+  if (bssid == NULL || channel == 0 || !cache.begin(WIFI_CACHE_NAMESPACE, false))
+  {
+    return;
+  }
+
+  if (cache.getString("ssid") != settings.ssid || cache.getUChar("channel", 0) != channel ||
+      cache.getBytes("bssid", stored, sizeof(stored)) != sizeof(stored) || memcmp(stored, bssid, sizeof(stored)) != 0)
+  {
+    cache.putString("ssid", settings.ssid);
+    cache.putBytes("bssid", bssid, sizeof(stored));
+    cache.putUChar("channel", channel);
+  }
+  cache.end();
+}
+
 void networkInitTask(void *parameter)
 {
   debugLog("Network initialization task started on core " + String(xPortGetCoreID()));
@@ -54,15 +140,9 @@ void networkInitTask(void *parameter)
   // Initialize the network with proper sequence and safeguards
   try
   {
-    // CRITICAL: Wait a moment to ensure the main task is ready
-    // This small delay helps prevent race conditions with the main CPU
-    delay(100);
-
     // Start with a clean state
     WiFi.disconnect(true);
-    delay(500);
     WiFi.mode(WIFI_OFF);
-    delay(500);
 
     // **** CRITICAL FIX: Proper ESP-IDF component initialization sequence ****
     // This sequence is essential - the exact order matters
@@ -100,34 +180,59 @@ void networkInitTask(void *parameter)
     }
     debugLog("Event loop initialized successfully");
 
-    // Strategic yield to ensure other threads have time to process
-    yield();
+    // Link events replace polling WiFi.status()
+    if (networkInitEvents == NULL)
+    {
+      networkInitEvents = xEventGroupCreate();
+      if (networkInitEvents == NULL)
+      {
+        throw std::runtime_error("Network event group creation failed");
+      }
+      WiFi.onEvent(onNetworkInitEvent);
+    }
 
-    // Only after ESP-IDF initialization, initialize the WiFi station
+    // Only after ESP-IDF initialization, initialize the WiFi station.
+    // The core reconnects straight away after an AP drop
     debugLog("ESP-IDF core components initialized, starting WiFi...");
     WiFi.mode(WIFI_STA);
-    delay(300); // Extended delay after mode change - critical for stability
+    WiFi.setAutoReconnect(true);
 
-    // Connect with timeout
-    debugLog("Attempting to connect to WiFi: " + settings.ssid);
-    WiFi.begin(settings.ssid.c_str(), settings.password.c_str());
+    // Skip the scan when the access point of the last connection is known
+    Preferences cache;
+    uint8_t bssid[6];
+    uint8_t channel = 0;
+    if (cache.begin(WIFI_CACHE_NAMESPACE, true))
+    {
+      if (cache.getString("ssid") == settings.ssid && cache.getBytes("bssid", bssid, sizeof(bssid)) == sizeof(bssid))
+      {
+        channel = cache.getUChar("channel", 0);
+      }
+      cache.end();
+    }
 
-    // Wait for connection with timeout
-    int attemptCount = 0;
-    while (WiFi.status() != WL_CONNECTED && attemptCount < 20)
+    unsigned long connectStart = millis();
+    if (channel != 0)
     {
-      delay(500);
-      Serial.print(".");
-      // Strategic yield to keep watchdog happy
-      yield();
-      attemptCount++;
+      debugLog("Attempting to connect to WiFi: " + String(settings.ssid) + " (cached channel " + String(channel) + ")");
+      success = connectWiFi(channel, bssid, WIFI_FAST_CONNECT_TIMEOUT_MS);
+      if (!success)
+      {
+        debugLog("Fast connect failed, scanning all channels");
+        WiFi.disconnect();
+      }
+    }
+    if (!success)
+    {
+      debugLog("Attempting to connect to WiFi: " + String(settings.ssid));
+      success = connectWiFi(0, NULL, WIFI_CONNECT_TIMEOUT_MS);
     }
 
-    if (WiFi.status() == WL_CONNECTED)
+    if (success)
     {
-      debugLog("WiFi connected successfully to: " + settings.ssid);
+      debugLog("WiFi connected successfully to: " + String(settings.ssid) + " (" + String(millis() - connectStart) + " ms)");
       debugLog("IP address: " + WiFi.localIP().toString());
-      success = true;
+      cacheAccessPoint();
+      bootMark(BOOT_STAGE_WIFI);
     }
     else
     {
@@ -162,10 +267,10 @@ void networkInitTask(void *parameter)
 }
 
 // Initialize FastLED and set up ArtNet listener
-bool setupArtNet()
+bool setupArtNet(FrameOutputCallback output)
 {
   // Exit early if network is not available
-  if (networkInitFailed || !settings.artnetEnabled)
+  if (networkInitFailed || (!settings.artnetEnabled && !settings.sacnEnabled))
   {
     debugLog("ArtNet setup skipped - network unavailable or disabled");
     return false;
@@ -178,51 +283,150 @@ bool setupArtNet()
     return false;
   }
 
-  debugLog("Setting up FastLED on pin " + String(settings.ledPin));
+  if (settings.ledCount > MAX_LEDS)
+  {
+    debugLog("WARNING: LED count " + String(settings.ledCount) + " limited to " + String(MAX_LEDS));
+    settings.ledCount = MAX_LEDS;
+  }
+
+  // Initialize the LED strip unless the sketch has already registered its outputs
+  if (output == NULL && FastLED.count() == 0)
+  {
+    debugLog("Setting up FastLED on pin " + String(settings.ledPin));
+    if (!allocateLEDs(settings.ledCount))
+    {
+      return false;
+    }
 
-  // Initialize the LED strip
-  FastLED.addLeds<WS2812B, LED_PIN, GRB>(leds, settings.ledCount);
-  FastLED.setBrightness(settings.brightness);
+    FastLED.addLeds<WS2812B, LED_PIN, GRB>(leds, settings.ledCount);
+    FastLED.setBrightness(settings.brightness);
 
-  // Clear all LEDs to black
-  FastLED.clear();
-  FastLED.show();
+    // Clear all LEDs to black
+    FastLED.clear();
+    FastLED.show();
 
-  // Run the startup animation to confirm LEDs are working
-  startupAnimation();
+    // Run the startup animation to confirm LEDs are working - fast boot goes
+    // straight to the first frame
+    if (!settings.fastBoot)
+    {
+      startupAnimation();
+    }
 
-  // Set up the UDP listener for ArtNet packets
-  debugLog("Setting up ArtNet listener on port " + String(ARTNET_PORT));
-  IPAddress localIP = WiFi.localIP();
+    // From here on brightness is applied by the pixel kernel LUT
+    FastLED.setBrightness(255);
+  }
 
-  if (artnetUdp.listen(ARTNET_PORT))
+  // Each universe of the input range feeds the next 170 pixels of the frame
+  if (!framePipelineMapUniverses(settings.artnetUniverse, settings.artnetUniverseCount))
   {
-    debugLog("ArtNet UDP listener started on port " + String(ARTNET_PORT));
+    debugLog("ArtNet setup failed - invalid universe range");
+    return false;
+  }
 
-    // Set up the onPacket callback
-    artnetUdp.onPacket([](AsyncUDPPacket packet)
-                       { processArtNetPacket(packet); });
+  // Start the render task before packets can arrive - from here on only the
+  // render task touches the LED hardware, at most maxFps times per second
+  framePipelineSetMaxFps(settings.maxFps);
+  framePipelineSetInterpolation(settings.interpolateFrames);
+  if (!framePipelineBegin(settings.ledCount, output != NULL ? output : updateLEDs))
+  {
+    debugLog("ArtNet setup failed - frame pipeline could not start");
+    return false;
+  }
 
-    state.artnetRunning = true;
-    return true;
+  // Set up the UDP listener for ArtNet packets
+  bool listening = false;
+  if (settings.artnetEnabled)
+  {
+    debugLog("Setting up ArtNet listener on port " + String(ARTNET_PORT));
+
+#if ARTNET_RAW_RECEIVER
+    // Datagrams are parsed straight from the lwIP pbuf into the frame back buffer
+    if (artnetReceiverBegin(ARTNET_PORT, processArtNetData))
+    {
+      debugLog("ArtNet raw UDP receiver started on port " + String(ARTNET_PORT));
+      listening = true;
+    }
+#else
+    if (artnetUdp.listen(ARTNET_PORT))
+    {
+      debugLog("ArtNet UDP listener started on port " + String(ARTNET_PORT));
+
+      // Set up the onPacket callback
+      artnetUdp.onPacket([](AsyncUDPPacket &packet)
+                         { processArtNetPacket(packet); });
+      listening = true;
+    }
+#endif
+    else
+    {
+      debugLog("Failed to start ArtNet UDP listener");
+    }
   }
-  else
+
+  // sACN feeds the same universes, numbered E131_UNIVERSE_OFFSET higher
+  if (settings.sacnEnabled)
+  {
+    uint16_t sacnUniverse = settings.artnetUniverse + E131_UNIVERSE_OFFSET;
+    if (e131ReceiverBegin(sacnUniverse, settings.artnetUniverseCount))
+    {
+      debugLog("sACN receiver started on port " + String(E131_PORT) + " for universes " + String(sacnUniverse) + "-" +
+               String(sacnUniverse + settings.artnetUniverseCount - 1));
+      listening = true;
+    }
+    else
+    {
+      debugLog("Failed to start sACN receiver");
+    }
+  }
+
+  if (!listening)
   {
-    debugLog("Failed to start ArtNet UDP listener");
+    framePipelineEnd();
     state.artnetRunning = false;
     return false;
   }
+
+  state.artnetRunning = true;
+  bootMark(BOOT_STAGE_ARTNET);
+  return true;
+}
+
+// Close the UDP listener and stop the render task
+void stopArtNet()
+{
+  if (state.artnetRunning)
+  {
+#if ARTNET_RAW_RECEIVER
+    artnetReceiverEnd();
+#else
+    artnetUdp.close();
+#endif
+    e131ReceiverEnd();
+    state.artnetRunning = false;
+    debugLog("ArtNet listener stopped");
+  }
+  framePipelineEnd();
 }
 
 // Process incoming ArtNet packet
-void processArtNetPacket(AsyncUDPPacket packet)
+// Runs in the async_udp task: only parses and copies into the frame pipeline
+void processArtNetPacket(AsyncUDPPacket &packet)
 {
-  uint8_t *data = packet.data();
-  size_t len = packet.length();
+  heapMonitorSetPath(HEAP_PATH_PACKET);
+  processArtNetData(packet.data(), packet.length());
+  heapMonitorSetPath(HEAP_PATH_NONE);
+}
 
-  // ArtNet packets must be at least 18 bytes (header + opcode + universe + length)
-  if (len < 18)
+// Parse one ArtNet datagram - shared by the UDP listeners and the on-device benchmark.
+// With the raw receiver this runs in the lwIP thread, so it must never block.
+void processArtNetData(const uint8_t *data, size_t len)
+{
+  uint32_t parseStart = perfTimestamp();
+
+  // ArtSync is the shortest packet we handle (header + opcode + version + aux)
+  if (len < 14)
   {
+    perfCountMalformed();
     return;
   }
 
@@ -230,6 +434,21 @@ void processArtNetPacket(AsyncUDPPacket packet)
   if (data[0] != 'A' || data[1] != 'r' || data[2] != 't' || data[3] != '-' ||
       data[4] != 'N' || data[5] != 'e' || data[6] != 't' || data[7] != 0)
   {
+    perfCountMalformed();
+    return;
+  }
+
+  // OpCode 0x5200 (ArtSync) - latch the assembled frame on every port at once
+  if (data[8] == 0x00 && data[9] == 0x52)
+  {
+    framePipelineSync();
+    return;
+  }
+
+  // OpCode 0x2000 (ArtPoll) - the prebuilt reply goes out from the housekeeping task
+  if (data[8] == 0x00 && data[9] == 0x20)
+  {
+    artnetDiscoveryPoll(data, len);
     return;
   }
 
@@ -239,48 +458,70 @@ void processArtNetPacket(AsyncUDPPacket packet)
     return;
   }
 
-  // Extract universe (lower byte, little endian)
-  uint16_t universe = data[14] | (data[15] << 8);
-
-  // Only process if it's our universe
-  if (universe != settings.artnetUniverse)
+  // ArtDmx packets must be at least 18 bytes (header + opcode + universe + length)
+  if (len < 18)
   {
+    perfCountMalformed();
     return;
   }
 
+  // Extract universe (lower byte, little endian)
+  uint16_t universe = data[14] | (data[15] << 8);
+
   // Extract data length (DMX channels, high byte first)
   uint16_t dataLength = (data[16] << 8) | data[17];
 
+  // Never trust the header length beyond what was actually received
+  if (dataLength > len - 18)
+  {
+    perfCountMalformed();
+    dataLength = len - 18;
+  }
+
   // DMX data starts at offset 18
-  uint8_t *dmxData = &data[18];
+  const uint8_t *dmxData = &data[18];
 
-  // Update LEDs with the DMX data
-  updateLEDs(dmxData, dataLength);
+  // Copy into the universe's region of the frame - universes outside the map are dropped.
+  // The pipeline latches the frame itself once it is complete or an ArtSync arrives.
+  if (!framePipelineWriteUniverse(universe, dmxData, dataLength))
+  {
+    perfCountOutOfUniverse();
+    perfRecord(PERF_STAGE_PARSE, parseStart);
+    return;
+  }
 
   // Update statistics
+  if (state.artnetPacketCount == 0)
+  {
+    bootMark(BOOT_STAGE_FIRST_PACKET);
+  }
   state.artnetPacketCount++;
   state.lastArtnetPacket = millis();
+  perfRecord(PERF_STAGE_PARSE, parseStart);
 }
 
 // Update LEDs based on DMX data
-void updateLEDs(uint8_t *dmxData, uint16_t numChannels)
+// Output stage of the frame pipeline - called from the render task
+void updateLEDs(const uint8_t *dmxData, uint16_t numChannels)
 {
   // Each LED uses 3 channels (R,G,B)
   uint16_t numLEDs = (numChannels / 3 < settings.ledCount) ? numChannels / 3 : settings.ledCount;
+  numLEDs = min(numLEDs, ledBufferSize);
 
-  // Update each LED with RGB values from DMX data
-  for (uint16_t i = 0; i < numLEDs; i++)
-  {
-    uint16_t dmxOffset = i * 3;
-
-    // Set RGB values from DMX data
-    leds[i].r = dmxData[dmxOffset];
-    leds[i].g = dmxData[dmxOffset + 1];
-    leds[i].b = dmxData[dmxOffset + 2];
-  }
+  // Brightness and gamma in the same pass as the copy (LUT rebuilt only on change)
+  uint32_t convertStart = perfTimestamp();
+  pixelKernelSetCorrection(settings.brightness, settings.gamma);
+  pixelKernelApplyCorrection();
+  pixelConvert(dmxData, (uint8_t *)leds, numLEDs, NULL);
+  perfRecord(PERF_STAGE_CONVERT, convertStart);
 
   // Update the LEDs
+  uint32_t showStart = perfTimestamp();
   FastLED.show();
+  perfRecord(PERF_STAGE_SHOW, showStart);
+
+  i2cSlaveFrameShown(dmxData, numLEDs * 3);
+  liveViewFrameShown(dmxData, numLEDs * 3);
 }
 
 // Simple startup animation to confirm LEDs are working
@@ -308,4 +549,4 @@ void startupAnimation()
   FastLED.show();
 
   debugLog("Startup animation complete");
-}
\ No newline at end of file
+}
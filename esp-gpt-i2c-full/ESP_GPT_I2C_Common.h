@@ -5,10 +5,25 @@
 #include <Preferences.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 #include "esp_system.h"
 #include <WiFi.h>
 #include <AsyncUDP.h>
 #include <FastLED.h>
+#include "FramePipeline.h"
+#include "PixelKernel.h"
+#include "PerfCounters.h"
+#include "ArtNetReceiver.h"
+#include "ArtNetDiscovery.h"
+#include "E131Receiver.h"
+#include "I2CSlave.h"
+#include "LiveView.h"
+#include "LedEffects.h"
+#include "LogRing.h"
+#include "TaskMonitor.h"
+#include "FastBoot.h"
+#include "SettingsStore.h"
+#include "HeapMonitor.h"
 
 // Define constants
 #define DEBUG_ENABLED true
@@ -20,28 +35,60 @@
 #define ARTNET_UNIVERSE 0
 #define ARTNET_PORT 6454
 
+// Multi-universe input - defaults mirror src/Config.h
+#ifndef ARTNET_UNIVERSE_START
+#define ARTNET_UNIVERSE_START ARTNET_UNIVERSE
+#endif
+#ifndef ARTNET_NUM_UNIVERSES
+#define ARTNET_NUM_UNIVERSES 1
+#endif
+
+// Largest pixel count a single node can be fed with
+#define MAX_LEDS (FRAME_MAX_UNIVERSES * FRAME_PIXELS_PER_UNIVERSE)
+
+// WiFi connect timeouts for networkInitTask - the fast attempt reuses the
+// BSSID/channel cached after the last successful connection. src/Config.h
+// defines the same values, so both builds share the cache and the timing.
+#ifndef WIFI_FAST_CONNECT_TIMEOUT_MS
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 2000
+#endif
+#ifndef WIFI_CONNECT_TIMEOUT_MS
+#define WIFI_CONNECT_TIMEOUT_MS 8000
+#endif
+#ifndef WIFI_CACHE_NAMESPACE
+#define WIFI_CACHE_NAMESPACE "wifi-cache"
+#endif
+
+// Credential buffers, terminator included - fixed size, so settings never touch the heap
+#define SETTINGS_SSID_SIZE 33
+#define SETTINGS_PASSWORD_SIZE 65
+#define SETTINGS_NODE_NAME_SIZE 33
+
 // Basic settings structure
 struct Settings
 {
-  String ssid = "Sage1";
-  String password = "J@sper123";
+  char ssid[SETTINGS_SSID_SIZE] = "Sage1";
+  char password[SETTINGS_PASSWORD_SIZE] = "J@sper123";
   bool useWiFi = true;
-  String nodeName = "ESP32_Test";
+  char nodeName[SETTINGS_NODE_NAME_SIZE] = "ESP32_Test";
 
   // LED and ArtNet settings
-  uint16_t artnetUniverse = ARTNET_UNIVERSE;
-  uint16_t ledCount = NUM_LEDS;
+  uint16_t artnetUniverse = ARTNET_UNIVERSE_START; // First universe of the input range
+  uint8_t artnetUniverseCount = ARTNET_NUM_UNIVERSES;
+  uint16_t ledCount = NUM_LEDS;                       // Total pixels across all universes
   uint8_t ledPin = LED_PIN;
   uint8_t brightness = 255;
+  float gamma = PIXEL_DEFAULT_GAMMA;
+  uint8_t maxFps = FRAME_DEFAULT_MAX_FPS;            // Output refresh cap, 0 = unlimited
+  bool interpolateFrames = false;                    // Blend between received frames at the output rate
+  bool fastBoot = false;                             // Skip boot animations, show the last frame before networking
   bool artnetEnabled = true;
+  bool sacnEnabled = false;                          // Also take sACN (E1.31) into the same universe map
 };
 
-// Basic state for logs and status
+// Basic state for status - log lines live in the log ring (LogRing.h)
 struct State
 {
-  String logs[MAX_LOG_ENTRIES];
-  int logIndex = 0;
-
   // ArtNet state tracking
   uint32_t artnetPacketCount = 0;
   unsigned long lastArtnetPacket = 0;
@@ -57,17 +104,24 @@ extern Settings settings;
 extern State state;
 extern Preferences preferences;
 extern AsyncUDP artnetUdp;
-extern CRGB leds[];
+extern CRGB *leds;
+extern uint16_t ledBufferSize;
 
 // Function declarations
-void debugLog(String msg);
+// The const char * form copies straight into the log ring, without a String
+void debugLog(const char *msg);
+void debugLog(const String &msg);
+bool allocateLEDs(uint16_t numLeds);
 void disableAllNetworkOperations();
 void networkInitTask(void *parameter);
 
 // ArtNet specific functions
-bool setupArtNet();
-void processArtNetPacket(AsyncUDPPacket packet);
-void updateLEDs(uint8_t *dmxData, uint16_t numChannels);
+// output replaces updateLEDs when the sketch drives its own LED hardware
+bool setupArtNet(FrameOutputCallback output = NULL);
+void stopArtNet();
+void processArtNetPacket(AsyncUDPPacket &packet);
+void processArtNetData(const uint8_t *data, size_t len);
+void updateLEDs(const uint8_t *dmxData, uint16_t numChannels);
 void startupAnimation();
 
-#endif // ESP_GPT_I2C_COMMON_H
\ No newline at end of file
+#endif // ESP_GPT_I2C_COMMON_H
@@ -0,0 +1,97 @@
+#include "FastBoot.h"
+#include "ESP_GPT_I2C_Common.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+
+#define FAST_BOOT_MAGIC 0x46424F54 // "FBOT"
+
+struct FrameSnapshot
+{
+  uint32_t magic;       // FAST_BOOT_MAGIC once data and hash are complete
+  uint32_t length;      // Bytes of data in use
+  uint32_t hash;        // pixelHash() of data[0..length)
+  uint8_t data[FAST_BOOT_SNAPSHOT_BYTES];
+};
+
+// Not cleared at start-up - after a power-on this is noise that fails the checks
+RTC_NOINIT_ATTR static FrameSnapshot snapshot;
+
+static uint32_t stageUs[BOOT_STAGE_COUNT];
+static uint32_t lastSnapshotMs = 0;
+static bool snapshotRestored = false;
+
+static const char *stageNames[BOOT_STAGE_COUNT] = {"setup", "settings", "output", "firstFrame",
+                                                   "wifi", "artnet", "firstPacket", "ready"};
+
+void bootMark(BootStage stage)
+{
+  if (stage < BOOT_STAGE_COUNT && stageUs[stage] == 0)
+  {
+    // Never 0 once reached, so the first call keeps its time
+    stageUs[stage] = max((uint32_t)esp_timer_get_time(), (uint32_t)1);
+  }
+}
+
+uint32_t bootStageUs(BootStage stage)
+{
+  return stage < BOOT_STAGE_COUNT ? stageUs[stage] : 0;
+}
+
+const char *bootStageName(BootStage stage)
+{
+  return stage < BOOT_STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+void fastBootFrameShown(const uint8_t *frame, uint16_t numChannels)
+{
+  uint32_t now = millis();
+  if (lastSnapshotMs != 0 && now - lastSnapshotMs < FAST_BOOT_SNAPSHOT_INTERVAL_MS)
+  {
+    return;
+  }
+  lastSnapshotMs = now;
+
+  // Invalidate first - a reset in the middle of the copy leaves no half frame behind
+  uint32_t length = min((uint32_t)numChannels, (uint32_t)FAST_BOOT_SNAPSHOT_BYTES);
+  snapshot.magic = 0;
+  memcpy(snapshot.data, frame, length);
+  snapshot.length = length;
+  snapshot.hash = pixelHash(snapshot.data, length);
+  snapshot.magic = FAST_BOOT_MAGIC;
+}
+
+bool fastBootRestoreFrame(uint8_t *frame, uint16_t numChannels)
+{
+  if (snapshot.magic != FAST_BOOT_MAGIC || snapshot.length == 0 || snapshot.length > FAST_BOOT_SNAPSHOT_BYTES ||
+      pixelHash(snapshot.data, snapshot.length) != snapshot.hash)
+  {
+    return false;
+  }
+
+  uint32_t length = min((uint32_t)numChannels, snapshot.length);
+  memcpy(frame, snapshot.data, length);
+  memset(frame + length, 0, numChannels - length);
+  snapshotRestored = true;
+  return true;
+}
+
+String bootStatsJson()
+{
+  String json = "{\"fastBoot\":" + String(settings.fastBoot ? "true" : "false");
+  json += ",\"restored\":" + String(snapshotRestored ? "true" : "false");
+  json += ",\"stagesUs\":{";
+  bool first = true;
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++)
+  {
+    if (stageUs[i] == 0)
+    {
+      continue;
+    }
+    if (!first)
+      json += ",";
+    first = false;
+    json += "\"" + String(stageNames[i]) + "\":" + String(stageUs[i]);
+  }
+  json += "}}";
+  return json;
+}
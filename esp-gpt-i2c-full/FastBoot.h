@@ -0,0 +1,47 @@
+#ifndef FAST_BOOT_H
+#define FAST_BOOT_H
+
+#include <Arduino.h>
+
+// Fast boot support: the last shown frame is kept in RTC memory, which survives
+// software and watchdog resets, so the strips can show it again before any
+// networking is up. Boot stages are timestamped for /stats.
+
+// RTC slow memory is 8 KB shared with the core - longer frames keep their first
+// FAST_BOOT_SNAPSHOT_BYTES / 3 pixels, the rest come back black
+#define FAST_BOOT_SNAPSHOT_BYTES 4095
+#define FAST_BOOT_SNAPSHOT_INTERVAL_MS 1000
+
+enum BootStage
+{
+  BOOT_STAGE_SETUP = 0,    // setup() entered
+  BOOT_STAGE_SETTINGS,     // Settings loaded from NVS
+  BOOT_STAGE_OUTPUT,       // LED output ready
+  BOOT_STAGE_FIRST_FRAME,  // First frame on the strips
+  BOOT_STAGE_WIFI,         // WiFi connected
+  BOOT_STAGE_ARTNET,       // ArtNet receiver listening
+  BOOT_STAGE_FIRST_PACKET, // First ArtDmx packet accepted
+  BOOT_STAGE_READY,        // setup() and the deferred network services done
+  BOOT_STAGE_COUNT
+};
+
+// Record the time a stage was reached - only the first call per stage counts
+void bootMark(BootStage stage);
+
+// Microseconds since start-up when the stage was reached, 0 if not yet
+uint32_t bootStageUs(BootStage stage);
+
+const char *bootStageName(BootStage stage);
+
+// Render path hook: copy the frame into the RTC snapshot, at most once per
+// FAST_BOOT_SNAPSHOT_INTERVAL_MS
+void fastBootFrameShown(const uint8_t *frame, uint16_t numChannels);
+
+// Fill frame from a snapshot that survived the reset. Returns false (frame
+// untouched) after a power-on or when the snapshot does not verify.
+bool fastBootRestoreFrame(uint8_t *frame, uint16_t numChannels);
+
+// {"fastBoot":..,"restored":..,"stagesUs":{"setup":..,..}} - unreached stages are left out
+String bootStatsJson();
+
+#endif // FAST_BOOT_H
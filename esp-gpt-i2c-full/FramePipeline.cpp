@@ -0,0 +1,798 @@
+#include "FramePipeline.h"
+#include "ESP_GPT_I2C_Common.h"
+
+// Triple-buffered frame pipeline
+// Receivers assemble the next frame in the back buffer from the network task.
+// Latching a frame swaps back/ready under a short critical section, so the
+// next frame can start assembling immediately. The render task swaps
+// ready/front and pushes the front buffer to the output stage, so LED
+// transmission never runs in the UDP callback.
+//
+// Writers own the back buffer while they hold writerMutex - frame data is
+// copied with interrupts on, and frameMux only covers the pointer swaps and
+// flags shared with the render task.
+
+static uint8_t *frameBuffers[3] = {NULL, NULL, NULL};
+static uint8_t *frontBuffer = NULL;
+static uint8_t *readyBuffer = NULL;
+static uint8_t *backBuffer = NULL;
+static uint32_t frameBytes = 0;
+
+// Set after a latch: the back buffer holds an older frame and must be
+// refreshed from the newest frame before a partial write lands in it
+static bool backNeedsSync = false;
+static SemaphoreHandle_t writerMutex = NULL;
+static volatile bool frameReady = false;
+static volatile bool pipelineRunning = false;
+
+// Change detection: writes compare against the newest frame before copying,
+// so a retransmitted frame reaches the render task marked unchanged
+static bool backChanged = false;
+static bool readyChanged = false;
+static bool outputShown = false;
+static uint32_t shownCorrectionId = 0;
+static unsigned long lastOutputTime = 0;
+
+// Universe lookup table: offset of (universe - universeBase), one entry per mapped universe
+static uint16_t universeBase = 0;
+static uint8_t universeCount = 0;
+static uint16_t universePixels = FRAME_PIXELS_PER_UNIVERSE;
+static uint16_t universeOffsets[FRAME_MAX_UNIVERSES];
+
+// Frame assembly: one bit per mapped universe received since the last latch
+static uint32_t expectedUniverses = 0;
+static volatile uint32_t pendingUniverses = 0;
+static volatile unsigned long assemblyStartTime = 0;
+static unsigned long lastSyncTime = 0;
+static bool syncSeen = false;
+
+// Render scheduler: output is released on a fixed period, deadlines in micros()
+static volatile uint32_t framePeriodUs = 1000000UL / FRAME_DEFAULT_MAX_FPS;
+static uint32_t nextDeadlineUs = 0;
+static bool deadlineArmed = false;
+
+// Temporal interpolation - the buffers belong to the render task, which
+// allocates and frees them itself so nothing else ever touches them
+static volatile bool interpolationRequested = false;
+static uint8_t *blendFrom = NULL;   // What the strip showed when the target arrived
+static uint8_t *blendOutput = NULL; // Last blended frame sent to the output
+static bool blending = false;
+static uint32_t blendStartUs = 0;
+static uint32_t blendDurationUs = 0;
+static uint32_t lastArrivalUs = 0;
+static uint32_t frameIntervalUs = 0; // Smoothed time between received frames
+static uint8_t ditherStep = 0;
+
+static FrameOutputCallback outputCallback = NULL;
+static TaskHandle_t renderTaskHandle = NULL;
+static portMUX_TYPE frameMux = portMUX_INITIALIZER_UNLOCKED;
+static FramePipelineStats pipelineStats;
+
+static void freeFrameBuffers()
+{
+  for (int i = 0; i < 3; i++)
+  {
+    free(frameBuffers[i]);
+    frameBuffers[i] = NULL;
+  }
+}
+
+static void freeBlendBuffers()
+{
+  free(blendFrom);
+  free(blendOutput);
+  blendFrom = NULL;
+  blendOutput = NULL;
+  blending = false;
+}
+
+// Take the back buffer for writing - false once the pipeline has stopped
+static bool claimBackBuffer()
+{
+  if (writerMutex == NULL)
+  {
+    return false;
+  }
+  xSemaphoreTake(writerMutex, portMAX_DELAY);
+  if (!pipelineRunning || backBuffer == NULL)
+  {
+    xSemaphoreGive(writerMutex);
+    return false;
+  }
+  return true;
+}
+
+static void releaseBackBuffer()
+{
+  xSemaphoreGive(writerMutex);
+}
+
+// Must be called with writerMutex held
+static void syncBackBuffer()
+{
+  if (!backNeedsSync)
+  {
+    return;
+  }
+
+  // The newest complete frame is either waiting in ready or already on the front.
+  // Only a latch hands it back to the writers, so it stays put while it is copied.
+  portENTER_CRITICAL(&frameMux);
+  const uint8_t *newest = frameReady ? readyBuffer : frontBuffer;
+  portEXIT_CRITICAL(&frameMux);
+
+  memcpy(backBuffer, newest, frameBytes);
+  backNeedsSync = false;
+}
+
+// Must be called with writerMutex held - the compare ran on the writer's own
+// back buffer, only the flag the render task sees is set under the lock
+static void publishChange(bool changed)
+{
+  if (changed && !backChanged)
+  {
+    portENTER_CRITICAL(&frameMux);
+    backChanged = true;
+    portEXIT_CRITICAL(&frameMux);
+  }
+}
+
+// Must be called with writerMutex and frameMux held
+static void latchFrame()
+{
+  if (frameReady)
+  {
+    // The render task has not picked up the previous frame yet - latest wins
+    pipelineStats.framesCoalesced++;
+  }
+
+  // A coalesced frame keeps its change, it never reached the strip
+  readyChanged = (frameReady && readyChanged) || backChanged;
+  backChanged = false;
+
+  uint8_t *previousReady = readyBuffer;
+  readyBuffer = backBuffer;
+  backBuffer = previousReady;
+  backNeedsSync = true;
+  frameReady = true;
+  pendingUniverses = 0;
+  pipelineStats.framesPresented++;
+}
+
+static void notifyRenderTask()
+{
+  if (renderTaskHandle != NULL)
+  {
+    xTaskNotifyGive(renderTaskHandle);
+  }
+}
+
+// ArtSync mode stays active while sync packets keep arriving
+static bool syncActive(unsigned long now)
+{
+  return syncSeen && (now - lastSyncTime < FRAME_SYNC_HOLDOFF_MS);
+}
+
+// Output period - interpolation needs a cadence even when the rate is uncapped
+static uint32_t outputPeriodUs()
+{
+  uint32_t period = framePeriodUs;
+  if (period == 0 && blendOutput != NULL)
+  {
+    period = 1000000UL / FRAME_MAX_FPS_LIMIT;
+  }
+  return period;
+}
+
+// How long the render task may sleep - an assembly in progress is expired on
+// time, otherwise it only wakes periodically when nothing notifies it
+static TickType_t assemblyWait()
+{
+  if (pendingUniverses == 0)
+  {
+    return pdMS_TO_TICKS(FRAME_ASSEMBLY_TIMEOUT_MS);
+  }
+
+  int32_t remaining = (int32_t)(assemblyStartTime + FRAME_ASSEMBLY_TIMEOUT_MS - millis());
+  TickType_t ticks = remaining > 0 ? pdMS_TO_TICKS(remaining) : 0;
+  return ticks > 0 ? ticks : 1;
+}
+
+// Sleep until the refresh deadline; frames latched meanwhile replace the pending one
+static void waitForDeadline()
+{
+  uint32_t period = outputPeriodUs();
+  if (period == 0 || !deadlineArmed)
+  {
+    return;
+  }
+
+  int32_t remaining = (int32_t)(nextDeadlineUs - micros());
+  if (remaining > 0)
+  {
+    // Rounded up to whole ticks, so frames leave on the first tick after the deadline
+    if (frameReady)
+    {
+      pipelineStats.framesDeferred++;
+    }
+    vTaskDelay(pdMS_TO_TICKS((remaining + 999) / 1000));
+  }
+}
+
+// Advance the deadline by whole periods - keeps the cadence fixed while
+// frames keep coming, and restarts it after an idle gap
+static void advanceDeadline()
+{
+  uint32_t period = outputPeriodUs();
+  uint32_t now = micros();
+  if (period == 0)
+  {
+    deadlineArmed = false;
+    return;
+  }
+
+  if (!deadlineArmed || (int32_t)(now - nextDeadlineUs) > (int32_t)period)
+  {
+    nextDeadlineUs = now + period;
+  }
+  else
+  {
+    nextDeadlineUs += period;
+  }
+  deadlineArmed = true;
+}
+
+// Unchanged frames are only sent for the periodic refresh, or when the pixel
+// correction changed since the strip was last written
+static bool outputNeeded(bool changed)
+{
+  unsigned long now = millis();
+  if (changed || !outputShown || FRAME_REFRESH_INTERVAL_MS == 0 ||
+      pixelKernelCorrectionId() != shownCorrectionId || now - lastOutputTime >= FRAME_REFRESH_INTERVAL_MS)
+  {
+    outputShown = true;
+    shownCorrectionId = pixelKernelCorrectionId();
+    lastOutputTime = now;
+    return true;
+  }
+  return false;
+}
+
+// Bring the blend buffers in line with the request, starting from the frame on the strip
+static bool updateInterpolation()
+{
+  bool active = blendOutput != NULL;
+  if (interpolationRequested == active)
+  {
+    return active;
+  }
+
+  if (!interpolationRequested)
+  {
+    freeBlendBuffers();
+    return false;
+  }
+
+  blendFrom = (uint8_t *)malloc(frameBytes);
+  blendOutput = (uint8_t *)malloc(frameBytes);
+  if (blendFrom == NULL || blendOutput == NULL)
+  {
+    logRingWrite(LOG_LEVEL_ERROR, "Interpolation buffers could not be allocated (%u bytes)", frameBytes * 2);
+    freeBlendBuffers();
+    interpolationRequested = false;
+    return false;
+  }
+
+  memcpy(blendOutput, frontBuffer, frameBytes);
+  frameIntervalUs = 0;
+  lastArrivalUs = micros();
+  return true;
+}
+
+// A new frame is on the front buffer - fade to it from what the strip shows now,
+// over the smoothed frame interval (or cut straight to it after an idle gap)
+static void startBlend(bool changed)
+{
+  uint32_t now = micros();
+  uint32_t interval = now - lastArrivalUs;
+  bool idle = interval > FRAME_INTERPOLATION_MAX_INTERVAL_MS * 1000UL;
+  lastArrivalUs = now;
+
+  if (!idle)
+  {
+    frameIntervalUs = frameIntervalUs ? (frameIntervalUs * 3 + interval) / 4 : interval;
+  }
+
+  // A retransmission keeps the running blend going towards the same picture
+  if (!changed)
+  {
+    return;
+  }
+
+  memcpy(blendFrom, blendOutput, frameBytes);
+  blendStartUs = now;
+  blendDurationUs = idle ? 0 : frameIntervalUs;
+  blending = true;
+}
+
+// Next blended frame into blendOutput; the blend ends once the target is reached
+static void renderBlend()
+{
+  uint32_t elapsed = micros() - blendStartUs;
+  uint16_t weight = 256;
+  if (blendDurationUs > 0 && elapsed < blendDurationUs)
+  {
+    weight = (uint16_t)(((uint64_t)elapsed << 8) / blendDurationUs);
+  }
+
+  // Bit-reversed counter: successive frames spread their rounding evenly
+  uint8_t dither = 0;
+#if FRAME_INTERPOLATION_DITHER
+  uint8_t step = ditherStep++;
+  step = (step & 0xF0) >> 4 | (step & 0x0F) << 4;
+  step = (step & 0xCC) >> 2 | (step & 0x33) << 2;
+  dither = (step & 0xAA) >> 1 | (step & 0x55) << 1;
+#endif
+
+  pixelLerp(blendFrom, frontBuffer, blendOutput, frameBytes, weight, dither);
+  if (weight == 256)
+  {
+    blending = false;
+  }
+}
+
+static void renderTask(void *parameter)
+{
+  logRingWrite(LOG_LEVEL_INFO, "Render task started on core %d", xPortGetCoreID());
+
+  while (pipelineRunning)
+  {
+    // Switching interpolation on or off allocates; the rest of a pass must not
+    heapMonitorSetPath(HEAP_PATH_NONE);
+    bool interpolating = updateInterpolation();
+    heapMonitorSetPath(HEAP_PATH_RENDER);
+
+    // Sleep until a frame is latched or the assembly in progress times out.
+    // A running blend only waits for its next refresh slot.
+    ulTaskNotifyTake(pdTRUE, (interpolating && blending) ? 0 : assemblyWait());
+    if (!pipelineRunning)
+    {
+      break;
+    }
+
+    // Hold a ready frame until its refresh slot - newer frames coalesce into it
+    if (frameReady || (interpolating && blending))
+    {
+      waitForDeadline();
+    }
+
+    // Some universes never arrived (or the ArtSync was lost) - show what we have.
+    // A writer in the middle of a copy finishes first; the next pass retries.
+    if (!frameReady && pendingUniverses != 0 && millis() - assemblyStartTime >= FRAME_ASSEMBLY_TIMEOUT_MS &&
+        xSemaphoreTake(writerMutex, 0) == pdTRUE)
+    {
+      portENTER_CRITICAL(&frameMux);
+      if (!frameReady && pendingUniverses != 0)
+      {
+        pipelineStats.framesIncomplete++;
+        latchFrame();
+      }
+      portEXIT_CRITICAL(&frameMux);
+      xSemaphoreGive(writerMutex);
+    }
+
+    bool haveFrame = false;
+    bool changed = false;
+    portENTER_CRITICAL(&frameMux);
+    if (frameReady)
+    {
+      uint8_t *previousFront = frontBuffer;
+      frontBuffer = readyBuffer;
+      readyBuffer = previousFront;
+      frameReady = false;
+      haveFrame = true;
+      changed = readyChanged;
+      readyChanged = false;
+    }
+    portEXIT_CRITICAL(&frameMux);
+
+    // The front buffer is owned by this task until the next swap
+    if (interpolating && outputCallback != NULL)
+    {
+      if (haveFrame)
+      {
+        startBlend(changed);
+      }
+
+      if (blending)
+      {
+        renderBlend();
+        outputNeeded(true);
+        advanceDeadline();
+        outputCallback(blendOutput, frameBytes);
+        pipelineStats.framesRendered++;
+        pipelineStats.framesInterpolated++;
+      }
+      else if (haveFrame && outputNeeded(changed))
+      {
+        advanceDeadline();
+        outputCallback(blendOutput, frameBytes);
+        pipelineStats.framesRendered++;
+      }
+      else if (haveFrame)
+      {
+        pipelineStats.framesUnchanged++;
+      }
+    }
+    else if (haveFrame && outputCallback != NULL)
+    {
+      if (outputNeeded(changed))
+      {
+        advanceDeadline();
+        outputCallback(frontBuffer, frameBytes);
+        pipelineStats.framesRendered++;
+      }
+      else
+      {
+        pipelineStats.framesUnchanged++;
+      }
+    }
+  }
+
+  heapMonitorSetPath(HEAP_PATH_NONE);
+  renderTaskHandle = NULL;
+  vTaskDelete(NULL);
+}
+
+bool framePipelineBegin(uint16_t numPixels, FrameOutputCallback output)
+{
+  if (pipelineRunning)
+  {
+    framePipelineEnd();
+  }
+
+  if (writerMutex == NULL)
+  {
+    writerMutex = xSemaphoreCreateMutex();
+    if (writerMutex == NULL)
+    {
+      debugLog("ERROR: Frame pipeline mutex could not be created");
+      return false;
+    }
+  }
+
+  frameBytes = (uint32_t)numPixels * FRAME_CHANNELS_PER_PIXEL;
+  for (int i = 0; i < 3; i++)
+  {
+    frameBuffers[i] = (uint8_t *)calloc(frameBytes, 1);
+    if (frameBuffers[i] == NULL)
+    {
+      debugLog("ERROR: Frame buffer allocation failed (" + String(frameBytes * 3) + " bytes)");
+      freeFrameBuffers();
+      return false;
+    }
+  }
+
+  frontBuffer = frameBuffers[0];
+  readyBuffer = frameBuffers[1];
+  backBuffer = frameBuffers[2];
+  backNeedsSync = false;
+  frameReady = false;
+  backChanged = false;
+  readyChanged = false;
+  outputShown = false;
+  pendingUniverses = 0;
+  syncSeen = false;
+  outputCallback = output;
+  pipelineStats = FramePipelineStats();
+  deadlineArmed = false;
+  pipelineRunning = true;
+
+  BaseType_t result = xTaskCreatePinnedToCore(
+      renderTask,             // Task function
+      "RenderTask",           // Task name
+      RENDER_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                   // Task parameter
+      LED_TASK_PRIORITY,      // Task priority
+      &renderTaskHandle,      // Task handle
+      LED_CONTROL_CORE        // Core to run the task on
+  );
+
+  if (result != pdPASS)
+  {
+    debugLog("ERROR: Failed to create render task");
+    pipelineRunning = false;
+    freeFrameBuffers();
+    return false;
+  }
+
+  debugLog("Frame pipeline started: " + String(numPixels) + " pixels, render task on core " + String(LED_CONTROL_CORE));
+  return true;
+}
+
+void framePipelineEnd()
+{
+  if (!pipelineRunning)
+  {
+    return;
+  }
+
+  // Let the render task finish its current frame and exit on its own
+  pipelineRunning = false;
+  notifyRenderTask();
+  while (renderTaskHandle != NULL)
+  {
+    delay(1);
+  }
+
+  // Writers see the stopped pipeline once they get the back buffer
+  xSemaphoreTake(writerMutex, portMAX_DELAY);
+  portENTER_CRITICAL(&frameMux);
+  frontBuffer = readyBuffer = backBuffer = NULL;
+  frameReady = false;
+  pendingUniverses = 0;
+  portEXIT_CRITICAL(&frameMux);
+  xSemaphoreGive(writerMutex);
+
+  freeFrameBuffers();
+  freeBlendBuffers();
+  frameBytes = 0;
+
+  debugLog("Frame pipeline stopped");
+}
+
+bool framePipelineRunning()
+{
+  return pipelineRunning;
+}
+
+bool framePipelineWrite(uint16_t pixelOffset, const uint8_t *data, uint16_t numChannels)
+{
+  if (!pipelineRunning)
+  {
+    return false;
+  }
+
+  uint32_t start = (uint32_t)pixelOffset * FRAME_CHANNELS_PER_PIXEL;
+  bool written = false;
+
+  if (!claimBackBuffer())
+  {
+    return false;
+  }
+  if (start < frameBytes)
+  {
+    uint32_t length = numChannels;
+    if (start + length > frameBytes)
+    {
+      length = frameBytes - start;
+    }
+
+    syncBackBuffer();
+    publishChange(!backChanged && memcmp(backBuffer + start, data, length) != 0);
+    memcpy(backBuffer + start, data, length);
+    written = true;
+  }
+  releaseBackBuffer();
+
+  return written;
+}
+
+void framePipelineFill(uint8_t r, uint8_t g, uint8_t b)
+{
+  if (!pipelineRunning)
+  {
+    return;
+  }
+
+  if (!claimBackBuffer())
+  {
+    return;
+  }
+  for (uint32_t i = 0; i + 2 < frameBytes; i += FRAME_CHANNELS_PER_PIXEL)
+  {
+    backBuffer[i] = r;
+    backBuffer[i + 1] = g;
+    backBuffer[i + 2] = b;
+  }
+  backNeedsSync = false;
+  publishChange(true);
+  releaseBackBuffer();
+}
+
+bool framePipelineMapUniverses(uint16_t firstUniverse, uint8_t count, uint16_t pixelsPerUniverse)
+{
+  if (count == 0 || count > FRAME_MAX_UNIVERSES || pixelsPerUniverse == 0 ||
+      pixelsPerUniverse > FRAME_PIXELS_PER_UNIVERSE)
+  {
+    debugLog("ERROR: Invalid universe map (" + String(count) + " universes x " + String(pixelsPerUniverse) + " pixels)");
+    return false;
+  }
+
+  portENTER_CRITICAL(&frameMux);
+  universeBase = firstUniverse;
+  universeCount = count;
+  universePixels = pixelsPerUniverse;
+  for (uint8_t i = 0; i < count; i++)
+  {
+    universeOffsets[i] = i * pixelsPerUniverse;
+  }
+  expectedUniverses = (1UL << count) - 1;
+  pendingUniverses = 0;
+  portEXIT_CRITICAL(&frameMux);
+
+  debugLog("Universe map: " + String(firstUniverse) + "-" + String(firstUniverse + count - 1) +
+           ", " + String(pixelsPerUniverse) + " pixels each");
+  return true;
+}
+
+bool framePipelineMapUniverse(uint16_t universe, uint16_t pixelOffset)
+{
+  uint16_t slot = universe - universeBase;
+  if (slot >= universeCount)
+  {
+    return false;
+  }
+
+  portENTER_CRITICAL(&frameMux);
+  universeOffsets[slot] = pixelOffset;
+  portEXIT_CRITICAL(&frameMux);
+  return true;
+}
+
+uint16_t framePipelineUniverseOffset(uint16_t universe)
+{
+  // Unsigned wrap makes universes below the base fall out of range as well
+  uint16_t slot = universe - universeBase;
+  if (slot >= universeCount)
+  {
+    return FRAME_UNMAPPED_OFFSET;
+  }
+  return universeOffsets[slot];
+}
+
+bool framePipelineWriteUniverse(uint16_t universe, const uint8_t *data, uint16_t numChannels)
+{
+  uint16_t slot = universe - universeBase;
+  if (!pipelineRunning || slot >= universeCount)
+  {
+    return false;
+  }
+
+  // Keep a long universe from spilling into the region of the next one
+  uint32_t start = (uint32_t)universeOffsets[slot] * FRAME_CHANNELS_PER_PIXEL;
+  uint32_t length = min((uint32_t)numChannels, (uint32_t)universePixels * FRAME_CHANNELS_PER_PIXEL);
+  uint32_t universeBit = 1UL << slot;
+  unsigned long now = millis();
+  bool latched = false;
+  bool started = false;
+
+  if (!claimBackBuffer())
+  {
+    return false;
+  }
+  if (start < frameBytes)
+  {
+    // A universe repeating before the frame was latched means the sender has
+    // moved on to the next frame - finish the current one without it
+    if (pendingUniverses & universeBit)
+    {
+      portENTER_CRITICAL(&frameMux);
+      pipelineStats.framesIncomplete++;
+      latchFrame();
+      portEXIT_CRITICAL(&frameMux);
+      latched = true;
+    }
+
+    // The render task sleeps until this assembly's timeout from here on
+    if (pendingUniverses == 0)
+    {
+      assemblyStartTime = now;
+      started = true;
+    }
+
+    if (start + length > frameBytes)
+    {
+      length = frameBytes - start;
+    }
+    syncBackBuffer();
+    publishChange(!backChanged && memcmp(backBuffer + start, data, length) != 0);
+    memcpy(backBuffer + start, data, length);
+    pendingUniverses |= universeBit;
+
+    // Without ArtSync a frame is complete once every mapped universe has arrived
+    if (pendingUniverses == expectedUniverses && !syncActive(now))
+    {
+      portENTER_CRITICAL(&frameMux);
+      latchFrame();
+      portEXIT_CRITICAL(&frameMux);
+      latched = true;
+    }
+  }
+  releaseBackBuffer();
+
+  if (latched || started)
+  {
+    notifyRenderTask();
+  }
+  return true;
+}
+
+void framePipelineSync()
+{
+  if (!pipelineRunning)
+  {
+    return;
+  }
+
+  bool latched = false;
+  if (!claimBackBuffer())
+  {
+    return;
+  }
+  portENTER_CRITICAL(&frameMux);
+  syncSeen = true;
+  lastSyncTime = millis();
+  if (pendingUniverses != 0)
+  {
+    pipelineStats.framesSynced++;
+    latchFrame();
+    latched = true;
+  }
+  portEXIT_CRITICAL(&frameMux);
+  releaseBackBuffer();
+
+  if (latched)
+  {
+    notifyRenderTask();
+  }
+}
+
+void framePipelinePresent()
+{
+  if (!pipelineRunning)
+  {
+    return;
+  }
+
+  if (!claimBackBuffer())
+  {
+    return;
+  }
+  portENTER_CRITICAL(&frameMux);
+  latchFrame();
+  portEXIT_CRITICAL(&frameMux);
+  releaseBackBuffer();
+
+  notifyRenderTask();
+}
+
+void framePipelineSetMaxFps(uint16_t fps)
+{
+  fps = min(fps, (uint16_t)FRAME_MAX_FPS_LIMIT);
+  framePeriodUs = fps ? 1000000UL / fps : 0;
+}
+
+uint16_t framePipelineMaxFps()
+{
+  uint32_t period = framePeriodUs;
+  return period ? (1000000UL + period / 2) / period : 0;
+}
+
+void framePipelineSetInterpolation(bool enable)
+{
+  interpolationRequested = enable;
+  notifyRenderTask();
+}
+
+bool framePipelineInterpolation()
+{
+  return interpolationRequested;
+}
+
+void framePipelineGetStats(FramePipelineStats *stats)
+{
+  portENTER_CRITICAL(&frameMux);
+  *stats = pipelineStats;
+  portEXIT_CRITICAL(&frameMux);
+}
@@ -0,0 +1,113 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Task placement - these mirror src/Config.h so the sketch folders build without it
+#ifndef LED_CONTROL_CORE
+#define LED_CONTROL_CORE 1
+#endif
+#ifndef LED_TASK_PRIORITY
+#define LED_TASK_PRIORITY 4
+#endif
+
+#define FRAME_CHANNELS_PER_PIXEL 3
+#define RENDER_TASK_STACK_SIZE 4096
+
+// Universe map limits - one DMX universe carries 170 full RGB pixels
+#define FRAME_MAX_UNIVERSES 12
+#define FRAME_PIXELS_PER_UNIVERSE 170
+#define FRAME_UNMAPPED_OFFSET 0xFFFF
+
+// Frame assembly - a partial frame is shown after this long without completing,
+// and ArtSync mode lapses once no OpSync has been seen for the holdoff (Art-Net 4: 4 s)
+#define FRAME_ASSEMBLY_TIMEOUT_MS 50
+#define FRAME_SYNC_HOLDOFF_MS 4000
+
+// Render scheduler - at most this many frames per second reach the LEDs (0 = as fast as they arrive)
+#define FRAME_DEFAULT_MAX_FPS 60
+#define FRAME_MAX_FPS_LIMIT 250
+
+// Frames identical to the one on the strip are not sent again, except this often
+// so a strip that glitched recovers (0 sends every frame)
+#ifndef FRAME_REFRESH_INTERVAL_MS
+#define FRAME_REFRESH_INTERVAL_MS 1000
+#endif
+
+// Temporal interpolation - frames further apart than this are cut to, not blended
+#define FRAME_INTERPOLATION_MAX_INTERVAL_MS 250
+#ifndef FRAME_INTERPOLATION_DITHER
+#define FRAME_INTERPOLATION_DITHER 1
+#endif
+
+// Output stage, called from the render task with the latest complete frame.
+// The frame is packed RGB triplets (DMX channel order) and stays valid until the call returns.
+typedef void (*FrameOutputCallback)(const uint8_t *frame, uint16_t numChannels);
+
+// Pipeline counters for status reporting
+struct FramePipelineStats
+{
+  uint32_t framesPresented = 0; // Frames handed over by receivers
+  uint32_t framesRendered = 0;  // Frames pushed to the output stage
+  uint32_t framesCoalesced = 0; // Frames replaced by a newer one before they were rendered
+  uint32_t framesIncomplete = 0; // Frames latched before every mapped universe arrived
+  uint32_t framesSynced = 0;     // Frames latched by an ArtSync packet
+  uint32_t framesDeferred = 0;   // Frames held back until the next refresh deadline
+  uint32_t framesUnchanged = 0;  // Frames skipped because they matched the shown one
+  uint32_t framesInterpolated = 0; // Blended frames sent while moving towards a received one
+};
+
+// Allocate front/ready/back buffers and start the render task on LED_CONTROL_CORE
+bool framePipelineBegin(uint16_t numPixels, FrameOutputCallback output);
+
+// Stop the render task and release the buffers
+void framePipelineEnd();
+
+bool framePipelineRunning();
+
+// Copy channel data into the back buffer at the given pixel offset.
+// Safe to call from the network task; never touches the LED hardware. Writers
+// take turns on the back buffer and copy with interrupts enabled.
+bool framePipelineWrite(uint16_t pixelOffset, const uint8_t *data, uint16_t numChannels);
+
+// Fill the whole back buffer with a single color
+void framePipelineFill(uint8_t r, uint8_t g, uint8_t b);
+
+// Map a contiguous universe range onto consecutive regions of the frame buffer.
+// Universe firstUniverse + i lands at pixel offset i * pixelsPerUniverse.
+bool framePipelineMapUniverses(uint16_t firstUniverse, uint8_t count, uint16_t pixelsPerUniverse = FRAME_PIXELS_PER_UNIVERSE);
+
+// Override the pixel offset of a single universe inside the mapped range
+bool framePipelineMapUniverse(uint16_t universe, uint16_t pixelOffset);
+
+// Pixel offset of a universe, or FRAME_UNMAPPED_OFFSET if it is outside the map (O(1) lookup)
+uint16_t framePipelineUniverseOffset(uint16_t universe);
+
+// Copy one universe of channel data into its mapped region of the back buffer.
+// The frame is latched once every mapped universe has arrived, unless ArtSync is
+// active, and ahead of time when a universe repeats. Returns false for universes outside the map.
+bool framePipelineWriteUniverse(uint16_t universe, const uint8_t *data, uint16_t numChannels);
+
+// ArtSync received - latch whatever has been assembled since the last frame
+void framePipelineSync();
+
+// Mark the back buffer as a complete frame and wake the render task
+void framePipelinePresent();
+
+// Cap the output refresh rate. Frames latched between deadlines are coalesced
+// (latest wins) and output is paced on a fixed period so the cadence stays even.
+void framePipelineSetMaxFps(uint16_t fps);
+uint16_t framePipelineMaxFps();
+
+// Temporal interpolation: each received frame is faded in from the one on the strip
+// over the measured frame interval, with blended frames sent at the max fps rate
+// (FRAME_MAX_FPS_LIMIT when uncapped). Costs one received frame of latency and
+// two extra frame buffers, allocated by the render task when it is switched on.
+void framePipelineSetInterpolation(bool enable);
+bool framePipelineInterpolation();
+
+void framePipelineGetStats(FramePipelineStats *stats);
+
+#endif // FRAME_PIPELINE_H
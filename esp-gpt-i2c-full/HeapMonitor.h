@@ -0,0 +1,75 @@
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Heap allocation accounting for the static memory budget: once the node is
+// ready, the packet, render, UART and status paths must not allocate. Tasks
+// declare which path they are on; with ESP-IDF heap hooks (CONFIG_HEAP_USE_HOOKS)
+// every allocation is counted, and those made by a task on a path after
+// heapMonitorSteadyState() are counted against that path. Without the hooks
+// only the heap's block counts are reported.
+
+#ifndef HEAP_MONITOR_ENABLED
+#define HEAP_MONITOR_ENABLED 1
+#endif
+
+#if HEAP_MONITOR_ENABLED && defined(CONFIG_HEAP_USE_HOOKS)
+#define HEAP_MONITOR_HOOKS 1
+#else
+#define HEAP_MONITOR_HOOKS 0
+#endif
+
+#define HEAP_MONITOR_MAX_TASKS 12
+
+enum HeapPath
+{
+  HEAP_PATH_NONE = 0,
+  HEAP_PATH_PACKET,  // ArtNet receive, in the lwIP / AsyncUDP task
+  HEAP_PATH_RENDER,  // Frame pipeline and local modes up to the strips
+  HEAP_PATH_UART,    // UART RX and command dispatch
+  HEAP_PATH_STATUS,  // Housekeeping, I2C register map and the OLED
+  HEAP_PATH_COUNT
+};
+
+struct HeapMonitorStats
+{
+  bool hooks;                           // Allocation counts below are live
+  bool steady;                          // heapMonitorSteadyState() was called
+  uint32_t allocs;                      // All allocations since boot
+  uint32_t frees;
+  uint32_t steadyAllocs;                // All allocations since the steady state, any task
+  uint32_t pathAllocs[HEAP_PATH_COUNT]; // Steady-state allocations per path - all 0 when the budget holds
+  uint32_t lastPathAllocSize;           // Size of the latest of those
+  uint8_t lastPath;
+  uint32_t freeBytes;
+  uint32_t minFreeBytes;
+  uint32_t largestFreeBlock;
+  uint32_t allocatedBlocks;
+  int32_t blocksSinceSteady;            // Change of the allocated block count
+};
+
+// Put the calling task on a path until it sets another one (HEAP_PATH_NONE to
+// leave). Cheap enough to wrap a single callback; blocking inside is fine.
+void heapMonitorSetPath(HeapPath path);
+
+// For tasks deleted by another task while on a path, so a new task reusing the
+// handle starts off the path
+void heapMonitorForgetTask(TaskHandle_t task);
+
+// Call once the node is up - path accounting starts here
+void heapMonitorSteadyState();
+
+void heapMonitorGetStats(HeapMonitorStats *stats);
+
+// Steady-state allocations summed over all paths
+uint32_t heapMonitorPathAllocs();
+
+const char *heapPathName(uint8_t path);
+
+// {"hooks":..,"allocs":..,"frees":..,"steadyAllocs":..,"paths":{"packet":..,..},"freeBytes":..,..}
+String heapMonitorJson();
+
+#endif // HEAP_MONITOR_H
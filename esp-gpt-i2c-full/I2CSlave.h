@@ -0,0 +1,97 @@
+#ifndef I2C_SLAVE_H
+#define I2C_SLAVE_H
+
+#include <Arduino.h>
+#include "driver/i2c.h"
+
+// Status endpoint for monitor MCUs (see code.py). Runs on its own I2C port so
+// the OLED keeps Wire; the driver ISR serves the bus, a task only reloads the
+// TX buffer when the master moves the register pointer.
+#ifndef I2C_SLAVE_ADDRESS
+#define I2C_SLAVE_ADDRESS 0x08
+#endif
+#ifndef I2C_SLAVE_SDA_PIN
+#define I2C_SLAVE_SDA_PIN 25
+#endif
+#ifndef I2C_SLAVE_SCL_PIN
+#define I2C_SLAVE_SCL_PIN 26
+#endif
+#define I2C_SLAVE_PORT I2C_NUM_1
+#define I2C_SLAVE_RX_BUFFER_SIZE 128
+#define I2C_SLAVE_TX_BUFFER_SIZE 256
+#define I2C_SLAVE_TASK_STACK_SIZE 2048
+#define I2C_SLAVE_TASK_PRIORITY 5
+#ifndef NETWORK_CORE
+#define NETWORK_CORE 0
+#endif
+
+// The register block is rebuilt at most this often, and by the I2C task itself
+// once nothing has published for I2C_SLAVE_STALE_MS (e.g. no frames in ArtNet mode)
+#define I2C_SLAVE_PUBLISH_MS 100
+#define I2C_SLAVE_STALE_MS 1000
+
+// Time the slave needs after a register write to reload its TX buffer
+#define I2C_SLAVE_PRELOAD_MS 2
+
+#define I2C_REGISTER_MAP_VERSION 1
+#define I2C_PREVIEW_PIXELS 8
+
+// Status flags (I2C_REG_FLAGS)
+#define I2C_FLAG_WIFI 0x01
+#define I2C_FLAG_ARTNET 0x02
+#define I2C_FLAG_SERIAL_STREAM 0x04
+#define I2C_FLAG_BENCHMARK 0x08
+#define I2C_FLAG_ERROR 0x80
+
+// Register map - write the register address, then read the block from it to the end
+// of the map (sizeof(I2CRegisterMap) - address bytes). Multi-byte values are little
+// endian. Writing two bytes after I2C_REG_PREVIEW_OFFSET moves the preview window;
+// such a write is not followed by a read.
+//
+// The ESP32 slave cannot stretch the clock while it reloads its TX buffer, so the
+// read must be a transaction of its own, started at least I2C_SLAVE_PRELOAD_MS
+// after the register write - a repeated-start read would clock out 0xFF. The
+// driver cannot drop bytes a master leaves unread, they would lead its next read,
+// so every read takes the whole remaining block and needs its own register write.
+struct __attribute__((packed)) I2CRegisterMap
+{
+  uint8_t version;          // 0x00 I2C_REGISTER_MAP_VERSION
+  uint8_t sequence;         // 0x01 Incremented on every publish
+  uint8_t flags;            // 0x02 I2C_FLAG_*
+  uint8_t mode;             // 0x03 Sketch-defined operating mode
+  uint8_t brightness;       // 0x04
+  uint8_t lastError;        // 0x05 ERR_* code, 0 = none
+  uint16_t fpsX10;          // 0x06 Rendered frames per second x10
+  uint32_t artnetPackets;   // 0x08
+  uint32_t framesRendered;  // 0x0C
+  uint32_t framesDropped;   // 0x10 Coalesced before they were shown
+  uint32_t malformed;       // 0x14 Malformed ArtNet packets
+  uint32_t outOfUniverse;   // 0x18 ArtDmx for universes outside the map
+  uint32_t freeHeap;        // 0x1C
+  uint32_t uptime;          // 0x20 Seconds
+  uint16_t previewOffset;   // 0x24 First pixel of the preview window
+  uint8_t previewCount;     // 0x26 Valid pixels in preview
+  uint8_t reserved;         // 0x27
+  uint8_t preview[I2C_PREVIEW_PIXELS * 3]; // 0x28 RGB
+};
+
+#define I2C_REG_VERSION 0x00
+#define I2C_REG_FLAGS 0x02
+#define I2C_REG_FPS 0x06
+#define I2C_REG_COUNTERS 0x08
+#define I2C_REG_PREVIEW_OFFSET 0x24
+#define I2C_REG_PREVIEW 0x28
+
+// Install the slave driver and start the register task
+bool i2cSlaveBegin();
+void i2cSlaveEnd();
+bool i2cSlaveRunning();
+
+// Values only the sketch knows - cheap, only stored until the next publish
+void i2cSlaveSetStatus(uint8_t flags, uint8_t mode, uint8_t brightness, uint8_t lastError);
+
+// Call from the output stage with every frame shown (RGB triplets). Counts fps and
+// republishes the register block every I2C_SLAVE_PUBLISH_MS.
+void i2cSlaveFrameShown(const uint8_t *frame, uint16_t numChannels);
+
+#endif // I2C_SLAVE_H
@@ -0,0 +1,224 @@
+#include "LedLayout.h"
+#include "ESP_GPT_I2C_Common.h"
+#include "PixelKernel.h"
+
+// Source channel (0=R, 1=G, 2=B) for each wire byte, indexed by LedColorOrder
+static const uint8_t colorOrderChannels[LED_ORDER_COUNT][3] = {
+    {0, 1, 2}, // RGB
+    {0, 2, 1}, // RBG
+    {1, 0, 2}, // GRB
+    {1, 2, 0}, // GBR
+    {2, 0, 1}, // BRG
+    {2, 1, 0}, // BGR
+};
+
+static const char *colorOrderNames[LED_ORDER_COUNT] = {"RGB", "RBG", "GRB", "GBR", "BRG", "BGR"};
+
+// Stored record: version, output count, then pin/order/length/offset per output
+#define LED_LAYOUT_RECORD_SIZE 6
+#define LED_LAYOUT_BLOB_SIZE (2 + MAX_LED_STRIPS * LED_LAYOUT_RECORD_SIZE)
+
+void ledLayoutSetUniform(LedLayout *layout, const int *pins, uint8_t numStrips, uint16_t ledsPerStrip)
+{
+  numStrips = min((int)numStrips, MAX_LED_STRIPS);
+  layout->numOutputs = 0;
+
+  // Unassigned pins are skipped, the remaining strips stay contiguous in the buffer
+  for (uint8_t i = 0; i < numStrips; i++)
+  {
+    if (pins[i] < 0)
+    {
+      continue;
+    }
+
+    LedOutputConfig &output = layout->outputs[layout->numOutputs];
+    output.pin = pins[i];
+    output.colorOrder = LED_ORDER_GRB;
+    output.length = ledsPerStrip;
+    output.startOffset = layout->numOutputs * ledsPerStrip;
+    layout->numOutputs++;
+  }
+}
+
+bool ledLayoutLoad(LedLayout *layout)
+{
+  uint8_t blob[LED_LAYOUT_BLOB_SIZE];
+
+  preferences.begin(LED_LAYOUT_NAMESPACE, true);
+  size_t length = preferences.getBytes("layout", blob, sizeof(blob));
+  preferences.end();
+
+  if (length < 2 || blob[0] != LED_LAYOUT_VERSION || blob[1] > MAX_LED_STRIPS ||
+      length < 2 + (size_t)blob[1] * LED_LAYOUT_RECORD_SIZE)
+  {
+    return false;
+  }
+
+  LedLayout loaded;
+  loaded.numOutputs = blob[1];
+  for (uint8_t i = 0; i < loaded.numOutputs; i++)
+  {
+    const uint8_t *record = blob + 2 + i * LED_LAYOUT_RECORD_SIZE;
+    loaded.outputs[i].pin = (int8_t)record[0];
+    loaded.outputs[i].colorOrder = record[1];
+    loaded.outputs[i].length = record[2] | (record[3] << 8);
+    loaded.outputs[i].startOffset = record[4] | (record[5] << 8);
+  }
+
+  if (!ledLayoutValidate(&loaded))
+  {
+    debugLog("Stored LED layout is invalid - ignoring it");
+    return false;
+  }
+
+  *layout = loaded;
+  return true;
+}
+
+bool ledLayoutSave(const LedLayout *layout)
+{
+  uint8_t blob[LED_LAYOUT_BLOB_SIZE];
+  blob[0] = LED_LAYOUT_VERSION;
+  blob[1] = layout->numOutputs;
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    uint8_t *record = blob + 2 + i * LED_LAYOUT_RECORD_SIZE;
+    record[0] = (uint8_t)layout->outputs[i].pin;
+    record[1] = layout->outputs[i].colorOrder;
+    record[2] = layout->outputs[i].length & 0xFF;
+    record[3] = layout->outputs[i].length >> 8;
+    record[4] = layout->outputs[i].startOffset & 0xFF;
+    record[5] = layout->outputs[i].startOffset >> 8;
+  }
+
+  preferences.begin(LED_LAYOUT_NAMESPACE, false);
+  size_t written = preferences.putBytes("layout", blob, 2 + layout->numOutputs * LED_LAYOUT_RECORD_SIZE);
+  preferences.end();
+
+  return written > 0;
+}
+
+// GPIOs that can drive a strip - 34-39 are input-only, 6-11 belong to the SPI flash
+static bool ledPinCanDrive(int8_t pin)
+{
+  return (pin >= 0 && pin <= 5) || (pin >= 12 && pin <= 19) || (pin >= 21 && pin <= 23) ||
+         (pin >= 25 && pin <= 27) || pin == 32 || pin == 33;
+}
+
+bool ledLayoutValidate(const LedLayout *layout)
+{
+  if (layout->numOutputs == 0 || layout->numOutputs > MAX_LED_STRIPS)
+  {
+    debugLog("LED layout: " + String(layout->numOutputs) + " outputs, expected 1-" + String(MAX_LED_STRIPS));
+    return false;
+  }
+
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    const LedOutputConfig &output = layout->outputs[i];
+    if (!ledPinCanDrive(output.pin))
+    {
+      debugLog("LED layout: output " + String(i + 1) + " has invalid pin " + String(output.pin));
+      return false;
+    }
+    if (output.colorOrder >= LED_ORDER_COUNT)
+    {
+      debugLog("LED layout: output " + String(i + 1) + " has invalid color order");
+      return false;
+    }
+    if (output.length == 0 || output.length > MAX_LEDS_PER_STRIP ||
+        (uint32_t)output.startOffset + output.length > MAX_LEDS)
+    {
+      debugLog("LED layout: output " + String(i + 1) + " covers pixels " + String(output.startOffset) + "+" +
+               String(output.length) + ", limit is " + String(MAX_LEDS));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ledLayoutEquals(const LedLayout *a, const LedLayout *b)
+{
+  if (a->numOutputs != b->numOutputs)
+  {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < a->numOutputs; i++)
+  {
+    const LedOutputConfig &x = a->outputs[i];
+    const LedOutputConfig &y = b->outputs[i];
+    if (x.pin != y.pin || x.colorOrder != y.colorOrder || x.length != y.length || x.startOffset != y.startOffset)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint16_t ledLayoutPixelCount(const LedLayout *layout)
+{
+  uint16_t count = 0;
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    count = max(count, (uint16_t)(layout->outputs[i].startOffset + layout->outputs[i].length));
+  }
+  return count;
+}
+
+uint16_t ledLayoutMaxLength(const LedLayout *layout)
+{
+  uint16_t length = 0;
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    length = max(length, layout->outputs[i].length);
+  }
+  return length;
+}
+
+uint16_t ledLayoutWireCount(const LedLayout *layout)
+{
+  uint16_t count = 0;
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    count += layout->outputs[i].length;
+  }
+  return count;
+}
+
+void ledLayoutPack(const LedLayout *layout, const uint8_t *pixels, uint16_t numPixels, uint8_t *wire, uint16_t stride)
+{
+  uint32_t wirePixel = 0;
+
+  // One correction for every strip of the frame
+  pixelKernelApplyCorrection();
+  for (uint8_t i = 0; i < layout->numOutputs; i++)
+  {
+    const LedOutputConfig &output = layout->outputs[i];
+    uint8_t *dst = wire + (stride ? (uint32_t)i * stride : wirePixel) * 3;
+    wirePixel += output.length;
+
+    // Pixels beyond the received frame are sent dark
+    uint16_t available = output.startOffset < numPixels ? min(output.length, (uint16_t)(numPixels - output.startOffset)) : 0;
+    pixelConvert(pixels + (uint32_t)output.startOffset * 3, dst, available, colorOrderChannels[output.colorOrder]);
+    memset(dst + available * 3, 0, (output.length - available) * 3);
+  }
+}
+
+const char *ledColorOrderName(uint8_t order)
+{
+  return order < LED_ORDER_COUNT ? colorOrderNames[order] : "?";
+}
+
+uint8_t ledColorOrderFromName(const String &name)
+{
+  for (uint8_t i = 0; i < LED_ORDER_COUNT; i++)
+  {
+    if (name.equalsIgnoreCase(colorOrderNames[i]))
+    {
+      return i;
+    }
+  }
+  return LED_ORDER_GRB;
+}
@@ -0,0 +1,78 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <Arduino.h>
+
+// Binary log ring - writers claim a slot with one atomic index bump and store a
+// timestamp, level, format pointer and raw arguments; no String, heap or lock is
+// involved. A low-priority task formats the records and writes them to Serial.
+
+// Levels mirror src/Config.h
+#ifndef LOG_LEVEL_VERBOSE
+#define LOG_LEVEL_VERBOSE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARNING 3
+#define LOG_LEVEL_ERROR 4
+#endif
+
+#ifndef NETWORK_CORE
+#define NETWORK_CORE 0
+#endif
+
+#define LOG_RING_SIZE 64 // Records, must be a power of two
+#define LOG_RING_MAX_ARGS 4
+#define LOG_RING_TEXT_SIZE 72 // Inline copy for preformatted text, longer messages are cut
+#define LOG_RING_LINE_SIZE 128
+#define LOG_RING_TASK_STACK_SIZE 3072
+#define LOG_RING_TASK_PRIORITY 1
+#define LOG_RING_FLUSH_MS 20
+
+// Record argument marker for inline text instead of format + arguments
+#define LOG_RING_TEXT 0xFF
+
+struct LogRecord
+{
+  uint32_t sequence; // Ring index + 1 once the record is complete, 0 while it is written
+  uint32_t timestamp;
+  uint8_t level;
+  uint8_t argCount;   // Or LOG_RING_TEXT
+  const char *format; // String literal - its address doubles as the format id
+  union
+  {
+    uint32_t args[LOG_RING_MAX_ARGS];
+    char text[LOG_RING_TEXT_SIZE];
+  };
+};
+
+// Start the formatter task. Records written before this are kept and printed once it runs.
+bool logRingBegin();
+
+// Deferred printf: the format must be a string literal and every argument a 32-bit
+// integer or a pointer to a string that outlives the record (no floats, no temporaries).
+// Safe from any task; formatting happens later in the formatter task.
+void logRingWrite(uint8_t level, const char *format, ...);
+
+// Copy already formatted text into the record
+void logRingText(uint8_t level, const char *text);
+
+// Format everything pending to Serial now, e.g. right before a restart
+void logRingFlush();
+
+// Visit up to count of the most recent records, oldest first, as formatted lines
+typedef void (*LogRingLineCallback)(const char *line, void *context);
+uint16_t logRingRecent(uint16_t count, LogRingLineCallback callback, void *context);
+
+// Cursor access for streaming: records [logRingOldest(count), logRingHead()) are the
+// most recent ones. logRingLine() formats one of them and returns false if it has
+// been overwritten (or is still being written) in the meantime.
+uint32_t logRingHead();
+uint32_t logRingOldest(uint16_t count);
+bool logRingLine(uint32_t index, char *line, size_t size);
+
+// Records overwritten before the formatter task reached them
+uint32_t logRingDropped();
+
+const char *logLevelName(uint8_t level);
+
+#endif // LOG_RING_H
@@ -0,0 +1,187 @@
+#include "PerfCounters.h"
+#include "ESP_GPT_I2C_Common.h"
+
+struct PerfHistogram
+{
+  uint32_t count;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+  uint32_t buckets[PERF_HISTOGRAM_BUCKETS];
+};
+
+static PerfHistogram histograms[PERF_STAGE_COUNT];
+static volatile uint32_t malformedPackets = 0;
+static volatile uint32_t outOfUniversePackets = 0;
+static portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *stageNames[PERF_STAGE_COUNT] = {"parse", "convert", "show", "effect"};
+
+// Log-linear bucket: the power of two selects the group, the next bits the sub-bucket
+static uint32_t bucketIndex(uint32_t cycles)
+{
+  if (cycles < (1U << PERF_SUB_BUCKET_BITS))
+  {
+    return cycles;
+  }
+
+  uint32_t msb = 31 - __builtin_clz(cycles);
+  uint32_t sub = (cycles >> (msb - PERF_SUB_BUCKET_BITS)) & ((1U << PERF_SUB_BUCKET_BITS) - 1);
+  return ((msb - PERF_SUB_BUCKET_BITS + 1) << PERF_SUB_BUCKET_BITS) + sub;
+}
+
+// Largest cycle count that still falls into the bucket
+static uint32_t bucketUpperBound(uint32_t index)
+{
+  if (index < (1U << PERF_SUB_BUCKET_BITS))
+  {
+    return index;
+  }
+
+  uint32_t msb = (index >> PERF_SUB_BUCKET_BITS) + PERF_SUB_BUCKET_BITS - 1;
+  uint32_t sub = index & ((1U << PERF_SUB_BUCKET_BITS) - 1);
+  uint64_t lower = (uint64_t)((1U << PERF_SUB_BUCKET_BITS) + sub) << (msb - PERF_SUB_BUCKET_BITS);
+  uint64_t upper = lower + (1ULL << (msb - PERF_SUB_BUCKET_BITS)) - 1;
+  return upper > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)upper;
+}
+
+void perfRecord(PerfStage stage, uint32_t startCycles)
+{
+#if PERF_COUNTERS_ENABLED
+  // Unsigned subtraction handles the counter wrapping (every ~18 s at 240 MHz)
+  uint32_t cycles = ESP.getCycleCount() - startCycles;
+  PerfHistogram &histogram = histograms[stage];
+
+  portENTER_CRITICAL(&perfMux);
+  if (histogram.count == 0 || cycles < histogram.minCycles)
+  {
+    histogram.minCycles = cycles;
+  }
+  if (cycles > histogram.maxCycles)
+  {
+    histogram.maxCycles = cycles;
+  }
+  histogram.count++;
+  histogram.totalCycles += cycles;
+  histogram.buckets[bucketIndex(cycles)]++;
+  portEXIT_CRITICAL(&perfMux);
+#endif
+}
+
+void perfCountMalformed()
+{
+  malformedPackets++;
+}
+
+void perfCountOutOfUniverse()
+{
+  outOfUniversePackets++;
+}
+
+void perfGetSummary(PerfStage stage, PerfStageSummary *summary)
+{
+  PerfHistogram snapshot;
+  portENTER_CRITICAL(&perfMux);
+  snapshot = histograms[stage];
+  portEXIT_CRITICAL(&perfMux);
+
+  *summary = PerfStageSummary();
+  if (snapshot.count == 0)
+  {
+    return;
+  }
+
+  // Walk the histogram up to the 99th percentile sample
+  uint32_t target = snapshot.count - snapshot.count / 100;
+  uint32_t seen = 0;
+  uint32_t p99Cycles = snapshot.maxCycles;
+  for (uint32_t i = 0; i < PERF_HISTOGRAM_BUCKETS; i++)
+  {
+    seen += snapshot.buckets[i];
+    if (seen >= target)
+    {
+      p99Cycles = min(bucketUpperBound(i), snapshot.maxCycles);
+      break;
+    }
+  }
+
+  float cyclesPerUs = ESP.getCpuFreqMHz();
+  summary->count = snapshot.count;
+  summary->minUs = snapshot.minCycles / cyclesPerUs;
+  summary->avgUs = (float)(snapshot.totalCycles / snapshot.count) / cyclesPerUs;
+  summary->maxUs = snapshot.maxCycles / cyclesPerUs;
+  summary->p99Us = p99Cycles / cyclesPerUs;
+}
+
+uint32_t perfMalformedCount()
+{
+  return malformedPackets;
+}
+
+uint32_t perfOutOfUniverseCount()
+{
+  return outOfUniversePackets;
+}
+
+const char *perfStageName(PerfStage stage)
+{
+  return stage < PERF_STAGE_COUNT ? stageNames[stage] : "?";
+}
+
+void perfReset()
+{
+  portENTER_CRITICAL(&perfMux);
+  memset(histograms, 0, sizeof(histograms));
+  malformedPackets = 0;
+  outOfUniversePackets = 0;
+  portEXIT_CRITICAL(&perfMux);
+}
+
+String perfStageJson(const PerfStageSummary &summary)
+{
+  String json = "{\"count\":" + String(summary.count);
+  json += ",\"minUs\":" + String(summary.minUs, 2);
+  json += ",\"avgUs\":" + String(summary.avgUs, 2);
+  json += ",\"maxUs\":" + String(summary.maxUs, 2);
+  json += ",\"p99Us\":" + String(summary.p99Us, 2) + "}";
+  return json;
+}
+
+String perfStatsJson()
+{
+  FramePipelineStats frames;
+  framePipelineGetStats(&frames);
+
+  String json = "{\"uptimeMs\":" + String(millis());
+  json += ",\"stages\":{";
+  for (int i = 0; i < PERF_STAGE_COUNT; i++)
+  {
+    PerfStageSummary summary;
+    perfGetSummary((PerfStage)i, &summary);
+    if (i > 0)
+      json += ",";
+    json += "\"" + String(perfStageName((PerfStage)i)) + "\":" + perfStageJson(summary);
+  }
+  json += "},\"packets\":{";
+  json += "\"received\":" + String(state.artnetPacketCount);
+  json += ",\"malformed\":" + String(perfMalformedCount());
+  json += ",\"outOfUniverse\":" + String(perfOutOfUniverseCount());
+  json += "},\"frames\":{";
+  json += "\"presented\":" + String(frames.framesPresented);
+  json += ",\"rendered\":" + String(frames.framesRendered);
+  json += ",\"dropped\":" + String(frames.framesCoalesced);
+  json += ",\"incomplete\":" + String(frames.framesIncomplete);
+  json += ",\"synced\":" + String(frames.framesSynced);
+  json += ",\"deferred\":" + String(frames.framesDeferred);
+  json += ",\"unchanged\":" + String(frames.framesUnchanged);
+  json += ",\"interpolated\":" + String(frames.framesInterpolated);
+  json += "},\"effects\":" + effectsStatsJson();
+  json += ",\"tasks\":" + taskMonitorJson();
+  json += ",\"boot\":" + bootStatsJson();
+  json += ",\"settings\":" + settingsStoreStatsJson();
+  json += ",\"heap\":" + heapMonitorJson();
+  json += ",\"discovery\":" + artnetDiscoveryStatsJson();
+  json += ",\"sacn\":" + e131StatsJson();
+  json += "}";
+  return json;
+}
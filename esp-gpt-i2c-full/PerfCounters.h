@@ -0,0 +1,64 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <Arduino.h>
+
+// Hot-path instrumentation: CPU cycle timings per stage, aggregated into
+// log-scale histograms so min/avg/max/p99 can be reported without storing samples
+#ifndef PERF_COUNTERS_ENABLED
+#define PERF_COUNTERS_ENABLED 1
+#endif
+
+// Four sub-buckets per power of two - p99 is reported to within 25%
+#define PERF_SUB_BUCKET_BITS 2
+#define PERF_HISTOGRAM_BUCKETS (32 << PERF_SUB_BUCKET_BITS)
+
+enum PerfStage
+{
+  PERF_STAGE_PARSE = 0, // ArtNet packet validation and copy into the frame
+  PERF_STAGE_CONVERT,   // Pixel conversion into the output buffer
+  PERF_STAGE_SHOW,      // Handing the frame to the LED driver
+  PERF_STAGE_EFFECT,    // Rendering a local effect frame (LedEffects.h)
+  PERF_STAGE_COUNT
+};
+
+struct PerfStageSummary
+{
+  uint32_t count = 0;
+  float minUs = 0;
+  float avgUs = 0;
+  float maxUs = 0;
+  float p99Us = 0;
+};
+
+// Start of a timed section, in CPU cycles
+inline uint32_t perfTimestamp()
+{
+#if PERF_COUNTERS_ENABLED
+  return ESP.getCycleCount();
+#else
+  return 0;
+#endif
+}
+
+// Close a timed section opened with perfTimestamp()
+void perfRecord(PerfStage stage, uint32_t startCycles);
+
+void perfCountMalformed();
+void perfCountOutOfUniverse();
+
+void perfGetSummary(PerfStage stage, PerfStageSummary *summary);
+uint32_t perfMalformedCount();
+uint32_t perfOutOfUniverseCount();
+const char *perfStageName(PerfStage stage);
+
+// Clear all histograms and counters
+void perfReset();
+
+// {"count":..,"minUs":..,"avgUs":..,"maxUs":..,"p99Us":..}
+String perfStageJson(const PerfStageSummary &summary);
+
+// Stage timings, packet, frame pipeline and effect counters as one JSON object (/stats)
+String perfStatsJson();
+
+#endif // PERF_COUNTERS_H
@@ -0,0 +1,191 @@
+#include "PixelKernel.h"
+#include <math.h>
+
+// Correction LUT shared by all channels, brightness already applied. The output
+// stage builds the spare table and swaps the pointer, so a frame being converted
+// never sees a half-written one.
+struct CorrectionTable
+{
+  uint8_t value[256];
+  bool identity;
+};
+
+static CorrectionTable correctionTables[2];
+static CorrectionTable *volatile activeTable = NULL;
+static uint32_t builtGeneration = 0;
+
+// Requested correction - set from any task, built by pixelKernelApplyCorrection()
+static uint8_t requestedBrightness = 255;
+static float requestedGamma = PIXEL_DEFAULT_GAMMA;
+static volatile uint32_t requestedGeneration = 1;
+static portMUX_TYPE correctionMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const uint8_t identityMap[3] = {0, 1, 2};
+
+void pixelKernelSetCorrection(uint8_t brightness, float gamma)
+{
+  gamma = constrain(gamma, PIXEL_MIN_GAMMA, PIXEL_MAX_GAMMA);
+
+  portENTER_CRITICAL(&correctionMux);
+  if (brightness != requestedBrightness || gamma != requestedGamma)
+  {
+    requestedBrightness = brightness;
+    requestedGamma = gamma;
+    requestedGeneration++;
+  }
+  portEXIT_CRITICAL(&correctionMux);
+}
+
+void pixelKernelApplyCorrection()
+{
+  if (requestedGeneration == builtGeneration)
+  {
+    return;
+  }
+
+  portENTER_CRITICAL(&correctionMux);
+  uint8_t brightness = requestedBrightness;
+  float gamma = requestedGamma;
+  uint32_t generation = requestedGeneration;
+  portEXIT_CRITICAL(&correctionMux);
+
+  CorrectionTable *next = activeTable == &correctionTables[0] ? &correctionTables[1] : &correctionTables[0];
+  for (int value = 0; value < 256; value++)
+  {
+    float corrected = (gamma == 1.0f) ? value : 255.0f * powf(value / 255.0f, gamma);
+    next->value[value] = (uint8_t)(corrected * brightness / 255.0f + 0.5f);
+  }
+  next->identity = (brightness == 255 && gamma == 1.0f);
+
+  activeTable = next;
+  builtGeneration = generation;
+}
+
+uint32_t pixelKernelCorrectionId()
+{
+  return requestedGeneration;
+}
+
+// FNV-1a over 32-bit words, then the tail bytes
+uint32_t pixelHash(const uint8_t *data, uint32_t length)
+{
+  uint32_t hash = 2166136261UL;
+  uint32_t i = 0;
+
+  if (((uintptr_t)data & 3) == 0)
+  {
+    const uint32_t *words = (const uint32_t *)data;
+    for (; i + 4 <= length; i += 4)
+    {
+      hash = (hash ^ *words++) * 16777619UL;
+    }
+  }
+  for (; i < length; i++)
+  {
+    hash = (hash ^ data[i]) * 16777619UL;
+  }
+  return hash;
+}
+
+void pixelLerp(const uint8_t *from, const uint8_t *to, uint8_t *dst, uint32_t length, uint16_t weight, uint8_t dither)
+{
+  weight = min(weight, (uint16_t)256);
+  uint32_t inverse = 256 - weight;
+  uint8_t oddDither = dither ^ 0x80;
+  uint32_t i = 0;
+
+  if ((((uintptr_t)from | (uintptr_t)to | (uintptr_t)dst) & 3) == 0)
+  {
+    // a * (256 - w) + b * w + dither is at most 0xFFFF, so lanes never carry into each other
+    uint32_t evenBias = dither * 0x00010001UL;
+    uint32_t oddBias = oddDither * 0x00010001UL;
+    const uint32_t *a = (const uint32_t *)from;
+    const uint32_t *b = (const uint32_t *)to;
+    uint32_t *d = (uint32_t *)dst;
+
+    for (; i + 4 <= length; i += 4)
+    {
+      uint32_t wordA = *a++;
+      uint32_t wordB = *b++;
+      uint32_t even = ((wordA & 0x00FF00FF) * inverse + (wordB & 0x00FF00FF) * weight + evenBias) >> 8;
+      uint32_t odd = ((wordA >> 8) & 0x00FF00FF) * inverse + ((wordB >> 8) & 0x00FF00FF) * weight + oddBias;
+      *d++ = (even & 0x00FF00FF) | (odd & 0xFF00FF00);
+    }
+  }
+
+  for (; i < length; i++)
+  {
+    dst[i] = (from[i] * inverse + to[i] * weight + ((i & 1) ? oddDither : dither)) >> 8;
+  }
+}
+
+void pixelConvert(const uint8_t *src, uint8_t *dst, uint16_t numPixels, const uint8_t *channelMap)
+{
+  if (channelMap == NULL)
+  {
+    channelMap = identityMap;
+  }
+
+  // The first frame builds the table; after that only the output stage swaps it
+  if (activeTable == NULL)
+  {
+    pixelKernelApplyCorrection();
+  }
+  const CorrectionTable *table = activeTable;
+
+  // Nothing to correct or reorder - a plain copy is all that is left
+  if (table->identity && channelMap[0] == 0 && channelMap[1] == 1 && channelMap[2] == 2)
+  {
+    memcpy(dst, src, (uint32_t)numPixels * 3);
+    return;
+  }
+
+  const uint8_t c0 = channelMap[0];
+  const uint8_t c1 = channelMap[1];
+  const uint8_t c2 = channelMap[2];
+  const uint8_t *lut = table->value;
+  uint16_t remaining = numPixels;
+
+  // Four pixels fill exactly three words: load and store whole words, remap in registers
+  if ((((uintptr_t)src | (uintptr_t)dst) & 3) == 0)
+  {
+    const uint32_t *src32 = (const uint32_t *)src;
+    uint32_t *dst32 = (uint32_t *)dst;
+
+    for (; remaining >= 4; remaining -= 4, src32 += 3, dst32 += 3)
+    {
+      uint32_t in[3] = {src32[0], src32[1], src32[2]};
+      uint32_t out[3];
+      const uint8_t *s = (const uint8_t *)in;
+      uint8_t *d = (uint8_t *)out;
+
+      d[0] = lut[s[c0]];
+      d[1] = lut[s[c1]];
+      d[2] = lut[s[c2]];
+      d[3] = lut[s[3 + c0]];
+      d[4] = lut[s[3 + c1]];
+      d[5] = lut[s[3 + c2]];
+      d[6] = lut[s[6 + c0]];
+      d[7] = lut[s[6 + c1]];
+      d[8] = lut[s[6 + c2]];
+      d[9] = lut[s[9 + c0]];
+      d[10] = lut[s[9 + c1]];
+      d[11] = lut[s[9 + c2]];
+
+      dst32[0] = out[0];
+      dst32[1] = out[1];
+      dst32[2] = out[2];
+    }
+
+    src = (const uint8_t *)src32;
+    dst = (uint8_t *)dst32;
+  }
+
+  // Unaligned buffers and the tail go byte by byte
+  for (; remaining > 0; remaining--, src += 3, dst += 3)
+  {
+    dst[0] = lut[src[c0]];
+    dst[1] = lut[src[c1]];
+    dst[2] = lut[src[c2]];
+  }
+}
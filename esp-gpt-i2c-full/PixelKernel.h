@@ -0,0 +1,38 @@
+#ifndef PIXEL_KERNEL_H
+#define PIXEL_KERNEL_H
+
+#include <Arduino.h>
+
+// Gamma 1.0 leaves the DMX values linear, as the LEDs were driven before
+#define PIXEL_DEFAULT_GAMMA 1.0f
+#define PIXEL_MIN_GAMMA 0.5f
+#define PIXEL_MAX_GAMMA 3.0f
+
+// Request a brightness / gamma correction - cheap, callable from any task, a
+// no-op unless something changed. Brightness is folded into the LUT, so the
+// strip drivers run at full scale.
+void pixelKernelSetCorrection(uint8_t brightness, float gamma);
+
+// Output stage, once per frame before converting it: build the requested LUT
+// into the spare table and swap it in, so no frame is converted with a mix
+void pixelKernelApplyCorrection();
+
+// Bumped whenever a new correction is requested - output stages that skip
+// unchanged frames compare it so a brightness or gamma change is still sent out
+uint32_t pixelKernelCorrectionId();
+
+// Cheap 32-bit hash of a pixel buffer for change detection, a word at a time when aligned
+uint32_t pixelHash(const uint8_t *data, uint32_t length);
+
+// Blend two buffers byte by byte: dst = from + (to - from) * weight / 256, weight 0-256.
+// dither (0-255) is added before the shift with odd bytes taking the opposite phase,
+// so varying it per frame turns the dropped fraction into temporal dithering.
+// Four bytes per step (two in each 16-bit lane) when all buffers are word aligned.
+void pixelLerp(const uint8_t *from, const uint8_t *to, uint8_t *dst, uint32_t length, uint16_t weight, uint8_t dither);
+
+// Convert packed RGB pixels into wire bytes in one pass: every output byte is
+// lut[src[channel]] with channel = channelMap[byte % 3]. A NULL map keeps RGB.
+// Works four pixels (three 32-bit words) at a time when src and dst are word aligned.
+void pixelConvert(const uint8_t *src, uint8_t *dst, uint16_t numPixels, const uint8_t *channelMap);
+
+#endif // PIXEL_KERNEL_H
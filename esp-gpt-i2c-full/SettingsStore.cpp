@@ -0,0 +1,204 @@
+#include "SettingsStore.h"
+#include "ESP_GPT_I2C_Common.h"
+
+#define SETTINGS_STORE_BLOB_SIZE (sizeof(SettingsStoreHeader) + SETTINGS_STORE_MAX_SIZE)
+
+static uint8_t *ramRecord = NULL;
+static uint16_t recordSize = 0;
+static uint8_t recordVersion = 0;
+static SettingsPackFn packRecord = NULL;
+static uint8_t storeFlags = 0;
+
+// The blob being written, and the bytes that are in flash
+static uint8_t staging[SETTINGS_STORE_BLOB_SIZE];
+static uint8_t stored[SETTINGS_STORE_BLOB_SIZE];
+static uint16_t storedLength = 0;
+
+// Marked from any task (web handlers, UART dispatch), committed by one at a time
+static uint32_t dirtyFields = 0;
+static uint32_t lastChangeMs = 0;
+static portMUX_TYPE dirtyMux = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t commitMutex = NULL;
+
+static SettingsStoreStats stats;
+
+bool settingsStoreBegin(void *record, uint16_t size, uint8_t version, SettingsPackFn pack)
+{
+  if (size > SETTINGS_STORE_MAX_SIZE)
+  {
+    debugLog("ERROR: Settings record of " + String(size) + " bytes exceeds SETTINGS_STORE_MAX_SIZE");
+    return false;
+  }
+  if (commitMutex == NULL)
+  {
+    commitMutex = xSemaphoreCreateMutex();
+  }
+
+  ramRecord = (uint8_t *)record;
+  recordSize = size;
+  recordVersion = version;
+  packRecord = pack;
+  stats.size = size;
+
+  // The single read of the boot
+  Preferences store;
+  size_t length = 0;
+  if (store.begin(SETTINGS_STORE_NAMESPACE, true))
+  {
+    length = store.getBytes(SETTINGS_STORE_KEY, stored, sizeof(stored));
+    store.end();
+  }
+
+  SettingsStoreHeader header;
+  if (length < sizeof(header))
+  {
+    return false;
+  }
+  memcpy(&header, stored, sizeof(header));
+  const uint8_t *data = stored + sizeof(header);
+  if (header.magic != SETTINGS_STORE_MAGIC || header.size != length - sizeof(header) ||
+      pixelHash(data, header.size) != header.hash)
+  {
+    debugLog("Stored settings blob is invalid - ignoring it");
+    return false;
+  }
+
+  storedLength = length;
+  storeFlags = header.flags;
+  stats.loadedVersion = header.version;
+
+  // Fields are only appended, so any version's prefix matches this layout
+  memcpy(ramRecord, data, min(header.size, size));
+  return header.size > 0;
+}
+
+void settingsStoreMarkDirty(uint32_t fields)
+{
+  portENTER_CRITICAL(&dirtyMux);
+  dirtyFields |= fields;
+  lastChangeMs = millis();
+  portEXIT_CRITICAL(&dirtyMux);
+}
+
+uint32_t settingsStoreDirtyFields()
+{
+  return dirtyFields;
+}
+
+bool settingsStoreCommitDue()
+{
+  portENTER_CRITICAL(&dirtyMux);
+  bool due = dirtyFields != 0 && millis() - lastChangeMs >= SETTINGS_STORE_QUIET_MS;
+  portEXIT_CRITICAL(&dirtyMux);
+  return due;
+}
+
+bool settingsStoreCommit()
+{
+  if (commitMutex == NULL)
+  {
+    return false;
+  }
+  xSemaphoreTake(commitMutex, portMAX_DELAY);
+
+  portENTER_CRITICAL(&dirtyMux);
+  uint32_t fields = dirtyFields;
+  dirtyFields = 0;
+  portEXIT_CRITICAL(&dirtyMux);
+
+  if (fields == 0)
+  {
+    xSemaphoreGive(commitMutex);
+    return true;
+  }
+
+  if (packRecord != NULL)
+  {
+    packRecord(ramRecord);
+  }
+
+  SettingsStoreHeader header;
+  header.magic = SETTINGS_STORE_MAGIC;
+  header.version = recordVersion;
+  header.flags = storeFlags;
+  header.size = recordSize;
+  header.reserved = 0;
+  header.hash = pixelHash(ramRecord, recordSize);
+  memcpy(staging, &header, sizeof(header));
+  memcpy(staging + sizeof(header), ramRecord, recordSize);
+  uint16_t length = sizeof(header) + recordSize;
+
+  // Changes that were undone again, or a save with nothing new, cost no flash write
+  bool ok = true;
+  if (length == storedLength && memcmp(staging, stored, length) == 0)
+  {
+    stats.skipped++;
+  }
+  else
+  {
+    Preferences store;
+    ok = store.begin(SETTINGS_STORE_NAMESPACE, false) && store.putBytes(SETTINGS_STORE_KEY, staging, length) == length;
+    store.end();
+
+    if (ok)
+    {
+      memcpy(stored, staging, length);
+      storedLength = length;
+      stats.commits++;
+      stats.lastCommitMs = millis();
+    }
+    else
+    {
+      // Try again after the next quiet period
+      settingsStoreMarkDirty(fields);
+    }
+  }
+
+  xSemaphoreGive(commitMutex);
+  if (!ok)
+  {
+    debugLog("ERROR: Settings commit failed");
+  }
+  return ok;
+}
+
+bool settingsStoreFlag(uint8_t flag)
+{
+  return (storeFlags & flag) != 0;
+}
+
+void settingsStoreSetFlag(uint8_t flag, bool set, bool commitNow)
+{
+  uint8_t flags = set ? storeFlags | flag : storeFlags & ~flag;
+  if (flags == storeFlags)
+  {
+    return;
+  }
+  storeFlags = flags;
+
+  settingsStoreMarkDirty(SETTINGS_FIELD_FLAGS);
+  if (commitNow)
+  {
+    settingsStoreCommit();
+  }
+}
+
+void settingsStoreGetStats(SettingsStoreStats *copy)
+{
+  *copy = stats;
+  copy->dirtyFields = dirtyFields;
+}
+
+String settingsStoreStatsJson()
+{
+  SettingsStoreStats copy;
+  settingsStoreGetStats(&copy);
+
+  String json = "{\"commits\":" + String(copy.commits);
+  json += ",\"skipped\":" + String(copy.skipped);
+  json += ",\"dirty\":" + String(copy.dirtyFields);
+  json += ",\"lastCommitMs\":" + String(copy.lastCommitMs);
+  json += ",\"bytes\":" + String(sizeof(SettingsStoreHeader) + copy.size);
+  json += ",\"version\":" + String(copy.loadedVersion) + "}";
+  return json;
+}
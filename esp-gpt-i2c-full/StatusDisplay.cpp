@@ -0,0 +1,223 @@
+#include "StatusDisplay.h"
+#include "ESP_GPT_I2C_Common.h"
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+
+// Keep the bus at full speed after the library's own transfers as well
+static Adafruit_SSD1306 display(STATUS_DISPLAY_WIDTH, STATUS_DISPLAY_HEIGHT, &Wire, STATUS_DISPLAY_RESET_PIN,
+                                STATUS_DISPLAY_I2C_CLOCK, STATUS_DISPLAY_I2C_CLOCK);
+
+static bool displayPresent = false;
+static TaskHandle_t displayTaskHandle = NULL;
+static volatile uint32_t pagesSent = 0;
+static volatile uint32_t transferErrors = 0;
+
+// Text currently on the panel, per row
+static char shownRows[STATUS_DISPLAY_ROWS][STATUS_DISPLAY_ROW_CHARS];
+
+// Rate tracking between passes
+static uint32_t lastFramesRendered = 0;
+static uint32_t lastPacketCount = 0;
+static uint32_t lastRateMs = 0;
+static uint32_t framesPerSecond = 0;
+static uint32_t packetsPerSecond = 0;
+
+static void updateRates(uint32_t now)
+{
+  FramePipelineStats frames;
+  framePipelineGetStats(&frames);
+  uint32_t packets = state.artnetPacketCount;
+
+  uint32_t elapsed = now - lastRateMs;
+  if (lastRateMs != 0 && elapsed > 0)
+  {
+    framesPerSecond = (frames.framesRendered - lastFramesRendered) * 1000UL / elapsed;
+    packetsPerSecond = (packets - lastPacketCount) * 1000UL / elapsed;
+  }
+  lastFramesRendered = frames.framesRendered;
+  lastPacketCount = packets;
+  lastRateMs = now;
+}
+
+static void composeStatusPage(char rows[][STATUS_DISPLAY_ROW_CHARS])
+{
+  snprintf(rows[0], STATUS_DISPLAY_ROW_CHARS, "ESP32 ArtNet LED");
+
+  if (WiFi.status() == WL_CONNECTED)
+  {
+    IPAddress ip = WiFi.localIP();
+    snprintf(rows[1], STATUS_DISPLAY_ROW_CHARS, "IP %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  }
+  else
+  {
+    snprintf(rows[1], STATUS_DISPLAY_ROW_CHARS, "WiFi: Not Connected");
+  }
+
+  if (state.artnetRunning)
+  {
+    snprintf(rows[2], STATUS_DISPLAY_ROW_CHARS, "Universe %u", settings.artnetUniverse);
+  }
+  else
+  {
+    snprintf(rows[2], STATUS_DISPLAY_ROW_CHARS, "ArtNet: Disabled");
+  }
+
+  snprintf(rows[3], STATUS_DISPLAY_ROW_CHARS, "%lu fps %lu pkt/s", (unsigned long)framesPerSecond,
+           (unsigned long)packetsPerSecond);
+}
+
+// Average/p99 of the receive and output stages in microseconds, then the drop counters
+static void composePerfPage(char rows[][STATUS_DISPLAY_ROW_CHARS])
+{
+  static const PerfStage stages[STATUS_DISPLAY_ROWS - 1] = {PERF_STAGE_PARSE, PERF_STAGE_CONVERT, PERF_STAGE_SHOW};
+  for (int i = 0; i < STATUS_DISPLAY_ROWS - 1; i++)
+  {
+    PerfStageSummary summary;
+    perfGetSummary(stages[i], &summary);
+    snprintf(rows[i], STATUS_DISPLAY_ROW_CHARS, "%s %.1f/%.1fus", perfStageName(stages[i]), summary.avgUs,
+             summary.p99Us);
+  }
+
+  FramePipelineStats frames;
+  framePipelineGetStats(&frames);
+  snprintf(rows[STATUS_DISPLAY_ROWS - 1], STATUS_DISPLAY_ROW_CHARS, "Drop %lu Bad %lu OOU %lu",
+           (unsigned long)frames.framesCoalesced, (unsigned long)perfMalformedCount(),
+           (unsigned long)perfOutOfUniverseCount());
+}
+
+// Write one 8-pixel page of the framebuffer to the panel
+static bool sendPage(uint8_t page)
+{
+  Wire.beginTransmission(STATUS_DISPLAY_ADDRESS);
+  Wire.write((uint8_t)0x00); // Command stream
+  Wire.write((uint8_t)SSD1306_PAGEADDR);
+  Wire.write(page);
+  Wire.write(page);
+  Wire.write((uint8_t)SSD1306_COLUMNADDR);
+  Wire.write((uint8_t)0);
+  Wire.write((uint8_t)(STATUS_DISPLAY_WIDTH - 1));
+  if (Wire.endTransmission() != 0)
+  {
+    return false;
+  }
+
+  const uint8_t *data = display.getBuffer() + page * STATUS_DISPLAY_WIDTH;
+  for (int offset = 0; offset < STATUS_DISPLAY_WIDTH; offset += STATUS_DISPLAY_CHUNK_BYTES)
+  {
+    Wire.beginTransmission(STATUS_DISPLAY_ADDRESS);
+    Wire.write((uint8_t)0x40); // Data stream
+    Wire.write(data + offset, STATUS_DISPLAY_CHUNK_BYTES);
+    if (Wire.endTransmission() != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void statusDisplayTask(void *parameter)
+{
+  TickType_t lastWake = xTaskGetTickCount();
+  char rows[STATUS_DISPLAY_ROWS][STATUS_DISPLAY_ROW_CHARS];
+  heapMonitorSetPath(HEAP_PATH_STATUS);
+
+  while (true)
+  {
+    uint32_t now = millis();
+    updateRates(now);
+
+    memset(rows, 0, sizeof(rows));
+    bool perfPage = state.artnetRunning && (now / STATUS_DISPLAY_PAGE_MS) % 2 == 1;
+    if (perfPage)
+    {
+      composePerfPage(rows);
+    }
+    else
+    {
+      composeStatusPage(rows);
+    }
+
+    // Only rows with new text are redrawn and sent; a failed page keeps its old
+    // text recorded, so it is retried on the next pass
+    for (uint8_t row = 0; row < STATUS_DISPLAY_ROWS; row++)
+    {
+      if (strcmp(rows[row], shownRows[row]) == 0)
+      {
+        continue;
+      }
+
+      display.fillRect(0, row * 8, STATUS_DISPLAY_WIDTH, 8, SSD1306_BLACK);
+      display.setCursor(0, row * 8);
+      display.print(rows[row]);
+
+      if (sendPage(row))
+      {
+        memcpy(shownRows[row], rows[row], STATUS_DISPLAY_ROW_CHARS);
+        pagesSent++;
+      }
+      else
+      {
+        transferErrors++;
+      }
+    }
+
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(STATUS_DISPLAY_INTERVAL_MS));
+  }
+}
+
+bool statusDisplayBegin()
+{
+  if (displayTaskHandle != NULL)
+  {
+    return true;
+  }
+
+  // The only full initialization and full-frame transfer
+  if (!display.begin(SSD1306_SWITCHCAPVCC, STATUS_DISPLAY_ADDRESS))
+  {
+    debugLog("OLED initialization failed");
+    return false;
+  }
+  Wire.setClock(STATUS_DISPLAY_I2C_CLOCK);
+
+  display.clearDisplay();
+  display.setTextSize(1);
+  display.setTextColor(SSD1306_WHITE);
+  display.setTextWrap(false);
+  display.display();
+  memset(shownRows, 0, sizeof(shownRows));
+  displayPresent = true;
+
+  BaseType_t result = xTaskCreatePinnedToCore(
+      statusDisplayTask,              // Task function
+      "StatusDisplay",                // Task name
+      STATUS_DISPLAY_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                           // Task parameter
+      STATUS_DISPLAY_TASK_PRIORITY,   // Task priority
+      &displayTaskHandle,             // Task handle
+      NETWORK_CORE                    // Core to run the task on
+  );
+  if (result != pdPASS)
+  {
+    debugLog("ERROR: Failed to create OLED task");
+    displayTaskHandle = NULL;
+    return false;
+  }
+  return true;
+}
+
+bool statusDisplayPresent()
+{
+  return displayPresent;
+}
+
+uint32_t statusDisplayPagesSent()
+{
+  return pagesSent;
+}
+
+uint32_t statusDisplayErrors()
+{
+  return transferErrors;
+}
@@ -0,0 +1,41 @@
+#ifndef STATUS_DISPLAY_H
+#define STATUS_DISPLAY_H
+
+#include <Arduino.h>
+
+// SSD1306 status display in its own low-priority task. The panel is initialized
+// once; each pass formats the text rows (one 8-pixel page each), redraws only
+// rows whose text changed and sends just those pages over I2C at 400 kHz.
+#define STATUS_DISPLAY_WIDTH 128
+#define STATUS_DISPLAY_HEIGHT 32
+#define STATUS_DISPLAY_ADDRESS 0x3C
+#define STATUS_DISPLAY_RESET_PIN -1
+#define STATUS_DISPLAY_I2C_CLOCK 400000
+#define STATUS_DISPLAY_CHUNK_BYTES 64 // Page data per I2C transaction, within the Wire buffer
+
+#define STATUS_DISPLAY_ROWS (STATUS_DISPLAY_HEIGHT / 8)
+#define STATUS_DISPLAY_ROW_CHARS 22 // 21 characters of the 6x8 font, plus the terminator
+
+#define STATUS_DISPLAY_TASK_STACK_SIZE 3072
+#define STATUS_DISPLAY_TASK_PRIORITY 1
+#ifndef NETWORK_CORE
+#define NETWORK_CORE 0
+#endif
+
+// Row refresh and rate averaging period
+#define STATUS_DISPLAY_INTERVAL_MS 500
+
+// While ArtNet runs, the status and performance pages alternate this often
+#define STATUS_DISPLAY_PAGE_MS 5000
+
+// Initialize the panel and start the display task. Returns false (and starts
+// nothing) when no panel answers.
+bool statusDisplayBegin();
+
+bool statusDisplayPresent();
+
+// Pages written since the start, and I2C transfers that failed
+uint32_t statusDisplayPagesSent();
+uint32_t statusDisplayErrors();
+
+#endif // STATUS_DISPLAY_H
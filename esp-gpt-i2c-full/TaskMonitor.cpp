@@ -0,0 +1,131 @@
+#include "TaskMonitor.h"
+
+// Owned by the sampling task, so the system state call never allocates
+static TaskStatus_t statusBuffer[TASK_MONITOR_MAX_TASKS];
+static UBaseType_t previousNumber[TASK_MONITOR_MAX_TASKS];
+static uint32_t previousRunTime[TASK_MONITOR_MAX_TASKS];
+static uint8_t previousCount = 0;
+static uint32_t previousTotalRunTime = 0;
+
+static TaskMonitorSnapshot snapshot;
+static portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+
+// Run time of the task in the previous sample, or its current value for a new task
+static uint32_t previousRunTimeOf(const TaskStatus_t &status)
+{
+  for (uint8_t i = 0; i < previousCount; i++)
+  {
+    if (previousNumber[i] == status.xTaskNumber)
+    {
+      return previousRunTime[i];
+    }
+  }
+  return status.ulRunTimeCounter;
+}
+
+bool taskMonitorSample()
+{
+  uint32_t totalRunTime = 0;
+  UBaseType_t count = uxTaskGetSystemState(statusBuffer, TASK_MONITOR_MAX_TASKS, &totalRunTime);
+  if (count == 0)
+  {
+    // More tasks than slots - keep the previous snapshot
+    return true;
+  }
+
+  uint32_t elapsed = totalRunTime - previousTotalRunTime;
+  bool baseline = previousTotalRunTime == 0 || elapsed == 0;
+
+  TaskMonitorSnapshot next;
+  next.timestamp = millis();
+  next.taskCount = count;
+  for (int core = 0; core < portNUM_PROCESSORS; core++)
+  {
+    next.coreLoad[core] = 0;
+  }
+
+  for (UBaseType_t i = 0; i < count; i++)
+  {
+    const TaskStatus_t &status = statusBuffer[i];
+    TaskMonitorEntry &entry = next.tasks[i];
+
+    strlcpy(entry.name, status.pcTaskName, sizeof(entry.name));
+    entry.priority = status.uxCurrentPriority;
+#if configTASKLIST_INCLUDE_COREID
+    entry.core = status.xCoreID < portNUM_PROCESSORS ? status.xCoreID : TASK_MONITOR_ANY_CORE;
+#else
+    entry.core = TASK_MONITOR_ANY_CORE;
+#endif
+    entry.stackFree = status.usStackHighWaterMark * sizeof(StackType_t);
+    entry.cpuPercent = baseline ? 0 : (status.ulRunTimeCounter - previousRunTimeOf(status)) * 100.0f / elapsed;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+    {
+      if (status.xHandle == xTaskGetIdleTaskHandleForCPU(core))
+      {
+        next.coreLoad[core] = baseline ? 0 : max(0.0f, 100.0f - entry.cpuPercent);
+      }
+    }
+  }
+
+  for (UBaseType_t i = 0; i < count; i++)
+  {
+    previousNumber[i] = statusBuffer[i].xTaskNumber;
+    previousRunTime[i] = statusBuffer[i].ulRunTimeCounter;
+  }
+  previousCount = count;
+  previousTotalRunTime = totalRunTime;
+
+  portENTER_CRITICAL(&snapshotMux);
+  snapshot = next;
+  portEXIT_CRITICAL(&snapshotMux);
+  return true;
+}
+
+#else
+
+bool taskMonitorSample()
+{
+  return false;
+}
+
+#endif
+
+void taskMonitorGetSnapshot(TaskMonitorSnapshot *copy)
+{
+  portENTER_CRITICAL(&snapshotMux);
+  *copy = snapshot;
+  portEXIT_CRITICAL(&snapshotMux);
+}
+
+String taskMonitorJson()
+{
+  // Kept off the web server task's stack; /stats is the only caller
+  static TaskMonitorSnapshot copy;
+  taskMonitorGetSnapshot(&copy);
+
+  String json = "{\"sampledMs\":" + String(copy.timestamp);
+  json += ",\"cores\":[";
+  for (int core = 0; core < portNUM_PROCESSORS; core++)
+  {
+    if (core > 0)
+      json += ",";
+    json += String(copy.coreLoad[core], 1);
+  }
+  json += "],\"tasks\":[";
+  for (uint8_t i = 0; i < copy.taskCount; i++)
+  {
+    const TaskMonitorEntry &entry = copy.tasks[i];
+    if (i > 0)
+      json += ",";
+    json += "{\"name\":\"" + String(entry.name) + "\"";
+    json += ",\"core\":" + String(entry.core);
+    json += ",\"priority\":" + String(entry.priority);
+    json += ",\"cpu\":" + String(entry.cpuPercent, 1);
+    json += ",\"stackFree\":" + String(entry.stackFree) + "}";
+  }
+  json += "]}";
+  return json;
+}
@@ -1,34 +1,92 @@
 // UARTCommunicationBridge.cpp
 // Implementation of UART Communication Bridge for ESP32 ArtNet Controller
-// Version: 0.1.0
+// Version: 0.4.0
 
 #include "UARTCommunicationBridge.h"
+#include "LogRing.h"
+#include "HeapMonitor.h"
+#include "SettingsStore.h"
 
-// Packet structure:
+// v1 packet structure (v2 framing is described in the header):
 // [START_BYTE][LENGTH][COMMAND][DATA...][CHECKSUM]
 #define START_BYTE 0xAA
 #define MIN_PACKET_LENGTH 4         // START_BYTE + LENGTH + COMMAND + CHECKSUM
 #define RECEIVE_TIMEOUT 1000        // milliseconds
 #define STATUS_UPDATE_INTERVAL 5000 // milliseconds for automatic status updates
+#define RX_CHUNK_SIZE 256           // bytes pulled from the ring buffer per read
+
+// CRC16-CCITT lookup table, polynomial 0x1021
+static const uint16_t crc16Table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
 
 // Constructor
-UARTCommunicationBridge::UARTCommunicationBridge(HardwareSerial &serial, uint32_t baud)
-    : uart(serial),
-      baudRate(baud),
+UARTCommunicationBridge::UARTCommunicationBridge(uart_port_t uartPort, uint32_t baud, int rx, int tx)
+    : port(uartPort),
+      baudRate(min(baud, (uint32_t)UART_BRIDGE_MAX_BAUD)),
+      rxPin(rx),
+      txPin(tx),
       initialized(false),
       lastError(ERR_NONE),
       lastReceiveTime(0),
       lastStatusUpdate(0),
+      eventQueue(NULL),
+      commandQueue(NULL),
+      rxTaskHandle(NULL),
       receiveIndex(0),
+      rxFormat(RX_IDLE),
+      rxEscape(false),
+      rxSequence(0),
+      rxSequenceValid(false),
+      txSequence(0),
+      protocolVersion(1),
       currentStatus(STATUS_IDLE),
       statusUpdateInterval(STATUS_UPDATE_INTERVAL),
       packetsSent(0),
+      packetsCoalesced(0),
       packetsReceived(0),
+      dmxPacketsReceived(0),
       errorCount(0),
-      commandCallback(nullptr)
+      rxOverflows(0),
+      packetsDropped(0),
+      sequenceGaps(0),
+      commandCallback(nullptr),
+      dmxDataCallback(nullptr)
 {
-    // Initialize buffer
-    memset(receiveBuffer, 0, MAX_PACKET_SIZE);
+    // Initialize buffers
+    memset(receiveBuffer, 0, sizeof(receiveBuffer));
+    memset(pendingCommands, 0, sizeof(pendingCommands));
 }
 
 // Initialize the UART communication
@@ -39,110 +97,393 @@ bool UARTCommunicationBridge::initializeCommunication()
         return true; // Already initialized
     }
 
-    // Begin UART with specified baud rate
-    uart.begin(baudRate);
+    uart_config_t config = {};
+    config.baud_rate = baudRate;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_APB;
+
+    // The driver owns the RX/TX ring buffers and posts data events to eventQueue
+    if (uart_driver_install(port, UART_BRIDGE_RX_BUFFER_SIZE, UART_BRIDGE_TX_BUFFER_SIZE,
+                            UART_BRIDGE_EVENT_QUEUE_LENGTH, &eventQueue, 0) != ESP_OK)
+    {
+        setLastError(ERR_BUFFER_OVERFLOW);
+        return false;
+    }
 
-    // Initial diagnostics message
-    uart.print("UART Communication Bridge v0.1.0 Initializing...");
+    if (uart_param_config(port, &config) != ESP_OK ||
+        uart_set_pin(port, txPin, rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK)
+    {
+        uart_driver_delete(port);
+        setLastError(ERR_INVALID_PARAM);
+        return false;
+    }
+
+    commandQueue = xQueueCreate(UART_BRIDGE_COMMAND_QUEUE_LENGTH, sizeof(QueuedPacket));
+    if (commandQueue == NULL)
+    {
+        uart_driver_delete(port);
+        setLastError(ERR_BUFFER_OVERFLOW);
+        return false;
+    }
 
     // Reset buffers
     resetReceiveBuffer();
 
-    // Skip the test packet for now since it's causing timeouts
-    // uint8_t testData[4] = {0x01, 0x02, 0x03, 0x04};
-    // if (!sendCommand(CMD_ACK, testData, 4)) {
-    //    setLastError(ERR_TIMEOUT);
-    //    return false;
-    // }
+    BaseType_t created = xTaskCreatePinnedToCore(
+        rxTask,                  // Task function
+        "UARTRxTask",            // Task name
+        UART_RX_TASK_STACK_SIZE, // Stack size (bytes)
+        this,                    // Task parameter
+        UART_RX_TASK_PRIORITY,   // Task priority
+        &rxTaskHandle,           // Task handle
+        UART_RX_TASK_CORE        // Core to run the task on
+    );
+
+    if (created != pdPASS)
+    {
+        vQueueDelete(commandQueue);
+        commandQueue = NULL;
+        uart_driver_delete(port);
+        setLastError(ERR_BUFFER_OVERFLOW);
+        return false;
+    }
+
+    // Initial diagnostics message
+    const char *banner = "UART Communication Bridge v" UART_BRIDGE_VERSION " Initializing...";
+    uart_write_bytes(port, banner, strlen(banner));
 
     initialized = true;
-    uart.println("Initialization complete");
+    const char *done = "Initialization complete\r\n";
+    uart_write_bytes(port, done, strlen(done));
     return true;
 }
 
-// Process incoming data from UART
-bool UARTCommunicationBridge::processIncomingData()
+// Change the line rate on the fly - both ends have to switch together
+bool UARTCommunicationBridge::setBaudRate(uint32_t baud)
 {
-    if (!initialized)
+    if (baud == 0 || baud > UART_BRIDGE_MAX_BAUD)
     {
+        setLastError(ERR_INVALID_PARAM);
         return false;
     }
 
-    currentStatus = STATUS_RECEIVING;
-
-    // Check if data is available
-    while (uart.available())
+    baudRate = baud;
+    if (initialized)
     {
-        uint8_t incomingByte = uart.read();
-        lastReceiveTime = millis();
+        uart_wait_tx_done(port, pdMS_TO_TICKS(100));
+        return uart_set_baudrate(port, baud) == ESP_OK;
+    }
+    return true;
+}
+
+void UARTCommunicationBridge::rxTask(void *parameter)
+{
+    heapMonitorSetPath(HEAP_PATH_UART);
+    static_cast<UARTCommunicationBridge *>(parameter)->receiveLoop();
+}
 
-        // If this is a start byte and we're not in the middle of a packet, reset buffer
-        if (incomingByte == START_BYTE && receiveIndex == 0)
+// RX task - woken by the driver event queue, never polls
+void UARTCommunicationBridge::receiveLoop()
+{
+    uart_event_t event;
+    uint8_t chunk[RX_CHUNK_SIZE];
+
+    for (;;)
+    {
+        // Wake up periodically so a stalled partial packet times out
+        if (xQueueReceive(eventQueue, &event, pdMS_TO_TICKS(RECEIVE_TIMEOUT / 4)) != pdTRUE)
         {
-            receiveBuffer[receiveIndex++] = incomingByte;
+            if ((receiveIndex > 0 || rxFormat == RX_V2_SKIP) && (millis() - lastReceiveTime > RECEIVE_TIMEOUT))
+            {
+                setLastError(ERR_TIMEOUT);
+                errorCount++;
+                resetReceiveBuffer();
+                currentStatus = STATUS_ERROR;
+            }
+            continue;
         }
-        // Otherwise, if we've seen a start byte, keep adding to the buffer
-        else if (receiveIndex > 0)
+
+        switch (event.type)
         {
-            // Protect against buffer overflow
-            if (receiveIndex < MAX_PACKET_SIZE)
+        case UART_DATA:
+        {
+            // Drain everything buffered so far, not just this event's bytes
+            size_t buffered = 0;
+            uart_get_buffered_data_len(port, &buffered);
+            while (buffered > 0)
             {
-                receiveBuffer[receiveIndex++] = incomingByte;
-
-                // If we have at least 2 bytes, we can check the length
-                if (receiveIndex >= 2)
+                int read = uart_read_bytes(port, chunk, min(buffered, sizeof(chunk)), 0);
+                if (read <= 0)
                 {
-                    uint8_t packetLength = receiveBuffer[1];
-
-                    // If we have received all bytes (including checksum)
-                    if (receiveIndex >= packetLength)
-                    {
-                        // Process the complete packet
-                        currentStatus = STATUS_PROCESSING;
-
-                        // Verify and process the packet
-                        if (validatePacket(receiveBuffer, receiveIndex))
-                        {
-                            processPacket(receiveBuffer, receiveIndex);
-                            packetsReceived++;
-                        }
-                        else
-                        {
-                            setLastError(ERR_CHECKSUM);
-                            errorCount++;
-                        }
-
-                        // Reset for next packet
-                        resetReceiveBuffer();
-                        currentStatus = STATUS_IDLE;
-                        return true;
-                    }
+                    break;
                 }
+                consumeBytes(chunk, read);
+                buffered -= read;
             }
-            else
-            {
-                // Buffer overflow
-                setLastError(ERR_BUFFER_OVERFLOW);
-                errorCount++;
-                resetReceiveBuffer();
-                currentStatus = STATUS_ERROR;
-                return false;
-            }
+            break;
+        }
+
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            // Bytes were lost - drop them and resynchronise on the next start byte
+            rxOverflows++;
+            errorCount++;
+            setLastError(ERR_BUFFER_OVERFLOW);
+            uart_flush_input(port);
+            xQueueReset(eventQueue);
+            resetReceiveBuffer();
+            rxSequenceValid = false;
+            break;
+
+        case UART_FRAME_ERR:
+        case UART_PARITY_ERR:
+            errorCount++;
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
+// Feed received bytes through the packet state machine
+void UARTCommunicationBridge::consumeBytes(const uint8_t *bytes, size_t length)
+{
+    lastReceiveTime = millis();
+
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t incomingByte = bytes[i];
+
+        if (rxFormat == RX_V1)
+        {
+            consumeV1Byte(incomingByte);
+        }
+        else if (rxFormat == RX_V2 || rxFormat == RX_V2_SKIP || incomingByte == FRAME_FLAG)
+        {
+            consumeV2Byte(incomingByte);
+        }
+        else if (incomingByte == START_BYTE)
+        {
+            // Start of a v1 packet
+            rxFormat = RX_V1;
+            receiveBuffer[receiveIndex++] = incomingByte;
+            currentStatus = STATUS_RECEIVING;
         }
     }
+}
 
-    // Check for timeout on partial packets
-    if (receiveIndex > 0 && (millis() - lastReceiveTime > RECEIVE_TIMEOUT))
+// v1 - bytes are taken verbatim until LENGTH bytes have arrived
+void UARTCommunicationBridge::consumeV1Byte(uint8_t incomingByte)
+{
+    // Protect against buffer overflow
+    if (receiveIndex >= MAX_PACKET_SIZE)
     {
-        setLastError(ERR_TIMEOUT);
+        setLastError(ERR_BUFFER_OVERFLOW);
         errorCount++;
         resetReceiveBuffer();
         currentStatus = STATUS_ERROR;
-        return false;
+        return;
+    }
+
+    receiveBuffer[receiveIndex++] = incomingByte;
+
+    // If we have received all bytes (including checksum)
+    if (receiveIndex >= 2 && receiveIndex >= receiveBuffer[1])
+    {
+        completeV1Packet();
+    }
+}
+
+// v2 - every FLAG is a boundary, so a damaged frame never swallows the next one
+void UARTCommunicationBridge::consumeV2Byte(uint8_t incomingByte)
+{
+    if (incomingByte == FRAME_FLAG)
+    {
+        // A frame cut short by a new FLAG is lost, the new one starts clean
+        if (rxFormat == RX_V2 && receiveIndex > 0)
+        {
+            setLastError(ERR_CHECKSUM);
+            errorCount++;
+        }
+        resetReceiveBuffer();
+        rxFormat = RX_V2;
+        currentStatus = STATUS_RECEIVING;
+        return;
+    }
+
+    if (rxFormat == RX_V2_SKIP)
+    {
+        return;
+    }
+
+    if (incomingByte == FRAME_ESCAPE)
+    {
+        rxEscape = true;
+        return;
+    }
+    if (rxEscape)
+    {
+        incomingByte ^= FRAME_ESCAPE_XOR;
+        rxEscape = false;
+    }
+
+    // Not a v2 frame after all (closing FLAG followed by a v1 packet, or line noise)
+    if (receiveIndex == 0 && incomingByte != FRAME_VERSION_2)
+    {
+        resetReceiveBuffer();
+        if (incomingByte == START_BYTE)
+        {
+            consumeBytes(&incomingByte, 1);
+        }
+        return;
+    }
+
+    receiveBuffer[receiveIndex++] = incomingByte;
+
+    if (receiveIndex < FRAME_V2_HEADER_SIZE)
+    {
+        return;
+    }
+
+    uint16_t payloadLength = (receiveBuffer[3] << 8) | receiveBuffer[4];
+    if (payloadLength > FRAME_V2_MAX_PAYLOAD)
+    {
+        // Length is corrupt - skip to the next FLAG instead of waiting for bytes that never come
+        setLastError(ERR_BUFFER_OVERFLOW);
+        errorCount++;
+        resetReceiveBuffer();
+        rxFormat = RX_V2_SKIP;
+        return;
+    }
+
+    if (receiveIndex >= FRAME_V2_HEADER_SIZE + payloadLength + 2)
+    {
+        completeV2Frame();
+    }
+}
+
+void UARTCommunicationBridge::completeV1Packet()
+{
+    currentStatus = STATUS_PROCESSING;
+
+    if (validatePacket(receiveBuffer, receiveIndex))
+    {
+        protocolVersion = 1;
+        handlePacket(receiveBuffer[2], &receiveBuffer[3], receiveIndex - 4); // Subtract START_BYTE, LENGTH, COMMAND, CHECKSUM
+    }
+    else
+    {
+        setLastError(ERR_CHECKSUM);
+        errorCount++;
+    }
+
+    // Reset for next packet
+    resetReceiveBuffer();
+    currentStatus = STATUS_IDLE;
+}
+
+void UARTCommunicationBridge::completeV2Frame()
+{
+    currentStatus = STATUS_PROCESSING;
+
+    uint16_t payloadLength = (receiveBuffer[3] << 8) | receiveBuffer[4];
+    uint16_t crcOffset = FRAME_V2_HEADER_SIZE + payloadLength;
+    uint16_t receivedCrc = (receiveBuffer[crcOffset] << 8) | receiveBuffer[crcOffset + 1];
+
+    if (calculateCRC16(receiveBuffer, crcOffset) == receivedCrc)
+    {
+        // Count frames lost in between, then expect the one after this
+        uint8_t sequence = receiveBuffer[1];
+        if (rxSequenceValid && sequence != rxSequence)
+        {
+            sequenceGaps += (uint8_t)(sequence - rxSequence);
+        }
+        rxSequence = sequence + 1;
+        rxSequenceValid = true;
+
+        protocolVersion = 2;
+        handlePacket(receiveBuffer[2], &receiveBuffer[FRAME_V2_HEADER_SIZE], payloadLength);
+    }
+    else
+    {
+        setLastError(ERR_CHECKSUM);
+        errorCount++;
     }
 
+    // The closing FLAG opens the next frame
+    resetReceiveBuffer();
     currentStatus = STATUS_IDLE;
-    return false;
+}
+
+// A validated packet - pixel data goes straight out, everything else is
+// queued for the main loop
+void UARTCommunicationBridge::handlePacket(uint8_t command, uint8_t *data, uint16_t length)
+{
+    if (command == CMD_DMX_DATA && dmxDataCallback != nullptr)
+    {
+        if (length >= DMX_DATA_HEADER_SIZE)
+        {
+            uint16_t pixelOffset = (data[1] << 8) | data[2];
+            dmxDataCallback(pixelOffset, data + DMX_DATA_HEADER_SIZE, length - DMX_DATA_HEADER_SIZE,
+                            data[0] & DMX_FLAG_PRESENT);
+            dmxPacketsReceived++;
+            packetsReceived++;
+        }
+        else
+        {
+            setLastError(ERR_INVALID_PARAM);
+            errorCount++;
+        }
+        return;
+    }
+
+    if (length > MAX_PACKET_SIZE)
+    {
+        // Only pixel data may use the large v2 payloads
+        setLastError(ERR_BUFFER_OVERFLOW);
+        packetsDropped++;
+        errorCount++;
+        return;
+    }
+
+    QueuedPacket *queued = &rxQueuedPacket;
+    queued->command = command;
+    queued->length = length;
+    memcpy(queued->data, data, length);
+    if (xQueueSend(commandQueue, queued, 0) == pdTRUE)
+    {
+        packetsReceived++;
+    }
+    else
+    {
+        packetsDropped++;
+        errorCount++;
+    }
+}
+
+// Dispatch packets the RX task has queued, in arrival order
+bool UARTCommunicationBridge::processIncomingData()
+{
+    if (!initialized)
+    {
+        return false;
+    }
+
+    bool processed = false;
+    QueuedPacket packet;
+    while (xQueueReceive(commandQueue, &packet, 0) == pdTRUE)
+    {
+        processPacket(packet.command, packet.data, packet.length);
+        processed = true;
+    }
+
+    // One reply per command for the whole burst
+    flushPendingCommands();
+    return processed;
 }
 
 // Send a status update packet
@@ -179,8 +520,8 @@ void UARTCommunicationBridge::sendStatusUpdate()
     statusData[14] = (freeHeap >> 8) & 0xFF;
     statusData[15] = freeHeap & 0xFF;
 
-    // Send the status update
-    sendCommand(CMD_GET_STATUS, statusData, 16);
+    // Send the status update - back-to-back requests share one reply
+    postCommand(CMD_GET_STATUS, statusData, 16);
     lastStatusUpdate = millis();
 }
 
@@ -196,9 +537,7 @@ void UARTCommunicationBridge::handleModeSwitch(uint8_t mode)
     sendCommand(CMD_SET_MODE, modeData, 1);
 
     // Log the mode switch
-    char logMsg[64];
-    snprintf(logMsg, sizeof(logMsg), "Mode switched to %d via UART", mode);
-    Serial.println(logMsg);
+    logRingWrite(LOG_LEVEL_INFO, "Mode switched to %d via UART", mode);
 }
 
 // Print system diagnostics to Serial monitor
@@ -213,8 +552,22 @@ void UARTCommunicationBridge::printSystemDiagnostics()
     Serial.println(currentStatus, HEX);
     Serial.print("Packets Sent: ");
     Serial.println(packetsSent);
+    Serial.print("Baud Rate: ");
+    Serial.println(baudRate);
+    Serial.print("Packets Coalesced: ");
+    Serial.println(packetsCoalesced);
     Serial.print("Packets Received: ");
     Serial.println(packetsReceived);
+    Serial.print("DMX Packets: ");
+    Serial.println(dmxPacketsReceived);
+    Serial.print("RX Overflows: ");
+    Serial.println(rxOverflows);
+    Serial.print("Packets Dropped: ");
+    Serial.println(packetsDropped);
+    Serial.print("Protocol Version: ");
+    Serial.println(protocolVersion);
+    Serial.print("Sequence Gaps: ");
+    Serial.println(sequenceGaps);
     Serial.print("Error Count: ");
     Serial.println(errorCount);
     Serial.print("Free Heap: ");
@@ -222,15 +575,14 @@ void UARTCommunicationBridge::printSystemDiagnostics()
     Serial.println("-----------------------------");
 }
 
-// Set error code and print the message
+// Set error code and log it - safe from the RX task, nothing is printed inline
 void UARTCommunicationBridge::setLastError(uint8_t error)
 {
     lastError = error;
 
     if (error != ERR_NONE)
     {
-        Serial.print("UART Bridge Error: 0x");
-        Serial.println(error, HEX);
+        logRingWrite(LOG_LEVEL_WARNING, "UART Bridge Error: 0x%02X", error);
     }
 }
 
@@ -278,6 +630,16 @@ uint8_t UARTCommunicationBridge::calculateChecksum(uint8_t *data, uint16_t lengt
     return checksum;
 }
 
+// Table-driven CRC16-CCITT, one lookup per byte - pass the previous result to continue a CRC
+uint16_t UARTCommunicationBridge::calculateCRC16(const uint8_t *data, uint16_t length, uint16_t crc)
+{
+    for (uint16_t i = 0; i < length; i++)
+    {
+        crc = (crc << 8) ^ crc16Table[(crc >> 8) ^ data[i]];
+    }
+    return crc;
+}
+
 // Validate received packet
 bool UARTCommunicationBridge::validatePacket(uint8_t *packet, uint16_t length)
 {
@@ -308,11 +670,8 @@ bool UARTCommunicationBridge::validatePacket(uint8_t *packet, uint16_t length)
 }
 
 // Process a validated packet
-void UARTCommunicationBridge::processPacket(uint8_t *packet, uint16_t length)
+void UARTCommunicationBridge::processPacket(uint8_t command, uint8_t *data, uint16_t length)
 {
-    // Extract command
-    uint8_t command = packet[2];
-
     // Handle built-in commands
     switch (command)
     {
@@ -326,7 +685,12 @@ void UARTCommunicationBridge::processPacket(uint8_t *packet, uint16_t length)
         break;
 
     case CMD_SYSTEM_RESET:
-        // Reset command - trigger ESP32 reset
+        // Reset command - save pending settings and the log first, then reset
+        if (settingsStoreDirtyFields() != 0)
+        {
+            settingsStoreCommit();
+        }
+        logRingFlush();
         ESP.restart();
         break;
 
@@ -334,9 +698,7 @@ void UARTCommunicationBridge::processPacket(uint8_t *packet, uint16_t length)
         // For other commands, call the callback if registered
         if (commandCallback != nullptr)
         {
-            // Pass only the data portion (skip header)
-            uint16_t dataLength = length - 4; // Subtract START_BYTE, LENGTH, COMMAND, CHECKSUM
-            commandCallback(command, &packet[3], dataLength);
+            commandCallback(command, data, length);
         }
         else
         {
@@ -347,25 +709,16 @@ void UARTCommunicationBridge::processPacket(uint8_t *packet, uint16_t length)
     }
 }
 
-// Send a command packet over UART
-bool UARTCommunicationBridge::sendCommand(uint8_t command, uint8_t *data, uint16_t length)
+// Build a v1 packet into packetBuffer, returns its size or 0 if it does not fit
+uint16_t UARTCommunicationBridge::buildV1Packet(uint8_t command, const uint8_t *data, uint16_t length)
 {
-    if (!initialized)
-    {
-        return false;
-    }
-
-    currentStatus = STATUS_SENDING;
-
     // Calculate total packet length
     uint16_t packetLength = 3 + length + 1; // START_BYTE + LENGTH + COMMAND + DATA + CHECKSUM
 
-    // Ensure we're not exceeding maximum packet size
-    if (packetLength > MAX_PACKET_SIZE)
+    // The length has to fit its single byte
+    if (packetLength > 0xFF)
     {
-        setLastError(ERR_BUFFER_OVERFLOW);
-        currentStatus = STATUS_ERROR;
-        return false;
+        return 0;
     }
 
     // Prepare packet buffer
@@ -381,25 +734,146 @@ bool UARTCommunicationBridge::sendCommand(uint8_t command, uint8_t *data, uint16
 
     // Calculate and append checksum
     packetBuffer[packetLength - 1] = calculateChecksum(packetBuffer, packetLength - 1);
+    return packetLength;
+}
 
-    // Send the packet
-    uart.write(packetBuffer, packetLength);
+// Escape FLAG and ESCAPE bytes, returns the number of bytes written to out
+static uint16_t stuffBytes(uint8_t *out, const uint8_t *bytes, uint16_t count)
+{
+    uint16_t written = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        if (bytes[i] == FRAME_FLAG || bytes[i] == FRAME_ESCAPE)
+        {
+            out[written++] = FRAME_ESCAPE;
+            out[written++] = bytes[i] ^ FRAME_ESCAPE_XOR;
+        }
+        else
+        {
+            out[written++] = bytes[i];
+        }
+    }
+    return written;
+}
 
-    // Flush to ensure all bytes are sent
-    uart.flush();
+// Build a stuffed v2 frame into packetBuffer, returns its size or 0 if it does not fit
+uint16_t UARTCommunicationBridge::buildV2Frame(uint8_t command, const uint8_t *data, uint16_t length)
+{
+    if (length > MAX_PACKET_SIZE)
+    {
+        return 0;
+    }
+
+    uint8_t header[FRAME_V2_HEADER_SIZE] = {
+        FRAME_VERSION_2, txSequence++, command, (uint8_t)(length >> 8), (uint8_t)(length & 0xFF)};
+    uint16_t crc = calculateCRC16(header, FRAME_V2_HEADER_SIZE);
+    crc = calculateCRC16(data, length, crc);
+    uint8_t trailer[2] = {(uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)};
+
+    uint16_t out = 0;
+    packetBuffer[out++] = FRAME_FLAG;
+    out += stuffBytes(&packetBuffer[out], header, FRAME_V2_HEADER_SIZE);
+    out += stuffBytes(&packetBuffer[out], data, length);
+    out += stuffBytes(&packetBuffer[out], trailer, 2);
+    packetBuffer[out++] = FRAME_FLAG;
+    return out;
+}
+
+// Send a command packet over UART, framed the way the host last talked to us
+bool UARTCommunicationBridge::sendCommand(uint8_t command, uint8_t *data, uint16_t length)
+{
+    if (!initialized)
+    {
+        return false;
+    }
+
+    currentStatus = STATUS_SENDING;
+
+    uint16_t packetLength = (protocolVersion == 2) ? buildV2Frame(command, data, length)
+                                                   : buildV1Packet(command, data, length);
+
+    // Ensure we're not exceeding maximum packet size
+    if (packetLength == 0)
+    {
+        setLastError(ERR_BUFFER_OVERFLOW);
+        currentStatus = STATUS_ERROR;
+        return false;
+    }
+
+    // Queue the packet - only waits if the TX ring buffer is full
+    uart_write_bytes(port, packetBuffer, packetLength);
 
     packetsSent++;
     currentStatus = STATUS_IDLE;
     return true;
 }
 
+// Hold a reply for the next flush, replacing one with the same command
+bool UARTCommunicationBridge::postCommand(uint8_t command, const uint8_t *data, uint16_t length)
+{
+    if (!initialized)
+    {
+        return false;
+    }
+
+    // Too large to hold - send it as is
+    if (length > UART_BRIDGE_COALESCE_MAX_DATA)
+    {
+        return sendCommand(command, (uint8_t *)data, length);
+    }
+
+    PendingCommand *slot = nullptr;
+    for (int i = 0; i < UART_BRIDGE_COALESCE_SLOTS; i++)
+    {
+        if (pendingCommands[i].pending && pendingCommands[i].command == command)
+        {
+            slot = &pendingCommands[i];
+            packetsCoalesced++;
+            break;
+        }
+        if (!pendingCommands[i].pending && slot == nullptr)
+        {
+            slot = &pendingCommands[i];
+        }
+    }
+
+    // All slots hold other commands - make room
+    if (slot == nullptr)
+    {
+        flushPendingCommands();
+        slot = &pendingCommands[0];
+    }
+
+    slot->pending = true;
+    slot->command = command;
+    slot->length = length;
+    if (data != nullptr && length > 0)
+    {
+        memcpy(slot->data, data, length);
+    }
+    return true;
+}
+
+// Send every pending coalesced reply
+void UARTCommunicationBridge::flushPendingCommands()
+{
+    for (int i = 0; i < UART_BRIDGE_COALESCE_SLOTS; i++)
+    {
+        if (pendingCommands[i].pending)
+        {
+            pendingCommands[i].pending = false;
+            sendCommand(pendingCommands[i].command, pendingCommands[i].data, pendingCommands[i].length);
+        }
+    }
+}
+
 // Reset the receive buffer
 void UARTCommunicationBridge::resetReceiveBuffer()
 {
-    memset(receiveBuffer, 0, MAX_PACKET_SIZE);
     receiveIndex = 0;
+    rxFormat = RX_IDLE;
+    rxEscape = false;
 }
-
 // Update method to be called in the main loop
 void UARTCommunicationBridge::update()
 {
@@ -410,5 +884,6 @@ void UARTCommunicationBridge::update()
     if (millis() - lastStatusUpdate >= statusUpdateInterval)
     {
         sendStatusUpdate();
+        flushPendingCommands();
     }
 }
\ No newline at end of file
@@ -1,13 +1,19 @@
 // UARTCommunicationBridge.h
 // UART Communication Bridge for ESP32 ArtNet Controller
 // Provides bidirectional communication between ESP32 and external devices
-// Version: 0.1.0
+// Version: 0.4.0
 
 #ifndef UART_COMMUNICATION_BRIDGE_H
 #define UART_COMMUNICATION_BRIDGE_H
 
 #include <Arduino.h>
 #include <stdint.h>
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#define UART_BRIDGE_VERSION "0.4.0"
 
 // Command codes for communication protocol
 #define CMD_ACK 0x01            // Acknowledgment
@@ -31,9 +37,28 @@
 #define ERR_ARTNET_INIT 0x11     // ArtNet initialization error
 #define ERR_WIFI_CONN 0x12       // WiFi connection error
 
-// Maximum packet size
+// Maximum packet size (v1 frames, queued commands and transmitted payloads)
 #define MAX_PACKET_SIZE 256
 
+// v2 framing, used by the host whenever a payload may exceed a v1 packet:
+// [FLAG][VERSION][SEQ][COMMAND][LENGTH_HI][LENGTH_LO][DATA...][CRC_HI][CRC_LO][FLAG]
+// FLAG and ESCAPE inside the frame are sent as ESCAPE, byte ^ ESCAPE_XOR, so a
+// FLAG always marks a frame boundary and a corrupt frame costs only itself.
+// The CRC is CRC16-CCITT (poly 0x1021, init 0xFFFF) over VERSION..DATA.
+#define FRAME_FLAG 0x7E
+#define FRAME_ESCAPE 0x7D
+#define FRAME_ESCAPE_XOR 0x20
+#define FRAME_VERSION_2 0x02
+#define FRAME_V2_HEADER_SIZE 5     // VERSION + SEQ + COMMAND + LENGTH
+#define FRAME_V2_MAX_PAYLOAD 1024  // A full universe of CMD_DMX_DATA fits with room to spare
+#define FRAME_V2_MAX_SIZE (FRAME_V2_HEADER_SIZE + FRAME_V2_MAX_PAYLOAD + 2)
+#define FRAME_V2_TX_BUFFER_SIZE (2 + 2 * (FRAME_V2_HEADER_SIZE + MAX_PACKET_SIZE + 2))
+
+// CMD_DMX_DATA payload: [FLAGS][OFFSET_HI][OFFSET_LO][R G B ...]
+// OFFSET is the first pixel written; FLAGS bit 0 ends the frame
+#define DMX_DATA_HEADER_SIZE 3
+#define DMX_FLAG_PRESENT 0x01
+
 // Status codes for diagnostics
 #define STATUS_IDLE 0x00
 #define STATUS_RECEIVING 0x01
@@ -41,20 +66,54 @@
 #define STATUS_SENDING 0x03
 #define STATUS_ERROR 0xFF
 
+// Driver configuration - the IDF driver fills the RX ring buffer from the
+// UART interrupt, the RX task drains it on every data event
+#define UART_BRIDGE_RX_BUFFER_SIZE 4096
+#define UART_BRIDGE_TX_BUFFER_SIZE 1024
+#define UART_BRIDGE_EVENT_QUEUE_LENGTH 20
+#define UART_BRIDGE_COMMAND_QUEUE_LENGTH 8
+
+// Replies that only matter in their latest form (status, acks) wait in these
+// slots until the next flush, a newer reply with the same command replaces the old one
+#define UART_BRIDGE_COALESCE_SLOTS 4
+#define UART_BRIDGE_COALESCE_MAX_DATA 32
+#define UART_BRIDGE_MAX_BAUD 5000000
+#define UART_RX_TASK_STACK_SIZE 3072
+
+#ifndef UART_RX_TASK_CORE
+#define UART_RX_TASK_CORE 0
+#endif
+#ifndef UART_RX_TASK_PRIORITY
+#define UART_RX_TASK_PRIORITY 5
+#endif
+
 class UARTCommunicationBridge
 {
 public:
-    // Constructor takes UART port and baud rate
-    UARTCommunicationBridge(HardwareSerial &serial = Serial2, uint32_t baudRate = 115200);
+    // Constructor takes the UART port, baud rate (up to UART_BRIDGE_MAX_BAUD) and pins
+    UARTCommunicationBridge(uart_port_t port = UART_NUM_2, uint32_t baudRate = 115200,
+                            int rxPin = 16, int txPin = 17);
 
-    // Initialization
+    // Installs the UART driver and starts the RX task
     bool initializeCommunication();
 
     // Main processing functions
+    // Dispatches packets queued by the RX task - call from the main loop
     bool processIncomingData();
     void sendStatusUpdate();
     void handleModeSwitch(uint8_t mode);
 
+    // Replies use the framing of the last valid packet received (1 or 2)
+    uint8_t getProtocolVersion() const { return protocolVersion; }
+    void setProtocolVersion(uint8_t version) { protocolVersion = (version == FRAME_VERSION_2) ? 2 : 1; }
+
+    // v2 frames missing between two received sequence numbers
+    uint32_t getSequenceGaps() const { return sequenceGaps; }
+
+    // Change the line rate without reinstalling the driver
+    bool setBaudRate(uint32_t baud);
+    uint32_t getBaudRate() const { return baudRate; }
+
     // Diagnostic methods
     void printSystemDiagnostics();
     uint8_t getLastError() const { return lastError; }
@@ -64,45 +123,116 @@ public:
     typedef void (*CommandCallback)(uint8_t cmd, uint8_t *data, uint16_t length);
     void setCommandCallback(CommandCallback callback) { commandCallback = callback; }
 
+    // CMD_DMX_DATA is handed over from the RX task itself so pixel data never
+    // waits for the main loop; the callback must not block
+    typedef void (*DmxDataCallback)(uint16_t pixelOffset, const uint8_t *data, uint16_t numChannels, bool present);
+    void setDmxDataCallback(DmxDataCallback callback) { dmxDataCallback = callback; }
+
     // Error handling
     void setLastError(uint8_t error);
     bool sendErrorMessage(uint8_t errorCode, const char *message = nullptr);
 
     // Packet construction and parsing
+    // Copies the packet into the driver TX ring buffer and returns, the TX FIFO
+    // interrupt shifts it out
     bool sendCommand(uint8_t command, uint8_t *data = nullptr, uint16_t length = 0);
 
+    // Coalesced send - sent on the next flushPendingCommands(), which
+    // processIncomingData() and update() do after dispatching
+    bool postCommand(uint8_t command, const uint8_t *data = nullptr, uint16_t length = 0);
+    void flushPendingCommands();
+
     // Processing loop - call this in the main loop
     void update();
 
 private:
+    // A validated packet waiting for the main loop
+    struct QueuedPacket
+    {
+        uint8_t command;
+        uint16_t length;
+        uint8_t data[MAX_PACKET_SIZE];
+    };
+
+    // A coalesced reply waiting for the next flush
+    struct PendingCommand
+    {
+        bool pending;
+        uint8_t command;
+        uint16_t length;
+        uint8_t data[UART_BRIDGE_COALESCE_MAX_DATA];
+    };
+
+    // Receive state machine - which framing the bytes in receiveBuffer belong to
+    enum RxFormat : uint8_t
+    {
+        RX_IDLE,    // Waiting for START_BYTE or FRAME_FLAG
+        RX_V1,      // Inside a v1 packet, bytes are taken verbatim
+        RX_V2,      // Inside a v2 frame, bytes are unstuffed
+        RX_V2_SKIP  // Discarding a bad v2 frame until the next FRAME_FLAG
+    };
+
     // Internal state variables
-    HardwareSerial &uart;
+    uart_port_t port;
     uint32_t baudRate;
+    int rxPin;
+    int txPin;
     bool initialized;
-    uint8_t lastError;
+    volatile uint8_t lastError;
     unsigned long lastReceiveTime;
     unsigned long lastStatusUpdate;
 
+    // Driver and task handles
+    QueueHandle_t eventQueue;
+    QueueHandle_t commandQueue;
+    TaskHandle_t rxTaskHandle;
+
     // Communication buffers
-    uint8_t receiveBuffer[MAX_PACKET_SIZE];
+    // receiveBuffer and the rx* state belong to the RX task
+    uint8_t receiveBuffer[FRAME_V2_MAX_SIZE];
     uint16_t receiveIndex;
-    uint8_t packetBuffer[MAX_PACKET_SIZE];
+    RxFormat rxFormat;
+    bool rxEscape;
+    uint8_t rxSequence;     // Sequence number expected next
+    bool rxSequenceValid;
+    uint8_t packetBuffer[FRAME_V2_TX_BUFFER_SIZE];
+    uint8_t txSequence;
+    volatile uint8_t protocolVersion;
+    QueuedPacket rxQueuedPacket; // Staging copy, kept off the RX task stack
+    PendingCommand pendingCommands[UART_BRIDGE_COALESCE_SLOTS];
 
     // Status tracking
-    uint8_t currentStatus;
+    volatile uint8_t currentStatus;
     uint32_t statusUpdateInterval; // in milliseconds
     uint32_t packetsSent;
-    uint32_t packetsReceived;
-    uint32_t errorCount;
-
-    // Callback function
+    uint32_t packetsCoalesced;
+    volatile uint32_t packetsReceived;
+    volatile uint32_t dmxPacketsReceived;
+    volatile uint32_t errorCount;
+    volatile uint32_t rxOverflows;
+    volatile uint32_t packetsDropped; // Command queue full
+    volatile uint32_t sequenceGaps;
+
+    // Callback functions
     CommandCallback commandCallback;
+    DmxDataCallback dmxDataCallback;
 
     // Internal helper methods
+    static void rxTask(void *parameter);
+    void receiveLoop();
+    void consumeBytes(const uint8_t *bytes, size_t length);
+    void consumeV1Byte(uint8_t incomingByte);
+    void consumeV2Byte(uint8_t incomingByte);
+    void completeV1Packet();
+    void completeV2Frame();
+    void handlePacket(uint8_t command, uint8_t *data, uint16_t length);
     uint8_t calculateChecksum(uint8_t *data, uint16_t length);
+    static uint16_t calculateCRC16(const uint8_t *data, uint16_t length, uint16_t crc = 0xFFFF);
     bool validatePacket(uint8_t *packet, uint16_t length);
-    void processPacket(uint8_t *packet, uint16_t length);
+    void processPacket(uint8_t command, uint8_t *data, uint16_t length);
+    uint16_t buildV1Packet(uint8_t command, const uint8_t *data, uint16_t length);
+    uint16_t buildV2Frame(uint8_t command, const uint8_t *data, uint16_t length);
     void resetReceiveBuffer();
 };
 
-#endif // UART_COMMUNICATION_BRIDGE_H
\ No newline at end of file
+#endif // UART_COMMUNICATION_BRIDGE_H
@@ -0,0 +1,558 @@
+#include "WebServerManager.h"
+#include "EmbeddedWebUI.h"
+
+// Define global web server
+AsyncWebServer server(80);
+AsyncWebSocket liveSocket(WEB_LIVE_VIEW_PATH);
+
+// Control messages are only recorded by the socket handler (AsyncTCP task) and
+// applied from webServerLoop(), latest value wins
+static WebControlHandler controlHandler = NULL;
+static volatile int16_t pendingBrightness = -1;
+static volatile int16_t pendingMode = -1;
+static volatile bool pendingColor = false;
+static uint8_t pendingColorRGB[3];
+static uint8_t liveMode = LIVE_VIEW_MODE_ARTNET;
+static CRGB liveColor = CRGB::White;
+static unsigned long lastLivePushMs = 0;
+static uint8_t liveMessage[LIVE_VIEW_MAX_MESSAGE_SIZE];
+
+// Debug logging function with timestamps
+void logWithTimestamp(const String &message)
+{
+  unsigned long uptime = millis();
+  unsigned long seconds = uptime / 1000;
+  unsigned long minutes = seconds / 60;
+  seconds %= 60;
+
+  String formattedMsg = "[" + String(minutes) + ":" +
+                        (seconds < 10 ? "0" : "") + String(seconds) + "." +
+                        String(uptime % 1000) + "] " + message;
+
+  debugLog(formattedMsg);
+}
+
+// Main function to set up the web server
+void setupWebServer(WebRouteSetup sketchRoutes)
+{
+  // Initialize SPIFFS first
+  bool spiffsInitialized = SPIFFS.begin(true);
+  if (!spiffsInitialized)
+  {
+    logWithTimestamp("ERROR: SPIFFS mount failed, will use embedded HTML fallback");
+  }
+  else
+  {
+    logWithTimestamp("SPIFFS mounted successfully");
+
+    // List files in SPIFFS for debugging
+    File root = SPIFFS.open("/");
+    if (root && root.isDirectory())
+    {
+      File file = root.openNextFile();
+      logWithTimestamp("SPIFFS content:");
+      int fileCount = 0;
+      while (file)
+      {
+        String fileName = file.name();
+        int fileSize = file.size();
+        logWithTimestamp("  • " + fileName + " (" + String(fileSize) + " bytes)");
+        file = root.openNextFile();
+        fileCount++;
+      }
+
+      if (fileCount == 0)
+      {
+        logWithTimestamp("  • No files found in SPIFFS");
+      }
+    }
+    else
+    {
+      logWithTimestamp("Failed to open SPIFFS root directory");
+    }
+  }
+
+  // Sketch routes first so they take precedence over the defaults below
+  if (sketchRoutes != NULL)
+  {
+    sketchRoutes(server);
+  }
+
+  // Set up root route handler based on whether SPIFFS is available
+  if (spiffsInitialized && SPIFFS.exists("/index.html"))
+  {
+    logWithTimestamp("Web UI source: SPIFFS files");
+
+    // Serve the root page from SPIFFS
+    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+      logWithTimestamp("Serving index.html from SPIFFS");
+      request->send(SPIFFS, "/index.html", "text/html"); });
+
+    // Serve CSS from SPIFFS
+    server.on("/style.css", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+      logWithTimestamp("Serving style.css from SPIFFS");
+      request->send(SPIFFS, "/style.css", "text/css"); });
+
+    // Serve JavaScript from SPIFFS
+    server.on("/script.js", HTTP_GET, [](AsyncWebServerRequest *request)
+              {
+      logWithTimestamp("Serving script.js from SPIFFS");
+      request->send(SPIFFS, "/script.js", "application/javascript"); });
+  }
+  else
+  {
+    logWithTimestamp("Web UI source: Embedded HTML (SPIFFS files not found)");
+
+    // Serve the root page using embedded HTML
+    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request)
+              { handleEmbeddedUI(request); });
+  }
+
+  // Always set up the /settings endpoint for JSON API
+  server.on("/settings", HTTP_GET, [](AsyncWebServerRequest *request)
+            {
+    logRingWrite(LOG_LEVEL_DEBUG, "Serving /settings endpoint (JSON)");
+    handleSettings(request); });
+
+  // Set up endpoint for debug logs
+  server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request)
+            {
+    logRingWrite(LOG_LEVEL_DEBUG, "Serving /logs endpoint (JSON)");
+    handleLog(request); });
+
+  // Hot-path timings and packet/frame counters, ?reset=1 clears them after reading
+  server.on("/stats", HTTP_GET, [](AsyncWebServerRequest *request)
+            { handleStats(request); });
+
+  // Set up POST handler for config updates
+  server.on("/config", HTTP_POST, [](AsyncWebServerRequest *request)
+            {
+    logWithTimestamp("Received configuration POST request");
+    handleConfigPost(request); },
+            // Handle file uploads if needed
+            NULL,
+            // Handle body data for POST requests
+            [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+            {
+              // This handler processes POST body data - implement if needed for JSON data
+            });
+
+  // Live view and control channel, see LiveView.h for the binary message format
+  liveSocket.onEvent(onLiveSocketEvent);
+  server.addHandler(&liveSocket);
+
+  // Set up a handler for 404 errors
+  server.onNotFound([](AsyncWebServerRequest *request)
+                    {
+    logWithTimestamp("404 Not Found: " + request->url());
+    request->send(404, "text/plain", "Not found"); });
+
+  // Start the server
+  server.begin();
+  logWithTimestamp("AsyncWebServer started on port 80");
+}
+
+// Connects and binary control messages on the live view socket
+void onLiveSocketEvent(AsyncWebSocket *socket, AsyncWebSocketClient *client, AwsEventType type,
+                       void *arg, uint8_t *data, size_t len)
+{
+  switch (type)
+  {
+  case WS_EVT_CONNECT:
+    if (socket->count() > WEB_LIVE_VIEW_MAX_CLIENTS)
+    {
+      client->close();
+      return;
+    }
+    liveViewSetSubscribers(socket->count());
+    break;
+
+  case WS_EVT_DATA:
+  {
+    // Control messages are a few bytes - only whole, unfragmented binary frames are accepted
+    AwsFrameInfo *info = (AwsFrameInfo *)arg;
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_BINARY || len < 2)
+    {
+      return;
+    }
+    if (data[0] == LIVE_VIEW_CMD_BRIGHTNESS)
+    {
+      pendingBrightness = data[1];
+    }
+    else if (data[0] == LIVE_VIEW_CMD_MODE)
+    {
+      pendingMode = data[1];
+    }
+    else if (data[0] == LIVE_VIEW_CMD_COLOR && len >= 4)
+    {
+      memcpy(pendingColorRGB, data + 1, 3);
+      pendingColor = true;
+    }
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+// Fill the strip directly - used while no receiver or render task owns the LEDs.
+// FastLED runs at full brightness (the pixel kernel applies it), so scale here.
+static void showLiveColor(const CRGB &color)
+{
+  uint16_t scale = settings.brightness + 1;
+  CRGB scaled((color.r * scale) >> 8, (color.g * scale) >> 8, (color.b * scale) >> 8);
+  uint16_t count = min(settings.ledCount, ledBufferSize);
+  fill_solid(leds, count, scaled);
+  FastLED.show();
+  liveViewFrameShown((const uint8_t *)leds, count * 3);
+}
+
+// Default control handler - off, ArtNet or a static color
+static void applyLiveControl(uint8_t command, const uint8_t *data, size_t length)
+{
+  switch (command)
+  {
+  case LIVE_VIEW_CMD_BRIGHTNESS:
+    // ArtNet frames pick it up through the pixel kernel LUT on the next frame
+    settings.brightness = data[0];
+    if (liveMode == LIVE_VIEW_MODE_STATIC)
+    {
+      showLiveColor(liveColor);
+    }
+    break;
+
+  case LIVE_VIEW_CMD_COLOR:
+    liveColor = CRGB(data[0], data[1], data[2]);
+    if (liveMode == LIVE_VIEW_MODE_STATIC)
+    {
+      showLiveColor(liveColor);
+    }
+    break;
+
+  case LIVE_VIEW_CMD_MODE:
+    if (data[0] == LIVE_VIEW_MODE_ARTNET)
+    {
+      liveMode = setupArtNet() ? LIVE_VIEW_MODE_ARTNET : liveMode;
+    }
+    else if (data[0] == LIVE_VIEW_MODE_OFF || data[0] == LIVE_VIEW_MODE_STATIC)
+    {
+      stopArtNet();
+      liveMode = data[0];
+      showLiveColor(liveMode == LIVE_VIEW_MODE_STATIC ? liveColor : CRGB::Black);
+    }
+    break;
+  }
+}
+
+void webServerSetControlHandler(WebControlHandler handler)
+{
+  controlHandler = handler;
+}
+
+// Apply pending control messages and push the live view at its capped rate
+void webServerLoop()
+{
+  WebControlHandler handler = controlHandler != NULL ? controlHandler : applyLiveControl;
+
+  if (pendingMode >= 0)
+  {
+    uint8_t mode = pendingMode;
+    pendingMode = -1;
+    handler(LIVE_VIEW_CMD_MODE, &mode, 1);
+  }
+  if (pendingColor)
+  {
+    pendingColor = false;
+    handler(LIVE_VIEW_CMD_COLOR, pendingColorRGB, 3);
+  }
+  if (pendingBrightness >= 0)
+  {
+    uint8_t brightness = pendingBrightness;
+    pendingBrightness = -1;
+    handler(LIVE_VIEW_CMD_BRIGHTNESS, &brightness, 1);
+  }
+  if (handler == applyLiveControl)
+  {
+    liveViewSetStatus(liveMode, settings.brightness);
+  }
+
+  unsigned long now = millis();
+  if (now - lastLivePushMs < LIVE_VIEW_INTERVAL_MS)
+  {
+    return;
+  }
+  lastLivePushMs = now;
+  liveSocket.cleanupClients(WEB_LIVE_VIEW_MAX_CLIENTS);
+  // Disconnects are picked up here, captures stop once the last viewer is gone
+  liveViewSetSubscribers(liveSocket.count());
+
+  // Skip this push rather than queue behind a slow client
+  if (liveSocket.count() == 0 || !liveSocket.availableForWriteAll())
+  {
+    return;
+  }
+
+  uint16_t length = liveViewBuildMessage(liveMessage, sizeof(liveMessage));
+  if (length > 0)
+  {
+    liveSocket.binaryAll(liveMessage, length);
+  }
+}
+
+// Handler for the /stats endpoint
+void handleStats(AsyncWebServerRequest *request)
+{
+  request->send(200, "application/json", perfStatsJson());
+
+  if (request->hasParam("reset"))
+  {
+    perfReset();
+  }
+}
+
+// Handler for the /settings endpoint
+void handleSettings(AsyncWebServerRequest *request)
+{
+  // Serialized once into a fixed buffer owned by the response, then copied
+  // straight into the TCP send buffer as the connection drains
+  JsonSnapshot snapshot;
+  StaticJsonDocument<WEB_SETTINGS_DOC_SIZE> doc;
+
+  // Add basic settings
+  doc["ssid"] = (const char *)settings.ssid;
+  doc["useWiFi"] = settings.useWiFi;
+  doc["nodeName"] = (const char *)settings.nodeName;
+  doc["artnetUniverse"] = settings.artnetUniverse;
+  doc["artnetUniverseCount"] = settings.artnetUniverseCount;
+  doc["ledCount"] = settings.ledCount;
+  doc["ledPin"] = settings.ledPin;
+  doc["brightness"] = settings.brightness;
+  doc["gamma"] = settings.gamma;
+  doc["maxFps"] = settings.maxFps;
+  doc["interpolateFrames"] = settings.interpolateFrames;
+  doc["fastBoot"] = settings.fastBoot;
+  doc["artnetEnabled"] = settings.artnetEnabled;
+  doc["sacnEnabled"] = settings.sacnEnabled;
+
+  // Limits for the embedded UI form
+  doc["maxFpsLimit"] = FRAME_MAX_FPS_LIMIT;
+  doc["maxUniverses"] = FRAME_MAX_UNIVERSES;
+
+  // Add runtime information
+  bool connected = WiFi.status() == WL_CONNECTED;
+  char ipAddress[16];
+  snprintf(ipAddress, sizeof(ipAddress), "%s", connected ? WiFi.localIP().toString().c_str() : "Not connected");
+  doc["ipAddress"] = ipAddress;
+  doc["wifiConnected"] = connected;
+  doc["rssi"] = connected ? WiFi.RSSI() : 0;
+  doc["uptime"] = millis() / 1000;
+  doc["freeHeap"] = ESP.getFreeHeap();
+
+  // Add ArtNet status
+  doc["artnetRunning"] = state.artnetRunning;
+  doc["artnetPacketCount"] = state.artnetPacketCount;
+  doc["lastArtnetPacket"] = state.lastArtnetPacket;
+
+  snapshot.length = serializeJson(doc, snapshot.json, sizeof(snapshot.json));
+
+  request->send(request->beginResponse("application/json", snapshot.length,
+                                       [snapshot](uint8_t *buffer, size_t maxLen, size_t index) -> size_t
+                                       {
+                                         size_t count = min(maxLen, snapshot.length - index);
+                                         memcpy(buffer, snapshot.json + index, count);
+                                         return count;
+                                       }));
+}
+
+// Escape one log line as a JSON string element, with a leading comma unless it is the first
+static uint16_t appendLogJsonLine(char *out, const char *line, bool first)
+{
+  uint16_t length = 0;
+  if (!first)
+  {
+    out[length++] = ',';
+  }
+  out[length++] = '"';
+  for (const char *c = line; *c != '\0'; c++)
+  {
+    if (*c == '"' || *c == '\\')
+    {
+      out[length++] = '\\';
+      out[length++] = *c;
+    }
+    else
+    {
+      out[length++] = (uint8_t)*c < 0x20 ? ' ' : *c; // Control characters are replaced, not escaped
+    }
+  }
+  out[length++] = '"';
+  return length;
+}
+
+// Produce the next piece of the /logs document into stream->pending, false once it is complete
+static bool nextLogJsonPiece(LogJsonStream &stream)
+{
+  stream.pendingPos = 0;
+  stream.pendingLen = 0;
+  if (!stream.opened)
+  {
+    stream.opened = true;
+    stream.pendingLen = strlcpy(stream.pending, "{\"logs\":[", sizeof(stream.pending));
+    return true;
+  }
+
+  char line[LOG_RING_LINE_SIZE];
+  while (stream.next != stream.end)
+  {
+    if (logRingLine(stream.next++, line, sizeof(line)))
+    {
+      stream.pendingLen = appendLogJsonLine(stream.pending, line, stream.first);
+      stream.first = false;
+      return true;
+    }
+  }
+
+  if (!stream.closed)
+  {
+    stream.closed = true;
+    stream.pendingLen = strlcpy(stream.pending, "]}", sizeof(stream.pending));
+    return true;
+  }
+  return false;
+}
+
+// Handler for the /logs endpoint
+void handleLog(AsyncWebServerRequest *request)
+{
+  // Chunked: each record of the log ring is formatted and escaped only when the
+  // TCP send buffer has room for it, so the response never exists in RAM as a whole
+  LogJsonStream stream;
+  stream.end = logRingHead();
+  stream.next = logRingOldest(MAX_LOG_ENTRIES);
+
+  request->send(request->beginChunkedResponse("application/json",
+                                              [stream](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t
+                                              {
+                                                size_t written = 0;
+                                                while (written < maxLen)
+                                                {
+                                                  if (stream.pendingPos == stream.pendingLen && !nextLogJsonPiece(stream))
+                                                  {
+                                                    break;
+                                                  }
+                                                  size_t count = min(maxLen - written, (size_t)(stream.pendingLen - stream.pendingPos));
+                                                  memcpy(buffer + written, stream.pending + stream.pendingPos, count);
+                                                  stream.pendingPos += count;
+                                                  written += count;
+                                                }
+                                                return written;
+                                              }));
+}
+
+// Serve the gzip-compressed embedded UI straight from flash (see scripts/embed_web_ui.py)
+void handleEmbeddedUI(AsyncWebServerRequest *request)
+{
+  AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", EMBEDDED_UI_GZ, EMBEDDED_UI_GZ_LENGTH);
+  response->addHeader("Content-Encoding", "gzip");
+  request->send(response);
+}
+
+// Handle form submission
+void handleConfigPost(AsyncWebServerRequest *request)
+{
+  logWithTimestamp("Processing configuration form submission");
+
+  // Process form parameters
+  int paramsNr = request->params();
+  for (int i = 0; i < paramsNr; i++)
+  {
+    // Fix the invalid conversion by using const explicitly
+    const AsyncWebParameter *p = request->getParam(i);
+    logWithTimestamp("  • Parameter: " + p->name() + " = " + p->value());
+
+    // Process each parameter
+    String paramName = p->name();
+    String paramValue = p->value();
+
+    if (paramName == "ssid")
+    {
+      strlcpy(settings.ssid, paramValue.c_str(), sizeof(settings.ssid));
+    }
+    else if (paramName == "password")
+    {
+      // The page never receives the stored password, so an empty field keeps it
+      if (paramValue.length() > 0)
+      {
+        strlcpy(settings.password, paramValue.c_str(), sizeof(settings.password));
+      }
+    }
+    else if (paramName == "useWiFi")
+    {
+      settings.useWiFi = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
+    else if (paramName == "nodeName")
+    {
+      strlcpy(settings.nodeName, paramValue.c_str(), sizeof(settings.nodeName));
+    }
+    else if (paramName == "ledCount")
+    {
+      settings.ledCount = paramValue.toInt();
+    }
+    else if (paramName == "ledPin")
+    {
+      settings.ledPin = paramValue.toInt();
+    }
+    else if (paramName == "brightness")
+    {
+      settings.brightness = paramValue.toInt();
+    }
+    else if (paramName == "gamma")
+    {
+      settings.gamma = constrain(paramValue.toFloat(), PIXEL_MIN_GAMMA, PIXEL_MAX_GAMMA);
+    }
+    else if (paramName == "maxFps")
+    {
+      settings.maxFps = constrain((int)paramValue.toInt(), 0, FRAME_MAX_FPS_LIMIT);
+      framePipelineSetMaxFps(settings.maxFps);
+    }
+    else if (paramName == "interpolateFrames")
+    {
+      settings.interpolateFrames = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+      framePipelineSetInterpolation(settings.interpolateFrames);
+    }
+    else if (paramName == "fastBoot")
+    {
+      settings.fastBoot = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
+    else if (paramName == "artnetUniverse")
+    {
+      settings.artnetUniverse = paramValue.toInt();
+    }
+    else if (paramName == "artnetUniverseCount")
+    {
+      settings.artnetUniverseCount = constrain((int)paramValue.toInt(), 1, FRAME_MAX_UNIVERSES);
+    }
+    else if (paramName == "artnetEnabled")
+    {
+      settings.artnetEnabled = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
+    else if (paramName == "sacnEnabled")
+    {
+      settings.sacnEnabled = (paramValue == "on" || paramValue == "1" || paramValue == "true");
+    }
+  }
+
+  // If network settings changed, mark for restart
+  settingsStoreSetFlag(SETTINGS_FLAG_NET_RESTART, true);
+
+  // Save settings
+  // Here you would typically call some function to save the settings to preferences
+  // This would need to be implemented based on your existing code structure
+
+  // Redirect back to the root page
+  request->redirect("/");
+  logWithTimestamp("Configuration updated, redirecting to home page");
+}
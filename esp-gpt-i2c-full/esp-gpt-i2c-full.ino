@@ -3,38 +3,180 @@
 // Features: Artnet, web interface config, OLED status, debug log
 
 #include <WiFi.h>
-#include <WebServer.h>
 #include <Adafruit_NeoPixel.h> // Add NeoPixel library for the test function
 
 // Include the common code
 #include "ESP_GPT_I2C_Common.h"
+#include "FramePipeline.h"
+#include "LedLayout.h"
+#include "ArtNetBenchmark.h"
+#include "WebServerManager.h"
+#include "StatusDisplay.h"
 
 // Define constants that are used early in the code
 #define UNIVERSE_SIZE 510
 #define MAX_STRIPS 12       // 4 pins × 3 strips per pin
 #define PACKET_TIMEOUT 5000 // 5 seconds without packets is a timeout
 
+// Local mode refresh - static colors are checked this often but only re-sent when
+// they changed, effects follow maxFps (this period when the cap is off)
+#define STATIC_REFRESH_MS 50
+#define EFFECT_FRAME_MS 20
+
 // This must be defined before including I2SClocklessLedDriver.h
 #ifndef NUM_LEDS_PER_STRIP
 #define NUM_LEDS_PER_STRIP 144 // Define this before library includes
 #endif
 
 #include "I2SClocklessLedDriver.h"
-#include "artnetESP32V2.h"
-#include <Adafruit_SSD1306.h>
-#include <Adafruit_GFX.h>
 #include "UARTCommunicationBridge.h"
 
 // Define the UART pin configuration for the communication bridge
 #define UART_RX_PIN 16 // GPIO pin for UART RX
 #define UART_TX_PIN 17 // GPIO pin for UART TX
+#define UART_BAUD_RATE 115200 // Up to UART_BRIDGE_MAX_BAUD when the host keeps up
+
+// Serial pixel streaming hands the LEDs back once no CMD_DMX_DATA arrived for this long
+#define SERIAL_STREAM_TIMEOUT_MS 2000
 
-// Create a UART bridge instance using Serial2
-UARTCommunicationBridge uartBridge(Serial2);
+// ArtNet / sACN receivers that could not start yet (WiFi still connecting) are retried this often
+#define RECEIVER_RETRY_MS 5000
+
+// Create a UART bridge instance on UART2, driven by the IDF UART driver
+UARTCommunicationBridge uartBridge(UART_NUM_2, UART_BAUD_RATE, UART_RX_PIN, UART_TX_PIN);
 
 // UART command handler callback
 void handleUARTCommand(uint8_t cmd, uint8_t *data, uint16_t length);
 
+// UART pixel data callback, runs in the UART RX task
+void handleUARTDmxData(uint16_t pixelOffset, const uint8_t *data, uint16_t numChannels, bool present);
+
+// Settings are persisted as one blob by SettingsStore - changes mark their field
+// group dirty and loop() commits once they stop for SETTINGS_STORE_QUIET_MS, so a
+// fader sweep costs one NVS write instead of one per step
+#define SETTINGS_FIELD_NETWORK 0x01 // Credentials, node name, universe, WiFi use
+#define SETTINGS_FIELD_OUTPUT 0x02  // Strips, brightness, gamma, fps, backend, boot
+#define SETTINGS_FIELD_MODE 0x04    // Mode flags, effect, speed, static color
+#define SETTINGS_FIELD_ALL 0x07
+#define PERSISTED_SETTINGS_VERSION 2
+
+// Stored settings record - plain bytes, no String. Fields are only ever appended,
+// so older records load as a prefix and new fields keep their defaults.
+struct __attribute__((packed)) PersistedSettings
+{
+  char ssid[SETTINGS_SSID_SIZE];
+  char password[SETTINGS_PASSWORD_SIZE];
+  char nodeName[SETTINGS_NODE_NAME_SIZE];
+  uint8_t useWiFi;
+  int16_t startUniverse;
+
+  uint8_t numStrips;
+  uint16_t ledsPerStrip;
+  int8_t pins[MAX_STRIPS];
+  uint8_t brightness;
+  float gamma;
+  uint8_t maxFps;
+  uint8_t interpolateFrames;
+  uint8_t fastBoot;
+  uint8_t outputBackend;
+
+  uint8_t useArtnet;
+  uint8_t useColorCycle;
+  uint8_t useStaticColor;
+  uint8_t colorMode;
+  uint8_t cycleSpeed;
+  uint8_t staticColor[3];
+
+  // Version 2
+  uint8_t useSacn;
+};
+
+static_assert(sizeof(PersistedSettings) <= SETTINGS_STORE_MAX_SIZE, "PersistedSettings outgrew SETTINGS_STORE_MAX_SIZE");
+
+PersistedSettings persistedSettings;
+
+// Task topology - every stage has its own pinned task, stages hand over through
+// bounded queues or the frame pipeline's buffers:
+//   core 0: network RX (lwIP / AsyncTCP: ArtNet, web), UART RX, I2C slave,
+//           housekeeping, the OLED (StatusDisplay.h) and the log formatter
+//   core 1: loop() - control and local modes - and the FramePipeline render task
+// Runtime and stack high-water marks of all tasks are reported under /stats "tasks".
+
+// Web requests are handled in the AsyncTCP task - they are queued for loop(), and
+// a full queue is answered with 503 instead of blocking the web server
+#define CONTROL_QUEUE_LENGTH 4
+
+enum ControlRequestType : uint8_t
+{
+  CONTROL_APPLY_CONFIG,
+  CONTROL_START_BENCHMARK,
+  CONTROL_RESTART
+};
+
+// Config page form, parsed and range-checked by the web handler - loop() applies
+// it, so the AsyncTCP task never writes the live settings or NVS
+#define CONFIG_HAS_BRIGHTNESS 0x0001
+#define CONFIG_HAS_GAMMA 0x0002
+#define CONFIG_HAS_FPS 0x0004
+#define CONFIG_HAS_BACKEND 0x0008
+#define CONFIG_HAS_LAYOUT 0x0010
+#define CONFIG_HAS_SSID 0x0020
+#define CONFIG_HAS_PASSWORD 0x0040
+#define CONFIG_HAS_NODE_NAME 0x0080
+#define CONFIG_HAS_COLOR_MODE 0x0100
+#define CONFIG_HAS_CYCLE_SPEED 0x0200
+#define CONFIG_HAS_STATIC_COLOR 0x0400
+
+struct ConfigUpdate
+{
+  uint16_t present; // CONFIG_HAS_* of the fields the form sent
+  uint8_t brightness;
+  float gamma;
+  uint8_t maxFps;
+  uint8_t outputBackend;
+  bool interpolateFrames;
+  bool fastBoot;
+  bool useArtnet;
+  bool useSacn;
+  bool useColorCycle;
+  bool useStaticColor;
+  uint8_t colorMode;
+  uint8_t cycleSpeed;
+  uint8_t staticColor[3];
+  char ssid[SETTINGS_SSID_SIZE];
+  char password[SETTINGS_PASSWORD_SIZE];
+  char nodeName[SETTINGS_NODE_NAME_SIZE];
+  LedLayout layout; // Already validated
+};
+
+struct ControlRequest
+{
+  ControlRequestType type;
+  BenchmarkConfig benchmark; // CONTROL_START_BENCHMARK only
+  ConfigUpdate config;       // CONTROL_APPLY_CONFIG and CONTROL_RESTART
+};
+
+QueueHandle_t controlQueue = NULL;
+bool postControlRequest(ControlRequestType type, const BenchmarkConfig *benchmark = NULL);
+bool postControlRequest(const ControlRequest &request);
+
+// Housekeeping: status publishing, ArtPoll replies and task statistics, off the LED core
+#define HOUSEKEEPING_TASK_STACK_SIZE 4096
+#define HOUSEKEEPING_TASK_PRIORITY 1
+#define HOUSEKEEPING_TASK_CORE 0
+#define HOUSEKEEPING_PERIOD_MS 100
+#define STATUS_UPDATE_INTERVAL_MS 5000
+TaskHandle_t housekeepingTaskHandle = NULL;
+
+// Boot sequence - with fullSettings.fastBoot the output starts before networking
+bool networkServicesStarted = false;
+bool bootFrameShown = false; // The RTC snapshot was restored onto the strips
+
+// Serial streaming state - set from the RX task, acted on in loop()
+volatile bool serialStreamRequested = false;
+volatile unsigned long lastSerialDmx = 0;
+bool serialStreamActive = false;
+
 // DMX data buffer for storing the most recent ArtNet data
 uint8_t dmxData[UNIVERSE_SIZE];
 unsigned long lastPacketTime = 0;
@@ -42,10 +184,6 @@ uint32_t packetsReceived = 0;
 
 // ====== CONFIGURATION ======
 #define STATUS_LED_PIN 16
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 32
-#define OLED_RESET -1
-#define SCREEN_ADDRESS 0x3C
 
 #define NUMSTRIPS 1
 #define NB_CHANNEL_PER_LED 3
@@ -55,11 +193,12 @@ uint32_t packetsReceived = 0;
 #undef MAX_LOG_ENTRIES
 #define MAX_LOG_ENTRIES 50
 
-// Color cycle modes
+// Color cycle modes - any other value is an LedEffects registry id (EFFECT_ID_*)
 #define COLOR_MODE_STATIC 0
-#define COLOR_MODE_RAINBOW 1
-#define COLOR_MODE_PULSE 2
-#define COLOR_MODE_FIRE 3
+
+// LED output backends
+#define OUTPUT_BACKEND_FASTLED 0 // One RMT/bit-banged strip after another
+#define OUTPUT_BACKEND_I2S 1     // All strips clocked out in parallel by I2S DMA
 
 // ====== LED COLOR TYPE ======
 typedef struct
@@ -70,13 +209,21 @@ typedef struct
 } rgb24;
 
 // ====== GLOBAL OBJECTS ======
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
-WebServer server(80);
 I2SClocklessLedDriver driver;
-artnetESP32V2 artnet;
 
-rgb24 ledData[MAX_STRIPS * NUM_LEDS_PER_STRIP]; // Fixed error with NUM_LEDS_PER_STRIP
-bool sendFrame = false;
+// Active LED output - the layout maps slices of leds[] onto strips, and both
+// backends clock out a wire buffer packed from it in each strip's color order
+LedLayout ledLayout;
+int activeOutputBackend = OUTPUT_BACKEND_FASTLED;
+uint8_t *wireBuffer = NULL;
+uint16_t wireStride = 0; // Pixels per strip in the wire buffer, 0 when packed back to back
+
+// What the strips show when it came from leds[] - lets the local modes skip
+// re-sending an unchanged picture (see showLEDsIfChanged)
+uint32_t shownLedsHash = 0;
+uint32_t shownCorrectionId = 0;
+bool shownLedsHashValid = false;
+unsigned long lastLedsShow = 0;
 
 // Anti-boot loop protection
 // These are global variables to track critical errors and prevent retries
@@ -88,10 +235,12 @@ unsigned long lastBootTime = 0; // Time of last boot attempt
 // Extended settings structure for full version
 struct FullSettings : Settings
 {
+  // Uniform strip configuration used until an LED layout has been saved
   int numStrips;
   int ledsPerStrip;
-  int pins[4];
+  int pins[MAX_STRIPS];
   int brightness;
+  int outputBackend;
   int startUniverse;
 
   // Added settings for static color and mode controls
@@ -106,318 +255,614 @@ struct FullSettings : Settings
 // Initialize the settings with default values
 FullSettings fullSettings;
 
+// ArtNet and sACN are separate network inputs - either one puts the node in network mode
+bool networkInputEnabled()
+{
+  return fullSettings.useArtnet || fullSettings.sacnEnabled;
+}
+
 void initializeDefaultSettings()
 {
   // Base settings initialization
-  fullSettings.ssid = "Sage1";
-  fullSettings.password = "J@sper123";
+  strlcpy(fullSettings.ssid, "Sage1", sizeof(fullSettings.ssid));
+  strlcpy(fullSettings.password, "J@sper123", sizeof(fullSettings.password));
   fullSettings.useWiFi = false;
-  fullSettings.nodeName = "ESP32_Artnet_I2S";
+  strlcpy(fullSettings.nodeName, "ESP32_Artnet_I2S", sizeof(fullSettings.nodeName));
 
   // Extended settings initialization
   fullSettings.numStrips = 1;
   fullSettings.ledsPerStrip = 144;
   fullSettings.pins[0] = 12;
-  fullSettings.pins[1] = -1;
-  fullSettings.pins[2] = -1;
-  fullSettings.pins[3] = -1;
+  for (int i = 1; i < MAX_STRIPS; i++)
+  {
+    fullSettings.pins[i] = -1;
+  }
   fullSettings.brightness = 255;
+  fullSettings.gamma = PIXEL_DEFAULT_GAMMA;
+  fullSettings.maxFps = FRAME_DEFAULT_MAX_FPS;
+  fullSettings.interpolateFrames = false;
+  fullSettings.fastBoot = false;
+  fullSettings.outputBackend = OUTPUT_BACKEND_FASTLED;
   fullSettings.startUniverse = 0;
   fullSettings.useArtnet = false;
+  fullSettings.sacnEnabled = false;
   fullSettings.useColorCycle = false;
   fullSettings.useStaticColor = true;
-  fullSettings.colorMode = COLOR_MODE_RAINBOW;
+  fullSettings.colorMode = EFFECT_ID_RAINBOW;
   fullSettings.staticColor.r = 255;
   fullSettings.staticColor.g = 0;
   fullSettings.staticColor.b = 255;
   fullSettings.cycleSpeed = 50;
 }
 
-void handleDebugLog()
-{
-  String json = "[";
-  for (int i = 0; i < MAX_LOG_ENTRIES; i++)
-  {
-    int idx = (state.logIndex + i) % MAX_LOG_ENTRIES;
-    if (state.logs[idx].length())
-    {
-      if (i > 0)
-        json += ",";
-      json += "\"" + state.logs[idx] + "\"";
-    }
-  }
-  json += "]";
-  server.send(200, "application/json", json);
-}
-
 // ====== WEB UI ======
-void handleRoot()
+void handleRoot(AsyncWebServerRequest *request)
 {
-  String html = "<!DOCTYPE html><html><head>";
-  html += "<title>ESP32 Artnet Controller</title>";
-  html += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-  html += "<style>";
-  html += "body { font-family: Arial, sans-serif; margin: 20px; }";
-  html += ".form-group { margin-bottom: 15px; }";
-  html += "label { display: inline-block; width: 120px; }";
-  html += "input[type='number'], input[type='text'], input[type='password'] { width: 100px; }";
-  html += "input[type='color'] { width: 60px; height: 30px; }";
-  html += "input[type='checkbox'] { margin-right: 5px; }";
-  html += "select { width: 120px; }";
-  html += ".section { background: #f5f5f5; padding: 10px; margin-bottom: 15px; border-radius: 5px; }";
-  html += ".section h3 { margin-top: 0; }";
-  html += "button { background: #4CAF50; color: white; padding: 10px 15px; border: none; border-radius: 4px; cursor: pointer; }";
-  html += "button:hover { background: #45a049; }";
-  html += ".error-message { background: #ffebee; color: #c62828; padding: 10px; border-radius: 5px; margin-bottom: 15px; border-left: 5px solid #c62828; }";
-  html += "</style>";
-  html += "</head><body>";
-  html += "<h2>ESP32 Artnet LED Controller</h2>";
+  // Printed piece by piece into the response buffer instead of one page-sized String
+  AsyncResponseStream *html = request->beginResponseStream("text/html");
+  html->print("<!DOCTYPE html><html><head>");
+  html->print("<title>ESP32 Artnet Controller</title>");
+  html->print("<meta name='viewport' content='width=device-width, initial-scale=1'>");
+  html->print("<style>");
+  html->print("body { font-family: Arial, sans-serif; margin: 20px; }");
+  html->print(".form-group { margin-bottom: 15px; }");
+  html->print("label { display: inline-block; width: 120px; }");
+  html->print("input[type='number'], input[type='text'], input[type='password'] { width: 100px; }");
+  html->print("input[type='color'] { width: 60px; height: 30px; }");
+  html->print("input[type='checkbox'] { margin-right: 5px; }");
+  html->print("select { width: 120px; }");
+  html->print(".section { background: #f5f5f5; padding: 10px; margin-bottom: 15px; border-radius: 5px; }");
+  html->print(".section h3 { margin-top: 0; }");
+  html->print("button { background: #4CAF50; color: white; padding: 10px 15px; border: none; border-radius: 4px; cursor: pointer; }");
+  html->print("button:hover { background: #45a049; }");
+  html->print(".error-message { background: #ffebee; color: #c62828; padding: 10px; border-radius: 5px; margin-bottom: 15px; border-left: 5px solid #c62828; }");
+  html->print("</style>");
+  html->print("</head><body>");
+  html->print("<h2>ESP32 Artnet LED Controller</h2>");
 
   // CRITICAL FIX: Show a warning message if network has been disabled due to failures
   if (networkInitFailed)
   {
-    html += "<div class='error-message'>";
-    html += "<strong>NOTICE:</strong> Network functionality has been permanently disabled due to critical failures. ";
-    html += "This device will operate in standalone mode only. WiFi and ArtNet settings cannot be changed.";
-    html += "</div>";
+    html->print("<div class='error-message'>");
+    html->print("<strong>NOTICE:</strong> Network functionality has been permanently disabled due to critical failures. ");
+    html->print("This device will operate in standalone mode only. WiFi and ArtNet settings cannot be changed.");
+    html->print("</div>");
   }
 
-  html += "<form method='POST' action='/config'>";
+  html->print("<form method='POST' action='/config'>");
 
   // LED Configuration Section
-  html += "<div class='section'>";
-  html += "<h3>LED Configuration</h3>";
-  html += "<div class='form-group'><label>LEDs per Strip:</label><input type='number' name='leds' value='" + String(fullSettings.ledsPerStrip) + "'></div>";
-  html += "<div class='form-group'><label>Number of Strips:</label><input type='number' name='strips' value='" + String(fullSettings.numStrips) + "'></div>";
-  html += "<div class='form-group'><label>Brightness:</label><input type='range' min='0' max='255' name='bright' value='" + String(fullSettings.brightness) + "'></div>";
-
-  // Individual pin configuration
-  html += "<div class='form-group'><label>Pin Configuration:</label></div>";
-  html += "<div style='margin-left: 20px;'>";
-  for (int i = 0; i < 4; i++)
+  html->print("<div class='section'>");
+  html->print("<h3>LED Configuration</h3>");
+  html->print("<div class='form-group'><label>Brightness:</label><input type='range' min='0' max='255' name='bright' value='" + String(fullSettings.brightness) + "'></div>");
+  html->print("<div class='form-group'><label>Gamma:</label><input type='number' step='0.1' min='0.5' max='3' name='gamma' value='" + String(fullSettings.gamma, 1) + "'></div>");
+  html->print("<div class='form-group'><label>Max FPS:</label><input type='number' min='0' max='" + String(FRAME_MAX_FPS_LIMIT) + "' name='fps' value='" + String(fullSettings.maxFps) + "'> (0 = unlimited)</div>");
+  html->print("<div class='form-group'><input type='checkbox' id='smooth' name='smooth' value='1' " + String(fullSettings.interpolateFrames ? "checked" : "") + ">");
+  html->print("<label for='smooth'>Smooth fades between ArtNet frames (blends up to Max FPS)</label></div>");
+  html->print("<div class='form-group'><input type='checkbox' id='fastboot' name='fastboot' value='1' " + String(fullSettings.fastBoot ? "checked" : "") + ">");
+  html->print("<label for='fastboot'>Fast boot (no startup flash, last frame shown before WiFi connects)</label></div>");
+
+  // Output backend selection (takes effect after a restart)
+  html->print("<div class='form-group'><label for='backend'>Output:</label>");
+  html->print("<select name='backend' id='backend'>");
+  html->print("<option value='" + String(OUTPUT_BACKEND_FASTLED) + "'" + (fullSettings.outputBackend == OUTPUT_BACKEND_FASTLED ? " selected" : "") + ">FastLED (serial)</option>");
+  html->print("<option value='" + String(OUTPUT_BACKEND_I2S) + "'" + (fullSettings.outputBackend == OUTPUT_BACKEND_I2S ? " selected" : "") + ">I2S (parallel)</option>");
+  html->print("</select></div>");
+
+  // Output layout - one row per strip, rows with pin -1 are unused
+  html->print("<div class='form-group'><label>Output Layout:</label> pin, LEDs, color order, first pixel</div>");
+  html->print("<div style='margin-left: 20px;'>");
+  for (int i = 0; i < MAX_LED_STRIPS; i++)
   {
-    html += "<div class='form-group'><label>Pin " + String(i + 1) + ":</label>";
-    html += "<input type='number' min='-1' max='39' name='pin" + String(i) + "' value='" + String(fullSettings.pins[i]) + "'>";
-    html += "</div>";
+    LedOutputConfig output;
+    if (i < ledLayout.numOutputs)
+    {
+      output = ledLayout.outputs[i];
+    }
+
+    html->print("<div class='form-group'><label>Output " + String(i + 1) + ":</label>");
+    html->print("<input type='number' min='-1' max='33' name='pin" + String(i) + "' value='" + String(output.pin) + "'> ");
+    html->print("<input type='number' min='0' max='" + String(MAX_LEDS_PER_STRIP) + "' name='len" + String(i) + "' value='" + String(output.length) + "'> ");
+    html->print("<select name='order" + String(i) + "'>");
+    for (uint8_t order = 0; order < LED_ORDER_COUNT; order++)
+    {
+      html->print("<option" + String(output.colorOrder == order ? " selected" : "") + ">" + ledColorOrderName(order) + "</option>");
+    }
+    html->print("</select> ");
+    html->print("<input type='number' min='0' max='" + String(MAX_LEDS - 1) + "' name='start" + String(i) + "' value='" + String(output.startOffset) + "'>");
+    html->print("</div>");
   }
-  html += "</div>";
+  html->print("</div>");
 
-  html += "</div>";
+  html->print("</div>");
 
   // Mode Selection Section
-  html += "<div class='section'>";
-  html += "<h3>Mode Selection</h3>";
+  html->print("<div class='section'>");
+  html->print("<h3>Mode Selection</h3>");
 
   // ArtNet Mode Toggle
-  html += "<div class='form-group'>";
-  html += "<input type='checkbox' id='useArtnet' name='useArtnet' value='1' " + String(fullSettings.useArtnet ? "checked" : "") + ">";
-  html += "<label for='useArtnet'>Use ArtNet Mode</label>";
-  html += "</div>";
+  html->print("<div class='form-group'>");
+  html->print("<input type='checkbox' id='useArtnet' name='useArtnet' value='1' " + String(fullSettings.useArtnet ? "checked" : "") + ">");
+  html->print("<label for='useArtnet'>Use ArtNet Mode</label>");
+  html->print("</div>");
+
+  // sACN Mode Toggle - on its own or next to ArtNet, same universes numbered from E131_UNIVERSE_OFFSET
+  html->print("<div class='form-group'>");
+  html->print("<input type='checkbox' id='useSacn' name='useSacn' value='1' " + String(fullSettings.sacnEnabled ? "checked" : "") + ">");
+  html->print("<label for='useSacn'>Use sACN (E1.31) Mode, universe " + String(fullSettings.startUniverse + E131_UNIVERSE_OFFSET) + " up</label>");
+  html->print("</div>");
 
   // Static Color Toggle
-  html += "<div class='form-group'>";
-  html += "<input type='checkbox' id='useStaticColor' name='useStaticColor' value='1' " + String(fullSettings.useStaticColor ? "checked" : "") + ">";
-  html += "<label for='useStaticColor'>Use Static Color</label>";
-  html += "</div>";
+  html->print("<div class='form-group'>");
+  html->print("<input type='checkbox' id='useStaticColor' name='useStaticColor' value='1' " + String(fullSettings.useStaticColor ? "checked" : "") + ">");
+  html->print("<label for='useStaticColor'>Use Static Color</label>");
+  html->print("</div>");
 
   // Color Cycle Toggle
-  html += "<div class='form-group'>";
-  html += "<input type='checkbox' id='useColorCycle' name='useColorCycle' value='1' " + String(fullSettings.useColorCycle ? "checked" : "") + ">";
-  html += "<label for='useColorCycle'>Use Color Cycle Effects</label>";
-  html += "</div>";
+  html->print("<div class='form-group'>");
+  html->print("<input type='checkbox' id='useColorCycle' name='useColorCycle' value='1' " + String(fullSettings.useColorCycle ? "checked" : "") + ">");
+  html->print("<label for='useColorCycle'>Use Color Cycle Effects</label>");
+  html->print("</div>");
 
   // Color Mode Selection (only visible when color cycle is enabled)
-  html += "<div class='form-group' id='colorModeGroup'>";
-  html += "<label for='colorMode'>Color Mode:</label>";
-  html += "<select name='colorMode' id='colorMode'>";
-  html += "<option value='" + String(COLOR_MODE_RAINBOW) + "'" + (fullSettings.colorMode == COLOR_MODE_RAINBOW ? " selected" : "") + ">Rainbow</option>";
-  html += "<option value='" + String(COLOR_MODE_PULSE) + "'" + (fullSettings.colorMode == COLOR_MODE_PULSE ? " selected" : "") + ">Pulse</option>";
-  html += "<option value='" + String(COLOR_MODE_FIRE) + "'" + (fullSettings.colorMode == COLOR_MODE_FIRE ? " selected" : "") + ">Fire</option>";
-  html += "</select>";
-  html += "</div>";
-
-  // Static Color Selection (only visible when color cycle is disabled)
-  html += "<div class='form-group' id='staticColorGroup'>";
-  html += "<label for='staticColor'>Static Color:</label>";
-  html += "<input type='color' id='staticColor' name='staticColor' value='#" +
-          String(fullSettings.staticColor.r, HEX) + String(fullSettings.staticColor.g, HEX) + String(fullSettings.staticColor.b, HEX) + "'>";
-  html += "</div>";
+  html->print("<div class='form-group' id='colorModeGroup'>");
+  html->print("<label for='colorMode'>Color Mode:</label>");
+  html->print("<select name='colorMode' id='colorMode'>");
+  for (uint8_t id = 1; id < EFFECT_MAX_COUNT; id++)
+  {
+    if (effectsName(id) != NULL)
+    {
+      html->printf("<option value='%u'%s>%s</option>", id, fullSettings.colorMode == id ? " selected" : "", effectsName(id));
+    }
+  }
+  html->print("</select>");
+  html->print("</div>");
+
+  // Static Color Selection - also the base color of the chase and twinkle effects
+  html->print("<div class='form-group' id='staticColorGroup'>");
+  html->print("<label for='staticColor'>Static Color:</label>");
+  html->printf("<input type='color' id='staticColor' name='staticColor' value='#%02x%02x%02x'>",
+               fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
+  html->print("</div>");
 
   // Cycle Speed (only visible when color cycle is enabled)
-  html += "<div class='form-group' id='cycleSpeedGroup'>";
-  html += "<label for='cycleSpeed'>Cycle Speed:</label>";
-  html += "<input type='range' min='1' max='100' name='cycleSpeed' id='cycleSpeed' value='" + String(fullSettings.cycleSpeed) + "'>";
-  html += "</div>";
-  html += "</div>";
+  html->print("<div class='form-group' id='cycleSpeedGroup'>");
+  html->print("<label for='cycleSpeed'>Cycle Speed:</label>");
+  html->print("<input type='range' min='1' max='100' name='cycleSpeed' id='cycleSpeed' value='" + String(fullSettings.cycleSpeed) + "'>");
+  html->print("</div>");
+  html->print("</div>");
 
   // WiFi Configuration Section
-  html += "<div class='section'>";
-  html += "<h3>WiFi Configuration</h3>";
-  html += "<div class='form-group'><label>SSID:</label><input type='text' name='ssid' value='" + fullSettings.ssid + "'></div>";
-  html += "<div class='form-group'><label>Password:</label><input type='password' name='pass' value='" + fullSettings.password + "'></div>";
-  html += "<div class='form-group'><label>Node Name:</label><input type='text' name='nodeName' value='" + fullSettings.nodeName + "'></div>";
-  html += "</div>";
+  html->print("<div class='section'>");
+  html->print("<h3>WiFi Configuration</h3>");
+  html->print("<div class='form-group'><label>SSID:</label><input type='text' name='ssid' value='");
+  html->print(fullSettings.ssid);
+  html->print("'></div>");
+  html->print("<div class='form-group'><label>Password:</label><input type='password' name='pass' value='");
+  html->print(fullSettings.password);
+  html->print("'></div>");
+  html->print("<div class='form-group'><label>Node Name:</label><input type='text' name='nodeName' value='");
+  html->print(fullSettings.nodeName);
+  html->print("'></div>");
+  html->print("</div>");
 
   // Submit Button
-  html += "<button type='submit'>Save Settings</button>";
-  html += "</form>";
+  html->print("<button type='submit'>Save Settings</button>");
+  html->print("</form>");
 
   // Add JavaScript to show/hide elements based on toggles
-  html += "<script>";
-  html += "function updateVisibility() {";
-  html += "  var useArtnet = document.getElementById('useArtnet').checked;";
-  html += "  var useColorCycle = document.getElementById('useColorCycle').checked;";
-  html += "  var useStaticColor = document.getElementById('useStaticColor').checked;";
+  html->print("<script>");
+  html->print("function updateVisibility() {");
+  html->print("  var useArtnet = document.getElementById('useArtnet').checked;");
+  html->print("  var useSacn = document.getElementById('useSacn').checked;");
+  html->print("  var useNetwork = useArtnet || useSacn;");
+  html->print("  var useColorCycle = document.getElementById('useColorCycle').checked;");
+  html->print("  var useStaticColor = document.getElementById('useStaticColor').checked;");
 
   // Show/hide elements based on selected mode
-  html += "  document.getElementById('colorModeGroup').style.display = (useColorCycle && !useArtnet) ? 'block' : 'none';";
-  html += "  document.getElementById('staticColorGroup').style.display = (useStaticColor && !useArtnet) ? 'block' : 'none';";
-  html += "  document.getElementById('cycleSpeedGroup').style.display = (useColorCycle && !useArtnet) ? 'block' : 'none';";
+  html->print("  document.getElementById('colorModeGroup').style.display = (useColorCycle && !useNetwork) ? 'block' : 'none';");
+  html->print("  document.getElementById('staticColorGroup').style.display = ((useStaticColor || useColorCycle) && !useNetwork) ? 'block' : 'none';");
+  html->print("  document.getElementById('cycleSpeedGroup').style.display = (useColorCycle && !useNetwork) ? 'block' : 'none';");
 
   // Handle mutual exclusivity
-  html += "  if(useArtnet && (useColorCycle || useStaticColor)) {";
-  html += "    if(this.id === 'useArtnet') {";
-  html += "      document.getElementById('useColorCycle').checked = false;";
-  html += "      document.getElementById('useStaticColor').checked = false;";
-  html += "    } else {";
-  html += "      document.getElementById('useArtnet').checked = false;";
-  html += "    }";
-  html += "  }";
+  html->print("  if(useNetwork && (useColorCycle || useStaticColor)) {");
+  html->print("    if(this.id === 'useArtnet' || this.id === 'useSacn') {");
+  html->print("      document.getElementById('useColorCycle').checked = false;");
+  html->print("      document.getElementById('useStaticColor').checked = false;");
+  html->print("    } else {");
+  html->print("      document.getElementById('useArtnet').checked = false;");
+  html->print("      document.getElementById('useSacn').checked = false;");
+  html->print("    }");
+  html->print("  }");
 
   // Make static color and color cycle mutually exclusive
-  html += "  if(useColorCycle && useStaticColor) {";
-  html += "    if(this.id === 'useColorCycle') {";
-  html += "      document.getElementById('useStaticColor').checked = false;";
-  html += "    } else {";
-  html += "      document.getElementById('useColorCycle').checked = false;";
-  html += "    }";
-  html += "  }";
-
-  html += "}";
-  html += "document.getElementById('useArtnet').addEventListener('change', updateVisibility);";
-  html += "document.getElementById('useColorCycle').addEventListener('change', updateVisibility);";
-  html += "document.getElementById('useStaticColor').addEventListener('change', updateVisibility);";
-  html += "updateVisibility(); // Initial call";
-  html += "</script>";
-
-  html += "</body></html>";
-
-  server.send(200, "text/html", html);
+  html->print("  if(useColorCycle && useStaticColor) {");
+  html->print("    if(this.id === 'useColorCycle') {");
+  html->print("      document.getElementById('useStaticColor').checked = false;");
+  html->print("    } else {");
+  html->print("      document.getElementById('useColorCycle').checked = false;");
+  html->print("    }");
+  html->print("  }");
+
+  html->print("}");
+  html->print("document.getElementById('useArtnet').addEventListener('change', updateVisibility);");
+  html->print("document.getElementById('useSacn').addEventListener('change', updateVisibility);");
+  html->print("document.getElementById('useColorCycle').addEventListener('change', updateVisibility);");
+  html->print("document.getElementById('useStaticColor').addEventListener('change', updateVisibility);");
+  html->print("updateVisibility(); // Initial call");
+  html->print("</script>");
+
+  html->print("</body></html>");
+
+  request->send(html);
+}
+
+// POST form fields of a web request
+bool formHas(AsyncWebServerRequest *request, const String &name)
+{
+  return request->hasParam(name, true);
+}
+
+String formArg(AsyncWebServerRequest *request, const String &name)
+{
+  const AsyncWebParameter *param = request->getParam(name, true);
+  return param != NULL ? param->value() : String();
 }
 
-void handleConfig()
+// Form POST from the config page - runs in the AsyncTCP task, so it only parses the
+// form into a ConfigUpdate and leaves applying, saving and restarts to loop()
+void handleConfig(AsyncWebServerRequest *request)
 {
+  ControlRequest control;
+  control.type = CONTROL_APPLY_CONFIG;
+  ConfigUpdate &update = control.config;
+  update.present = 0;
+
   // Process LED configuration
-  if (server.hasArg("leds"))
-    fullSettings.ledsPerStrip = server.arg("leds").toInt();
-  if (server.hasArg("strips"))
-    fullSettings.numStrips = server.arg("strips").toInt();
-  if (server.hasArg("bright"))
-    fullSettings.brightness = server.arg("bright").toInt();
-
-  // Process individual pin configuration
-  for (int i = 0; i < 4; i++)
-  {
-    String pinArg = "pin" + String(i);
-    if (server.hasArg(pinArg))
+  if (formHas(request, "bright"))
+  {
+    update.brightness = constrain((int)formArg(request, "bright").toInt(), 0, 255);
+    update.present |= CONFIG_HAS_BRIGHTNESS;
+  }
+  if (formHas(request, "gamma"))
+  {
+    update.gamma = constrain(formArg(request, "gamma").toFloat(), PIXEL_MIN_GAMMA, PIXEL_MAX_GAMMA);
+    update.present |= CONFIG_HAS_GAMMA;
+  }
+  if (formHas(request, "fps"))
+  {
+    update.maxFps = constrain((int)formArg(request, "fps").toInt(), 0, FRAME_MAX_FPS_LIMIT);
+    update.present |= CONFIG_HAS_FPS;
+  }
+  update.interpolateFrames = formHas(request, "smooth");
+  update.fastBoot = formHas(request, "fastboot");
+
+  // Changing the backend needs a restart - FastLED outputs cannot be removed once
+  // added. The backend and layout only change across a restart, so reading them here is safe
+  bool restart = false;
+  if (formHas(request, "backend"))
+  {
+    update.outputBackend = formArg(request, "backend").toInt() == OUTPUT_BACKEND_I2S ? OUTPUT_BACKEND_I2S : OUTPUT_BACKEND_FASTLED;
+    update.present |= CONFIG_HAS_BACKEND;
+    restart = update.outputBackend != fullSettings.outputBackend;
+  }
+
+  // Process the output layout - rows without a pin are dropped, the rest keep their order
+  if (formHas(request, "pin0"))
+  {
+    LedLayout &layout = update.layout;
+    layout.numOutputs = 0;
+    for (int i = 0; i < MAX_LED_STRIPS; i++)
+    {
+      String index = String(i);
+      int pin = formArg(request, "pin" + index).toInt();
+      int length = formArg(request, "len" + index).toInt();
+      if (!formHas(request, "pin" + index) || pin < 0 || length <= 0)
+      {
+        continue;
+      }
+
+      LedOutputConfig &output = layout.outputs[layout.numOutputs++];
+      output.pin = pin;
+      output.length = length;
+      output.colorOrder = ledColorOrderFromName(formArg(request, "order" + index));
+      output.startOffset = constrain(formArg(request, "start" + index).toInt(), 0, MAX_LEDS - 1);
+    }
+
+    // The buffers and strip drivers are sized at boot, so a new layout needs a restart
+    if (!ledLayoutValidate(&layout))
+    {
+      debugLog("WARNING: LED layout rejected, keeping the current one");
+    }
+    else if (!ledLayoutEquals(&layout, &ledLayout))
+    {
+      update.present |= CONFIG_HAS_LAYOUT;
+      restart = true;
+    }
+  }
+
+  // Mode and WiFi settings - loop() drops the network ones once the network has failed
+  update.useArtnet = formHas(request, "useArtnet");
+  update.useSacn = formHas(request, "useSacn");
+  if (formHas(request, "ssid"))
+  {
+    strlcpy(update.ssid, formArg(request, "ssid").c_str(), sizeof(update.ssid));
+    update.present |= CONFIG_HAS_SSID;
+  }
+  if (formHas(request, "pass"))
+  {
+    strlcpy(update.password, formArg(request, "pass").c_str(), sizeof(update.password));
+    update.present |= CONFIG_HAS_PASSWORD;
+  }
+  if (formHas(request, "nodeName"))
+  {
+    strlcpy(update.nodeName, formArg(request, "nodeName").c_str(), sizeof(update.nodeName));
+    update.present |= CONFIG_HAS_NODE_NAME;
+  }
+
+  // Always allow these non-network settings
+  update.useColorCycle = formHas(request, "useColorCycle");
+  update.useStaticColor = formHas(request, "useStaticColor");
+
+  if (formHas(request, "colorMode"))
+  {
+    update.colorMode = constrain((int)formArg(request, "colorMode").toInt(), 0, EFFECT_MAX_COUNT - 1);
+    update.present |= CONFIG_HAS_COLOR_MODE;
+  }
+
+  if (formHas(request, "cycleSpeed"))
+  {
+    update.cycleSpeed = constrain((int)formArg(request, "cycleSpeed").toInt(), 1, 100);
+    update.present |= CONFIG_HAS_CYCLE_SPEED;
+  }
+
+  // Process static color (convert from hex to RGB)
+  if (formHas(request, "staticColor"))
+  {
+    String colorHex = formArg(request, "staticColor");
+    // Remove '#' if present
+    if (colorHex.startsWith("#"))
     {
-      fullSettings.pins[i] = server.arg(pinArg).toInt();
+      colorHex = colorHex.substring(1);
     }
+
+    // Parse the hex color value
+    long colorValue = strtol(colorHex.c_str(), NULL, 16);
+    update.staticColor[0] = (colorValue >> 16) & 0xFF;
+    update.staticColor[1] = (colorValue >> 8) & 0xFF;
+    update.staticColor[2] = colorValue & 0xFF;
+    update.present |= CONFIG_HAS_STATIC_COLOR;
+  }
+
+  if (restart)
+  {
+    debugLog("LED output configuration changed - restarting");
+    control.type = CONTROL_RESTART;
+  }
+  if (!postControlRequest(control))
+  {
+    request->send(503, "text/plain", "Busy, try again");
+    return;
+  }
+
+  if (restart)
+  {
+    request->send(200, "text/plain", "LED output changed, restarting...");
+    return;
   }
 
+  // Normal operation - just redirect back to root page
+  request->redirect("/");
+}
+
+// Take a config page update into the live settings - loop() only
+void applyConfigUpdate(const ConfigUpdate &update)
+{
+  if (update.present & CONFIG_HAS_BRIGHTNESS)
+    fullSettings.brightness = update.brightness;
+  if (update.present & CONFIG_HAS_GAMMA)
+    fullSettings.gamma = update.gamma;
+  if (update.present & CONFIG_HAS_FPS)
+  {
+    fullSettings.maxFps = update.maxFps;
+    settings.maxFps = fullSettings.maxFps;
+    framePipelineSetMaxFps(fullSettings.maxFps);
+  }
+  fullSettings.interpolateFrames = update.interpolateFrames;
+  settings.interpolateFrames = fullSettings.interpolateFrames;
+  framePipelineSetInterpolation(fullSettings.interpolateFrames);
+  fullSettings.fastBoot = update.fastBoot;
+  settings.fastBoot = fullSettings.fastBoot;
+
+  if (update.present & CONFIG_HAS_BACKEND)
+    fullSettings.outputBackend = update.outputBackend;
+  if (update.present & CONFIG_HAS_LAYOUT)
+    ledLayoutSave(&update.layout);
+
   // CRITICAL FIX: If network has previously failed, ignore attempts to enable network features
   if (!networkInitFailed)
   {
     // Process mode settings
-    fullSettings.useArtnet = server.hasArg("useArtnet");
+    fullSettings.useArtnet = update.useArtnet;
+    fullSettings.sacnEnabled = update.useSacn;
 
-    // Process WiFi settings
-    if (server.hasArg("ssid"))
-      fullSettings.ssid = server.arg("ssid");
-    if (server.hasArg("pass"))
-      fullSettings.password = server.arg("pass");
-    if (server.hasArg("nodeName"))
-      fullSettings.nodeName = server.arg("nodeName");
-
-    // Update the common settings
-    settings.ssid = fullSettings.ssid;
-    settings.password = fullSettings.password;
-    settings.nodeName = fullSettings.nodeName;
-    settings.useWiFi = fullSettings.useArtnet || fullSettings.useWiFi;
-
-    // Check if we need to restart network functionality
+    // Check if we need to restart network functionality - before the new values are taken
     bool wifiConfigChanged = false;
-    if (server.hasArg("ssid") && fullSettings.ssid != server.arg("ssid"))
+    if ((update.present & CONFIG_HAS_SSID) && strcmp(update.ssid, fullSettings.ssid) != 0)
       wifiConfigChanged = true;
-    if (server.hasArg("pass") && fullSettings.password != server.arg("pass"))
+    if ((update.present & CONFIG_HAS_PASSWORD) && strcmp(update.password, fullSettings.password) != 0)
       wifiConfigChanged = true;
 
+    // Process WiFi settings
+    if (update.present & CONFIG_HAS_SSID)
+      strlcpy(fullSettings.ssid, update.ssid, sizeof(fullSettings.ssid));
+    if (update.present & CONFIG_HAS_PASSWORD)
+      strlcpy(fullSettings.password, update.password, sizeof(fullSettings.password));
+    if (update.present & CONFIG_HAS_NODE_NAME)
+      strlcpy(fullSettings.nodeName, update.nodeName, sizeof(fullSettings.nodeName));
+
+    // Update the common settings
+    copyNetworkSettings();
+    settings.useWiFi = networkInputEnabled() || fullSettings.useWiFi;
+
     // If network config changed, we'll need to restart network services
-    if (wifiConfigChanged && (fullSettings.useArtnet || settings.useWiFi))
+    if (wifiConfigChanged && settings.useWiFi)
     {
       debugLog("WiFi configuration changed - preparing to restart network services");
       // Save the flag for network restart
-      preferences.begin("led-settings", false);
-      preferences.putBool("netRestart", true);
-      preferences.end();
+      settingsStoreSetFlag(SETTINGS_FLAG_NET_RESTART, true);
     }
   }
   else
   {
     // Always force these to be disabled if network has failed
     fullSettings.useArtnet = false;
+    fullSettings.sacnEnabled = false;
     settings.useWiFi = false;
     // Log the override
     debugLog("WARNING: Network settings change ignored due to previous failure");
   }
 
-  // Always allow these non-network settings
-  fullSettings.useColorCycle = server.hasArg("useColorCycle");
-  fullSettings.useStaticColor = server.hasArg("useStaticColor");
+  fullSettings.useColorCycle = update.useColorCycle;
+  fullSettings.useStaticColor = update.useStaticColor;
+  if (update.present & CONFIG_HAS_COLOR_MODE)
+    fullSettings.colorMode = update.colorMode;
+  if (update.present & CONFIG_HAS_CYCLE_SPEED)
+    fullSettings.cycleSpeed = update.cycleSpeed;
+  if (update.present & CONFIG_HAS_STATIC_COLOR)
+  {
+    fullSettings.staticColor.r = update.staticColor[0];
+    fullSettings.staticColor.g = update.staticColor[1];
+    fullSettings.staticColor.b = update.staticColor[2];
+  }
 
-  if (server.hasArg("colorMode"))
-    fullSettings.colorMode = server.arg("colorMode").toInt();
+  // Saved once the settings have settled
+  scheduleSettingsSave(SETTINGS_FIELD_ALL);
+}
 
-  if (server.hasArg("cycleSpeed"))
-    fullSettings.cycleSpeed = server.arg("cycleSpeed").toInt();
+// ====== SETTINGS FUNCTIONS ======
+// Copy between the live settings and the stored record
+void packSettings(void *record)
+{
+  PersistedSettings *stored = (PersistedSettings *)record;
+  strlcpy(stored->ssid, fullSettings.ssid, sizeof(stored->ssid));
+  strlcpy(stored->password, fullSettings.password, sizeof(stored->password));
+  strlcpy(stored->nodeName, fullSettings.nodeName, sizeof(stored->nodeName));
+  stored->useWiFi = settings.useWiFi;
+  stored->startUniverse = fullSettings.startUniverse;
+
+  stored->numStrips = fullSettings.numStrips;
+  stored->ledsPerStrip = fullSettings.ledsPerStrip;
+  for (int i = 0; i < MAX_STRIPS; i++)
+  {
+    stored->pins[i] = fullSettings.pins[i];
+  }
+  stored->brightness = fullSettings.brightness;
+  stored->gamma = fullSettings.gamma;
+  stored->maxFps = fullSettings.maxFps;
+  stored->interpolateFrames = fullSettings.interpolateFrames;
+  stored->fastBoot = fullSettings.fastBoot;
+  stored->outputBackend = fullSettings.outputBackend;
+
+  stored->useArtnet = fullSettings.useArtnet;
+  stored->useColorCycle = fullSettings.useColorCycle;
+  stored->useStaticColor = fullSettings.useStaticColor;
+  stored->colorMode = fullSettings.colorMode;
+  stored->cycleSpeed = fullSettings.cycleSpeed;
+  stored->staticColor[0] = fullSettings.staticColor.r;
+  stored->staticColor[1] = fullSettings.staticColor.g;
+  stored->staticColor[2] = fullSettings.staticColor.b;
+
+  stored->useSacn = fullSettings.sacnEnabled;
+}
 
-  // Process static color (convert from hex to RGB)
-  if (server.hasArg("staticColor"))
+void unpackSettings(const PersistedSettings *stored)
+{
+  strlcpy(fullSettings.ssid, stored->ssid, sizeof(fullSettings.ssid));
+  strlcpy(fullSettings.password, stored->password, sizeof(fullSettings.password));
+  strlcpy(fullSettings.nodeName, stored->nodeName, sizeof(fullSettings.nodeName));
+  settings.useWiFi = stored->useWiFi;
+  fullSettings.startUniverse = stored->startUniverse;
+
+  fullSettings.numStrips = stored->numStrips;
+  fullSettings.ledsPerStrip = stored->ledsPerStrip;
+  for (int i = 0; i < MAX_STRIPS; i++)
   {
-    String colorHex = server.arg("staticColor");
-    // Remove '#' if present
-    if (colorHex.startsWith("#"))
-    {
-      colorHex = colorHex.substring(1);
-    }
+    fullSettings.pins[i] = stored->pins[i];
+  }
+  fullSettings.brightness = stored->brightness;
+  fullSettings.gamma = constrain(stored->gamma, PIXEL_MIN_GAMMA, PIXEL_MAX_GAMMA);
+  fullSettings.maxFps = stored->maxFps;
+  fullSettings.interpolateFrames = stored->interpolateFrames;
+  fullSettings.fastBoot = stored->fastBoot;
+  fullSettings.outputBackend = stored->outputBackend;
+
+  fullSettings.useArtnet = stored->useArtnet;
+  fullSettings.useColorCycle = stored->useColorCycle;
+  fullSettings.useStaticColor = stored->useStaticColor;
+  fullSettings.colorMode = stored->colorMode;
+  fullSettings.cycleSpeed = stored->cycleSpeed;
+  fullSettings.staticColor.r = stored->staticColor[0];
+  fullSettings.staticColor.g = stored->staticColor[1];
+  fullSettings.staticColor.b = stored->staticColor[2];
+
+  fullSettings.sacnEnabled = stored->useSacn;
+}
 
-    // Parse the hex color value
-    long colorValue = strtol(colorHex.c_str(), NULL, 16);
-    fullSettings.staticColor.r = (colorValue >> 16) & 0xFF;
-    fullSettings.staticColor.g = (colorValue >> 8) & 0xFF;
-    fullSettings.staticColor.b = colorValue & 0xFF;
+// The credentials live in both structures - fixed buffers, copied in place
+void copyNetworkSettings()
+{
+  strlcpy(settings.ssid, fullSettings.ssid, sizeof(settings.ssid));
+  strlcpy(settings.password, fullSettings.password, sizeof(settings.password));
+  strlcpy(settings.nodeName, fullSettings.nodeName, sizeof(settings.nodeName));
+}
+
+void loadSettings()
+{
+  // The record starts out as the defaults, so fields an older blob lacks keep them
+  packSettings(&persistedSettings);
+  if (settingsStoreBegin(&persistedSettings, sizeof(persistedSettings), PERSISTED_SETTINGS_VERSION, packSettings))
+  {
+    unpackSettings(&persistedSettings);
+    debugLog("Settings loaded (" + String(sizeof(persistedSettings)) + " byte record)");
+  }
+  else
+  {
+    // First boot with the blob - carry the old keys over once
+    loadLegacySettings();
+    settingsStoreMarkDirty(SETTINGS_FIELD_ALL);
+    settingsStoreCommit();
   }
 
-  // Save settings to preferences
-  saveSettings();
+  // Update common settings
+  copyNetworkSettings();
+  settings.fastBoot = fullSettings.fastBoot;
 
-  // Apply the current mode settings
-  applyModeSettings();
+  // Set common WiFi flag based on the ArtNet and sACN settings
+  settings.useWiFi = networkInputEnabled() || settings.useWiFi;
 
-  // Normal operation - just redirect back to root page
-  server.sendHeader("Location", "/", true);
-  server.send(302, "text/plain", "Settings Updated");
+  // Network failure state - CRITICAL FIX for persistent boot-loop prevention
+  networkInitFailed = settingsStoreFlag(SETTINGS_FLAG_NET_FAILED);
+  if (networkInitFailed)
+  {
+    debugLog("CRITICAL: Network previously failed and disabled permanently");
+  }
 }
 
-// ====== SETTINGS FUNCTIONS ======
-void loadSettings()
+// Settings of firmware before the SettingsStore blob, one preferences key each
+void loadLegacySettings()
 {
-  preferences.begin("led-settings", false);
+  preferences.begin("led-settings", true);
 
-  // Load LED configuration
+  // Load LED configuration (strip counts and pins only seed the default layout)
   fullSettings.numStrips = preferences.getInt("numStrips", fullSettings.numStrips);
   fullSettings.ledsPerStrip = preferences.getInt("ledsPerStrip", fullSettings.ledsPerStrip);
   fullSettings.brightness = preferences.getInt("brightness", fullSettings.brightness);
+  fullSettings.gamma = preferences.getFloat("gamma", fullSettings.gamma);
+  fullSettings.maxFps = preferences.getUChar("maxFps", fullSettings.maxFps);
+  fullSettings.interpolateFrames = preferences.getBool("interpolate", fullSettings.interpolateFrames);
+  fullSettings.fastBoot = preferences.getBool("fastBoot", fullSettings.fastBoot);
+  fullSettings.outputBackend = preferences.getInt("outputBackend", fullSettings.outputBackend);
 
   // Load pins array
   String pinsStr = preferences.getString("pins", "");
@@ -425,7 +870,7 @@ void loadSettings()
   {
     int index = 0;
     int commaPos = 0;
-    while (commaPos >= 0 && index < 4)
+    while (commaPos >= 0 && index < MAX_STRIPS)
     {
       commaPos = pinsStr.indexOf(',');
       if (commaPos > 0)
@@ -442,16 +887,11 @@ void loadSettings()
   }
 
   // Load WiFi configuration from preferences to both settings structures
-  fullSettings.ssid = preferences.getString("ssid", fullSettings.ssid);
-  fullSettings.password = preferences.getString("password", fullSettings.password);
-  fullSettings.nodeName = preferences.getString("nodeName", fullSettings.nodeName);
+  preferences.getString("ssid", fullSettings.ssid, sizeof(fullSettings.ssid));
+  preferences.getString("password", fullSettings.password, sizeof(fullSettings.password));
+  preferences.getString("nodeName", fullSettings.nodeName, sizeof(fullSettings.nodeName));
   fullSettings.startUniverse = preferences.getInt("startUniverse", fullSettings.startUniverse);
 
-  // Update common settings
-  settings.ssid = fullSettings.ssid;
-  settings.password = fullSettings.password;
-  settings.nodeName = fullSettings.nodeName;
-
   // Load mode settings
   fullSettings.useArtnet = preferences.getBool("useArtnet", fullSettings.useArtnet);
   fullSettings.useColorCycle = preferences.getBool("useColorCycle", fullSettings.useColorCycle);
@@ -464,155 +904,620 @@ void loadSettings()
   fullSettings.staticColor.g = preferences.getInt("staticColorG", fullSettings.staticColor.g);
   fullSettings.staticColor.b = preferences.getInt("staticColorB", fullSettings.staticColor.b);
 
-  // Load network failure state - CRITICAL FIX for persistent boot-loop prevention
-  networkInitFailed = preferences.getBool("netFailed", false);
-  if (networkInitFailed)
-  {
-    debugLog("CRITICAL: Network previously failed and disabled permanently");
-  }
+  // Network failure state - CRITICAL FIX for persistent boot-loop prevention
+  settingsStoreSetFlag(SETTINGS_FLAG_NET_FAILED, preferences.getBool("netFailed", false));
 
   // Set common WiFi flag based on ArtNet setting
   settings.useWiFi = fullSettings.useArtnet || preferences.getBool("useWiFi", settings.useWiFi);
 
   preferences.end();
 
-  debugLog("Settings loaded from preferences");
+  debugLog("Settings migrated from the per-key preferences");
 }
 
+
+// Commit all settings now - for restarts, which cannot wait for the quiet period
 void saveSettings()
 {
-  preferences.begin("led-settings", false);
-
-  // Save LED configuration
-  preferences.putInt("numStrips", fullSettings.numStrips);
-  preferences.putInt("ledsPerStrip", fullSettings.ledsPerStrip);
-  preferences.putInt("brightness", fullSettings.brightness);
-
-  // Save pins array as comma-separated string
-  String pinsStr = String(fullSettings.pins[0]);
-  for (int i = 1; i < 4; i++)
+  settingsStoreMarkDirty(SETTINGS_FIELD_ALL);
+  if (settingsStoreCommit())
   {
-    pinsStr += "," + String(fullSettings.pins[i]);
+    debugLog("Settings saved");
   }
-  preferences.putString("pins", pinsStr);
-
-  // Save WiFi configuration
-  preferences.putString("ssid", fullSettings.ssid);
-  preferences.putString("password", fullSettings.password);
-  preferences.putString("nodeName", fullSettings.nodeName);
-  preferences.putInt("startUniverse", fullSettings.startUniverse);
-  preferences.putBool("useWiFi", settings.useWiFi);
+}
 
-  // Save mode settings
-  preferences.putBool("useArtnet", fullSettings.useArtnet);
-  preferences.putBool("useColorCycle", fullSettings.useColorCycle);
-  preferences.putBool("useStaticColor", fullSettings.useStaticColor);
-  preferences.putInt("colorMode", fullSettings.colorMode);
-  preferences.putInt("cycleSpeed", fullSettings.cycleSpeed);
+// Mode numbers reported in the I2C register map
+#define I2C_MODE_OFF 0
+#define I2C_MODE_ARTNET 1
+#define I2C_MODE_STATIC 2
+#define I2C_MODE_COLOR_CYCLE 3
 
-  // Save static color
-  preferences.putInt("staticColorR", fullSettings.staticColor.r);
-  preferences.putInt("staticColorG", fullSettings.staticColor.g);
-  preferences.putInt("staticColorB", fullSettings.staticColor.b);
+void updateI2CStatus()
+{
+  uint8_t flags = 0;
+  if (WiFi.status() == WL_CONNECTED)
+    flags |= I2C_FLAG_WIFI;
+  if (state.artnetRunning)
+    flags |= I2C_FLAG_ARTNET;
+  if (serialStreamActive)
+    flags |= I2C_FLAG_SERIAL_STREAM;
+  if (benchmarkRunning())
+    flags |= I2C_FLAG_BENCHMARK;
+
+  uint8_t lastError = uartBridge.getLastError();
+  if (lastError != ERR_NONE)
+    flags |= I2C_FLAG_ERROR;
+
+  uint8_t mode = I2C_MODE_OFF;
+  if (networkInputEnabled())
+    mode = I2C_MODE_ARTNET;
+  else if (fullSettings.useStaticColor)
+    mode = I2C_MODE_STATIC;
+  else if (fullSettings.useColorCycle)
+    mode = I2C_MODE_COLOR_CYCLE;
+
+  i2cSlaveSetStatus(flags, mode, fullSettings.brightness, lastError);
+  liveViewSetStatus(mode, fullSettings.brightness);
+}
 
-  // CRITICAL FIX: Always save the current network failure state to maintain across reboots
-  preferences.putBool("netFailed", networkInitFailed);
+// Defer a save until no further change has arrived for SETTINGS_STORE_QUIET_MS
+void scheduleSettingsSave(uint32_t fields)
+{
+  settingsStoreMarkDirty(fields);
+}
 
-  preferences.end();
+void saveSettingsIfDue()
+{
+  if (settingsStoreCommitDue())
+  {
+    settingsStoreCommit();
+  }
+}
 
-  debugLog("Settings saved to preferences");
+// ====== LED OUTPUT ======
+// FastLED pins are template arguments, so each supported pin needs its own case.
+// Strips are registered as RGB - the wire buffer is already in each strip's color order.
+bool addFastLEDStrip(int pin, CRGB *start, int count)
+{
+  switch (pin)
+  {
+  case 2:
+    FastLED.addLeds<WS2812B, 2, RGB>(start, count);
+    break;
+  case 4:
+    FastLED.addLeds<WS2812B, 4, RGB>(start, count);
+    break;
+  case 5:
+    FastLED.addLeds<WS2812B, 5, RGB>(start, count);
+    break;
+  case 12:
+    FastLED.addLeds<WS2812B, 12, RGB>(start, count);
+    break;
+  case 13:
+    FastLED.addLeds<WS2812B, 13, RGB>(start, count);
+    break;
+  case 14:
+    FastLED.addLeds<WS2812B, 14, RGB>(start, count);
+    break;
+  case 15:
+    FastLED.addLeds<WS2812B, 15, RGB>(start, count);
+    break;
+  case 16:
+    FastLED.addLeds<WS2812B, 16, RGB>(start, count);
+    break;
+  case 18:
+    FastLED.addLeds<WS2812B, 18, RGB>(start, count);
+    break;
+  case 19:
+    FastLED.addLeds<WS2812B, 19, RGB>(start, count);
+    break;
+  case 21:
+    FastLED.addLeds<WS2812B, 21, RGB>(start, count);
+    break;
+  case 22:
+    FastLED.addLeds<WS2812B, 22, RGB>(start, count);
+    break;
+  case 23:
+    FastLED.addLeds<WS2812B, 23, RGB>(start, count);
+    break;
+  case 25:
+    FastLED.addLeds<WS2812B, 25, RGB>(start, count);
+    break;
+  case 26:
+    FastLED.addLeds<WS2812B, 26, RGB>(start, count);
+    break;
+  case 27:
+    FastLED.addLeds<WS2812B, 27, RGB>(start, count);
+    break;
+  case 32:
+    FastLED.addLeds<WS2812B, 32, RGB>(start, count);
+    break;
+  case 33:
+    FastLED.addLeds<WS2812B, 33, RGB>(start, count);
+    break;
+  default:
+    return false;
+  }
+  return true;
 }
 
-// UART command handler callback
-void handleUARTCommand(uint8_t cmd, uint8_t *data, uint16_t length)
+// Load the output layout and register its strips with the selected backend.
+// leds[] is sized to the furthest pixel any output reads.
+bool initLEDOutput()
 {
-  // Process commands based on the command type
-  switch (cmd)
+  if (!ledLayoutLoad(&ledLayout))
   {
-  case 0x01: // Status request
-    // Respond with system status info
-    {
-      uint8_t statusPacket[8];
-      statusPacket[0] = WiFi.status() == WL_CONNECTED ? 1 : 0; // WiFi connected status
-      statusPacket[1] = state.artnetRunning ? 1 : 0;           // ArtNet running status
-      statusPacket[2] = fullSettings.brightness;               // Current brightness
-      statusPacket[3] = settings.artnetUniverse;               // Current universe
+    int numStrips = constrain(fullSettings.numStrips, 1, MAX_STRIPS);
+    int ledsPerStrip = constrain(fullSettings.ledsPerStrip, 1, min(MAX_LEDS_PER_STRIP, MAX_LEDS / numStrips));
+    ledLayoutSetUniform(&ledLayout, fullSettings.pins, numStrips, ledsPerStrip);
+  }
 
-      // Send system uptime (in seconds) in the last 4 bytes
-      uint32_t uptime = millis() / 1000;
-      statusPacket[4] = (uptime >> 24) & 0xFF;
-      statusPacket[5] = (uptime >> 16) & 0xFF;
-      statusPacket[6] = (uptime >> 8) & 0xFF;
-      statusPacket[7] = uptime & 0xFF;
+  if (!ledLayoutValidate(&ledLayout))
+  {
+    debugLog("ERROR: LED layout not configured correctly! Pin value: " + String(fullSettings.pins[0]));
+    return false;
+  }
 
-      uartBridge.sendCommand(0x81, statusPacket, 8);
-    }
-    break;
+  uint16_t pixelCount = ledLayoutPixelCount(&ledLayout);
+  activeOutputBackend = fullSettings.outputBackend;
 
-  case 0x02: // Set brightness
-    if (length >= 1)
-    {
-      fullSettings.brightness = data[0];
-      settings.brightness = data[0];
-      FastLED.setBrightness(data[0]);
-      debugLog("UART: Set brightness to " + String(data[0]));
+  // Parallel output needs equal-length strips, shorter ones are padded
+  wireStride = activeOutputBackend == OUTPUT_BACKEND_I2S ? ledLayoutMaxLength(&ledLayout) : 0;
+  uint32_t wirePixels = wireStride ? (uint32_t)wireStride * ledLayout.numOutputs : ledLayoutWireCount(&ledLayout);
 
-      // Acknowledge command
-      uint8_t response = data[0];
-      uartBridge.sendCommand(0x82, &response, 1);
+  wireBuffer = (uint8_t *)calloc(wirePixels, 3);
+  if (wireBuffer == NULL || !allocateLEDs(pixelCount))
+  {
+    debugLog("ERROR: LED buffer allocation failed for " + String(pixelCount) + " LEDs");
+    free(wireBuffer);
+    wireBuffer = NULL;
+    return false;
+  }
+  settings.ledCount = pixelCount;
 
-      // Save to preferences
-      saveSettings();
+  if (activeOutputBackend == OUTPUT_BACKEND_I2S)
+  {
+    int stripPins[MAX_LED_STRIPS];
+    for (int i = 0; i < ledLayout.numOutputs; i++)
+    {
+      stripPins[i] = ledLayout.outputs[i].pin;
     }
-    break;
 
-  case 0x03: // Set static color
-    if (length >= 3)
+    // The driver transposes the wire buffer into DMA buffers and clocks every strip out at once
+    driver.initled(wireBuffer, stripPins, ledLayout.numOutputs, wireStride, ORDER_RGB);
+    driver.setBrightness(255);
+  }
+  else
+  {
+    CRGB *wirePixel = (CRGB *)wireBuffer;
+    for (int i = 0; i < ledLayout.numOutputs; i++)
     {
-      fullSettings.staticColor.r = data[0];
-      fullSettings.staticColor.g = data[1];
-      fullSettings.staticColor.b = data[2];
-      fullSettings.useStaticColor = true;
-      fullSettings.useColorCycle = false;
-      fullSettings.useArtnet = false;
-
-      debugLog("UART: Set static color to RGB(" +
-               String(data[0]) + "," +
-               String(data[1]) + "," +
-               String(data[2]) + ")");
+      const LedOutputConfig &output = ledLayout.outputs[i];
+      if (!addFastLEDStrip(output.pin, wirePixel, output.length))
+      {
+        debugLog("WARNING: Pin " + String(output.pin) + " is not supported by FastLED, output " + String(i + 1) + " disabled");
+      }
+      wirePixel += output.length;
+    }
+    FastLED.setBrightness(255);
+  }
 
-      // Acknowledge command
-      uartBridge.sendCommand(0x83, data, 3);
+  // Brightness and gamma are applied by the pixel kernel while packing the wire buffer
+  setLEDBrightness(fullSettings.brightness);
+
+  for (int i = 0; i < ledLayout.numOutputs; i++)
+  {
+    const LedOutputConfig &output = ledLayout.outputs[i];
+    debugLog("Output " + String(i + 1) + ": pin " + String(output.pin) + ", " + String(output.length) + " LEDs " +
+             ledColorOrderName(output.colorOrder) + " from pixel " + String(output.startOffset));
+  }
+  debugLog("LED output: " + String(activeOutputBackend == OUTPUT_BACKEND_I2S ? "I2S" : "FastLED") + ", " +
+           String(ledLayout.numOutputs) + " strips, " + String(pixelCount) + " pixels");
+  return true;
+}
+
+// Block until the I2S driver has finished reading the wire buffer for the previous frame
+void waitLEDOutput()
+{
+  while (activeOutputBackend == OUTPUT_BACKEND_I2S && driver.isDisplaying)
+  {
+    vTaskDelay(1);
+  }
+}
+
+// Push leds[] to the strips and wait for the transfer to complete
+void showLEDs()
+{
+  if (wireBuffer == NULL)
+  {
+    return;
+  }
+
+  waitLEDOutput();
+  uint32_t convertStart = perfTimestamp();
+  ledLayoutPack(&ledLayout, (const uint8_t *)leds, settings.ledCount, wireBuffer, wireStride);
+  perfRecord(PERF_STAGE_CONVERT, convertStart);
+
+  uint32_t showStart = perfTimestamp();
+  if (activeOutputBackend == OUTPUT_BACKEND_I2S)
+  {
+    driver.showPixels(WAIT);
+  }
+  else
+  {
+    FastLED.show();
+  }
+  perfRecord(PERF_STAGE_SHOW, showStart);
+
+  i2cSlaveFrameShown((const uint8_t *)leds, settings.ledCount * 3);
+  liveViewFrameShown((const uint8_t *)leds, settings.ledCount * 3);
+  fastBootFrameShown((const uint8_t *)leds, settings.ledCount * 3);
+  shownLedsHashValid = false;
+  lastLedsShow = millis();
+}
+
+// showLEDs() unless leds[] and the output correction are what the strips already
+// show - an unchanged picture is re-sent only every FRAME_REFRESH_INTERVAL_MS
+bool showLEDsIfChanged(unsigned long now)
+{
+  uint32_t hash = pixelHash((const uint8_t *)leds, settings.ledCount * 3);
+  uint32_t correctionId = pixelKernelCorrectionId();
+  if (shownLedsHashValid && hash == shownLedsHash && correctionId == shownCorrectionId &&
+      now - lastLedsShow < FRAME_REFRESH_INTERVAL_MS)
+  {
+    return false;
+  }
 
-      // Save to preferences
+  showLEDs();
+  shownLedsHash = hash;
+  shownCorrectionId = correctionId;
+  shownLedsHashValid = true;
+  return true;
+}
+
+// Takes effect with the next packed frame - the LUT is only rebuilt when something changed
+void setLEDBrightness(int brightness)
+{
+  pixelKernelSetCorrection(brightness, fullSettings.gamma);
+}
+
+// Fixed-cadence timer for the local modes: true once per period, with the
+// deadline advanced by whole periods so the refresh rate does not drift
+bool localFrameDue(unsigned long &deadline, unsigned long periodMs, unsigned long now)
+{
+  if ((long)(now - deadline) < 0)
+  {
+    return false;
+  }
+
+  deadline += periodMs;
+  if ((long)(now - deadline) >= 0)
+  {
+    // Fell behind by more than a frame (or just started) - restart the cadence
+    deadline = now + periodMs;
+  }
+  return true;
+}
+
+// Output stage of the frame pipeline - called from the render task
+void renderArtNetFrame(const uint8_t *frame, uint16_t numChannels)
+{
+  if (wireBuffer == NULL)
+  {
+    return;
+  }
+
+  // The wire buffer is still being clocked out by DMA until the previous frame is done
+  waitLEDOutput();
+  uint32_t convertStart = perfTimestamp();
+  ledLayoutPack(&ledLayout, frame, numChannels / 3, wireBuffer, wireStride);
+  perfRecord(PERF_STAGE_CONVERT, convertStart);
+
+  // With I2S this only measures the hand-off, transmission itself runs on DMA
+  uint32_t showStart = perfTimestamp();
+  if (activeOutputBackend == OUTPUT_BACKEND_I2S)
+  {
+    // Return straight away - the CPU is free while DMA clocks out all strips in parallel
+    driver.showPixels(NO_WAIT);
+  }
+  else
+  {
+    FastLED.show();
+  }
+  perfRecord(PERF_STAGE_SHOW, showStart);
+
+  i2cSlaveFrameShown(frame, numChannels);
+  liveViewFrameShown(frame, numChannels);
+  fastBootFrameShown(frame, numChannels);
+  shownLedsHashValid = false;
+}
+
+// GET /benchmark returns the last result; ?run=1 starts a new run with
+// optional fps, universes, pixels, seconds and sync arguments
+void handleFullBenchmark(AsyncWebServerRequest *request)
+{
+  if (request->hasParam("run") && !benchmarkRunning())
+  {
+    BenchmarkConfig config;
+    config.universes = settings.artnetUniverseCount;
+    config.pixels = settings.ledCount;
+    if (request->hasParam("fps"))
+      config.fps = request->getParam("fps")->value().toInt();
+    if (request->hasParam("universes"))
+      config.universes = request->getParam("universes")->value().toInt();
+    if (request->hasParam("pixels"))
+      config.pixels = request->getParam("pixels")->value().toInt();
+    if (request->hasParam("seconds"))
+      config.seconds = request->getParam("seconds")->value().toInt();
+    config.sync = request->hasParam("sync");
+
+    // Started from loop(), the run takes over the LEDs there
+    if (!postControlRequest(CONTROL_START_BENCHMARK, &config))
+    {
+      request->send(503, "application/json", "{\"started\":false}");
+      return;
+    }
+    request->send(202, "application/json", "{\"started\":true}");
+    return;
+  }
+
+  request->send(200, "application/json", benchmarkResultJson());
+}
+
+// Routes of the full build - registered ahead of the WebServerManager defaults,
+// which still provide /settings, /logs, /stats and the live view socket
+void registerWebRoutes(AsyncWebServer &web)
+{
+  web.on("/", HTTP_GET, handleRoot);
+  web.on("/config", HTTP_POST, handleConfig);
+  web.on("/debug", HTTP_GET, handleLog);
+  web.on("/benchmark", HTTP_GET, handleFullBenchmark);
+}
+
+// Live view controls (WebServerManager), applied from loop() like the UART commands
+void handleLiveControl(uint8_t command, const uint8_t *data, size_t length)
+{
+  switch (command)
+  {
+  case LIVE_VIEW_CMD_BRIGHTNESS:
+    fullSettings.brightness = data[0];
+    settings.brightness = data[0];
+    setLEDBrightness(data[0]);
+    break;
+
+  case LIVE_VIEW_CMD_COLOR:
+    fullSettings.staticColor.r = data[0];
+    fullSettings.staticColor.g = data[1];
+    fullSettings.staticColor.b = data[2];
+    if (!fullSettings.useStaticColor)
+    {
+      fullSettings.useStaticColor = true;
+      fullSettings.useColorCycle = false;
+      fullSettings.useArtnet = false;
+      fullSettings.sacnEnabled = false;
+      applyModeSettings();
+    }
+    break;
+
+  case LIVE_VIEW_CMD_MODE:
+    // ArtNet stays off once the network has been disabled
+    if (data[0] == LIVE_VIEW_MODE_ARTNET && networkInitFailed)
+    {
+      return;
+    }
+    // Network mode keeps the sACN choice, any local mode ends both inputs
+    fullSettings.useArtnet = data[0] == LIVE_VIEW_MODE_ARTNET;
+    fullSettings.sacnEnabled = fullSettings.useArtnet && fullSettings.sacnEnabled;
+    fullSettings.useStaticColor = data[0] == LIVE_VIEW_MODE_STATIC;
+    fullSettings.useColorCycle = data[0] == LIVE_VIEW_MODE_EFFECT;
+    applyModeSettings();
+    break;
+
+  default:
+    return;
+  }
+
+  scheduleSettingsSave(command == LIVE_VIEW_CMD_BRIGHTNESS ? SETTINGS_FIELD_OUTPUT : SETTINGS_FIELD_MODE);
+}
+
+// Queue a request for loop() - never blocks, false when the queue is full
+bool postControlRequest(ControlRequestType type, const BenchmarkConfig *benchmark)
+{
+  ControlRequest request;
+  request.type = type;
+  request.config.present = 0;
+  if (benchmark != NULL)
+  {
+    request.benchmark = *benchmark;
+  }
+  return postControlRequest(request);
+}
+
+bool postControlRequest(const ControlRequest &request)
+{
+  return controlQueue != NULL && xQueueSend(controlQueue, &request, 0) == pdTRUE;
+}
+
+// Act on what the web handlers queued for loop()
+void applyControlRequests()
+{
+  ControlRequest request;
+  while (controlQueue != NULL && xQueueReceive(controlQueue, &request, 0) == pdTRUE)
+  {
+    switch (request.type)
+    {
+    case CONTROL_RESTART:
+      applyConfigUpdate(request.config);
+      // Give the response a moment to leave before restarting
+      delay(500);
       saveSettings();
+      logRingFlush();
+      ESP.restart();
+      break;
+
+    case CONTROL_APPLY_CONFIG:
+      applyConfigUpdate(request.config);
+      setLEDBrightness(fullSettings.brightness);
+      applyModeSettings();
+      break;
+
+    case CONTROL_START_BENCHMARK:
+      startBenchmarkMode(request.benchmark);
+      break;
+    }
+  }
+}
+
+// UART command handler callback
+void handleUARTCommand(uint8_t cmd, uint8_t *data, uint16_t length)
+{
+  // Process commands based on the command type
+  switch (cmd)
+  {
+  case 0x01: // Status request
+    // Respond with system status info
+    {
+      uint8_t statusPacket[8];
+      statusPacket[0] = WiFi.status() == WL_CONNECTED ? 1 : 0; // WiFi connected status
+      statusPacket[1] = state.artnetRunning ? 1 : 0;           // ArtNet running status
+      statusPacket[2] = fullSettings.brightness;               // Current brightness
+      statusPacket[3] = settings.artnetUniverse;               // Current universe
+
+      // Send system uptime (in seconds) in the last 4 bytes
+      uint32_t uptime = millis() / 1000;
+      statusPacket[4] = (uptime >> 24) & 0xFF;
+      statusPacket[5] = (uptime >> 16) & 0xFF;
+      statusPacket[6] = (uptime >> 8) & 0xFF;
+      statusPacket[7] = uptime & 0xFF;
+
+      uartBridge.postCommand(0x81, statusPacket, 8);
+    }
+    break;
+
+  case 0x02: // Set brightness
+    if (length >= 1)
+    {
+      fullSettings.brightness = data[0];
+      settings.brightness = data[0];
+      setLEDBrightness(data[0]);
+      logRingWrite(LOG_LEVEL_INFO, "UART: Set brightness to %u", data[0]);
+
+      // Acknowledge command - a burst of changes gets one ack with the final value
+      uint8_t response = data[0];
+      uartBridge.postCommand(0x82, &response, 1);
+
+      // Save to preferences once the changes settle
+      scheduleSettingsSave(SETTINGS_FIELD_OUTPUT);
+    }
+    break;
+
+  case 0x03: // Set static color
+    if (length >= 3)
+    {
+      fullSettings.staticColor.r = data[0];
+      fullSettings.staticColor.g = data[1];
+      fullSettings.staticColor.b = data[2];
+
+      // Leaving another mode stops its render task before loop() draws the color
+      if (!fullSettings.useStaticColor || fullSettings.useColorCycle || networkInputEnabled())
+      {
+        fullSettings.useStaticColor = true;
+        fullSettings.useColorCycle = false;
+        fullSettings.useArtnet = false;
+        fullSettings.sacnEnabled = false;
+        applyModeSettings();
+      }
+
+      logRingWrite(LOG_LEVEL_INFO, "UART: Set static color to RGB(%u,%u,%u)", data[0], data[1], data[2]);
+
+      // Acknowledge command
+      uartBridge.postCommand(0x83, data, 3);
+
+      // Save to preferences once the changes settle
+      scheduleSettingsSave(SETTINGS_FIELD_MODE);
+    }
+    break;
+
+  case 0x04: // Run benchmark: fps (2 bytes), universes, seconds
+    if (length >= 4)
+    {
+      BenchmarkConfig config;
+      config.fps = (data[0] << 8) | data[1];
+      config.universes = data[2];
+      config.pixels = settings.ledCount;
+      config.seconds = data[3];
+      startBenchmarkMode(config);
+      // The result is sent as 0x84 when the run completes
     }
     break;
 
   case 0xFF: // Reset device
     debugLog("UART: Reset command received");
+    if (settingsStoreDirtyFields() != 0)
+    {
+      settingsStoreCommit();
+    }
+    logRingFlush();
     ESP.restart();
     break;
 
   default:
     // Unknown command
-    debugLog("UART: Unknown command: 0x" + String(cmd, HEX));
+    logRingWrite(LOG_LEVEL_WARNING, "UART: Unknown command: 0x%02x", cmd);
     break;
   }
 }
 
+// CMD_DMX_DATA: pixels go straight into the frame pipeline from the RX task.
+// If nothing owns the pipeline yet, loop() starts a serial stream on the next pass.
+void handleUARTDmxData(uint16_t pixelOffset, const uint8_t *data, uint16_t numChannels, bool present)
+{
+  lastSerialDmx = millis();
+
+  if (!framePipelineRunning())
+  {
+    serialStreamRequested = true;
+    return;
+  }
+
+  framePipelineWrite(pixelOffset, data, numChannels);
+  if (present)
+  {
+    framePipelinePresent();
+  }
+}
+
+// Serial streaming - render UART pixel data through the same path as ArtNet
+bool startSerialStream() {
+  stopAllModes();
+
+  framePipelineSetMaxFps(fullSettings.maxFps);
+  framePipelineSetInterpolation(fullSettings.interpolateFrames);
+  if (!framePipelineBegin(settings.ledCount, renderArtNetFrame)) {
+    debugLog("ERROR: Serial stream could not start the frame pipeline");
+    return false;
+  }
+
+  serialStreamActive = true;
+  debugLog("Serial pixel stream started");
+  return true;
+}
+
+void stopSerialStream() {
+  serialStreamActive = false;
+  debugLog("Serial pixel stream ended");
+  applyModeSettings();
+}
+
 // Mode management functions
 void stopAllModes() {
-  // Clear the LEDs first
-  fill_solid(leds, fullSettings.ledsPerStrip, CRGB::Black);
-  FastLED.show();
-  
-  // Stop ArtNet if it's running
-  if (state.artnetRunning) {
-    artnet.end();
-    state.artnetRunning = false;
-    debugLog("ArtNet mode stopped");
-  }
+  // Stop the ArtNet listener or serial stream and hand the LEDs back to the main loop
+  stopArtNet();
+  serialStreamActive = false;
+
+  // Clear the LEDs once the render task is gone
+  fill_solid(leds, settings.ledCount, CRGB::Black);
+  showLEDs();
   
   // Reset state variables for other modes
   // This ensures any animation variables are reset
@@ -624,15 +1529,15 @@ void startArtNetMode() {
   stopAllModes();
   
   // Initialize ArtNet if WiFi is connected
-  if (WiFi.status() == WL_CONNECTED) {
-    setupArtNet();
+  if (WiFi.status() == WL_CONNECTED && startArtNetReceiver()) {
     debugLog("ArtNet mode started");
   } else {
     debugLog("ERROR: Cannot start ArtNet mode - WiFi not connected");
     // Fall back to static color mode
     fullSettings.useArtnet = false;
+    fullSettings.sacnEnabled = false;
     fullSettings.useStaticColor = true;
-    saveSettings();
+    scheduleSettingsSave(SETTINGS_FIELD_MODE);
     startStaticColorMode();
   }
 }
@@ -643,8 +1548,8 @@ void startStaticColorMode() {
   
   // Set the static color
   CRGB staticColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
-  fill_solid(leds, fullSettings.ledsPerStrip, staticColor);
-  FastLED.show();
+  fill_solid(leds, settings.ledCount, staticColor);
+  showLEDs();
   
   debugLog("Static color mode started: RGB(" + 
            String(fullSettings.staticColor.r) + "," + 
@@ -661,10 +1566,47 @@ void startColorCycleMode() {
   debugLog("Color cycle mode started with effect: " + String(fullSettings.colorMode));
 }
 
+// MODE_TEST: replay synthetic ArtNet through the real receiver and render path
+bool startBenchmarkMode(const BenchmarkConfig &config) {
+  stopAllModes();
+
+  if (!benchmarkStart(config, renderArtNetFrame)) {
+    debugLog("ERROR: Benchmark could not start");
+    applyModeSettings();
+    return false;
+  }
+  return true;
+}
+
+// Report a finished benchmark over UART and return to the configured mode
+void finishBenchmarkMode(const BenchmarkResult &result) {
+  // 0x84: achieved fps x10, parse/convert/show p99 in us, dropped frames, heap delta (big endian)
+  uint8_t packet[16];
+  uint16_t fpsX10 = result.achievedFps * 10;
+  packet[0] = fpsX10 >> 8;
+  packet[1] = fpsX10 & 0xFF;
+  for (int i = 0; i < PERF_STAGE_COUNT; i++) {
+    uint16_t p99 = min(result.stages[i].p99Us, 65535.0f);
+    packet[2 + i * 2] = p99 >> 8;
+    packet[3 + i * 2] = p99 & 0xFF;
+  }
+  packet[8] = (result.framesDropped >> 24) & 0xFF;
+  packet[9] = (result.framesDropped >> 16) & 0xFF;
+  packet[10] = (result.framesDropped >> 8) & 0xFF;
+  packet[11] = result.framesDropped & 0xFF;
+  packet[12] = (result.heapDelta >> 24) & 0xFF;
+  packet[13] = (result.heapDelta >> 16) & 0xFF;
+  packet[14] = (result.heapDelta >> 8) & 0xFF;
+  packet[15] = result.heapDelta & 0xFF;
+  uartBridge.sendCommand(0x84, packet, sizeof(packet));
+
+  applyModeSettings();
+}
+
 // Apply the current mode settings
 void applyModeSettings() {
   // Check which mode should be active and start it
-  if (fullSettings.useArtnet) {
+  if (networkInputEnabled()) {
     startArtNetMode();
   } else if (fullSettings.useStaticColor) {
     startStaticColorMode();
@@ -676,72 +1618,190 @@ void applyModeSettings() {
   }
 }
 
-// Helper function to setup ArtNet
-void setupArtNet() {
+// Helper function to start the common ArtNet receiver and frame pipeline
+bool startArtNetReceiver() {
   // Reset state if already running
-  if (state.artnetRunning) {
-    artnet.end();
-    state.artnetRunning = false;
-  }
+  stopArtNet();
   
   debugLog("Initializing ArtNet...");
   
-  // Configure ArtNet with universe and DMX callback
-  artnet.begin();
-  artnet.setArtDmxCallback(onDmxFrame);
-  artnet.setNodeName(settings.nodeName);
-  
-  // Set universe
+  // Mirror the full settings into the common receiver configuration
+  // One universe per 170 pixels, starting at the configured universe
+  int totalLeds = settings.ledCount;
   settings.artnetUniverse = fullSettings.startUniverse;
+  settings.artnetUniverseCount = (totalLeds + FRAME_PIXELS_PER_UNIVERSE - 1) / FRAME_PIXELS_PER_UNIVERSE;
+  settings.brightness = fullSettings.brightness;
+  settings.gamma = fullSettings.gamma;
+  settings.maxFps = fullSettings.maxFps;
+  settings.interpolateFrames = fullSettings.interpolateFrames;
+  settings.artnetEnabled = fullSettings.useArtnet;
+  settings.sacnEnabled = fullSettings.sacnEnabled;
+  
+  // Packets are parsed in the lwIP thread, pixels are pushed by the render task
+  if (!setupArtNet(renderArtNetFrame)) {
+    return false;
+  }
   
-  // Mark as running
-  state.artnetRunning = true;
   state.lastArtnetPacket = 0;
   
-  debugLog("ArtNet initialized, listening on universe " + String(settings.artnetUniverse));
+  debugLog("ArtNet initialized, listening on universes " + String(settings.artnetUniverse) + "-" +
+           String(settings.artnetUniverse + settings.artnetUniverseCount - 1));
+  return true;
 }
 
 // Create a minimal setup function that delegates to the common code
+// Network init runs in its own task - setup() either waits for it or, with fast
+// boot, leaves loop() to start the network services once it is done
+void startNetworkInit()
+{
+  if (networkInitFailed || !settings.useWiFi)
+  {
+    debugLog("Network disabled - skipping initialization");
+    return;
+  }
+
+  // Create synchronization semaphore
+  networkSemaphore = xSemaphoreCreateBinary();
+  if (networkSemaphore == NULL)
+  {
+    debugLog("ERROR: Failed to create network semaphore");
+  }
+
+  // Create network task on Core 1
+  debugLog("Creating network initialization task on Core 1");
+  xTaskCreatePinnedToCore(
+      networkInitTask,    // Task function
+      "NetworkInitTask",  // Task name
+      16384,              // Stack size (bytes)
+      NULL,               // Task parameter
+      5,                  // Task priority
+      &networkTaskHandle, // Task handle
+      1                   // Core to run the task on (Core 1)
+  );
+}
+
+// True once the network init task has signalled completion (or never ran)
+bool networkInitDone(TickType_t wait)
+{
+  if (networkSemaphore == NULL)
+  {
+    return true;
+  }
+  return xSemaphoreTake(networkSemaphore, wait) == pdTRUE;
+}
+
+// Web server and ArtNet - they need the TCP/IP stack the network init task sets up
+void startNetworkServices()
+{
+  networkServicesStarted = true;
+
+  // Async web server - requests are served by the AsyncTCP task, never by loop(),
+  // and reach it through the control queue
+  setupWebServer(registerWebRoutes);
+  webServerSetControlHandler(handleLiveControl);
+
+  // Initialize ArtNet if WiFi is connected
+  if (WiFi.status() == WL_CONNECTED && networkInputEnabled() && startArtNetReceiver() && bootFrameShown)
+  {
+    // Hold the boot frame through the pipeline until the first packet replaces it
+    framePipelineWrite(0, (const uint8_t *)leds, settings.ledCount * 3);
+    framePipelinePresent();
+  }
+
+  // From here on the packet, render, UART and status paths must not allocate
+  bootMark(BOOT_STAGE_READY);
+  heapMonitorSteadyState();
+  debugLog("Network services started");
+}
+
+// Fast boot: the last frame if it survived the reset, otherwise what the saved
+// settings would show - straight away, without the startup flash
+void showBootFrame()
+{
+  bootFrameShown = fastBootRestoreFrame((uint8_t *)leds, settings.ledCount * 3);
+  if (!bootFrameShown)
+  {
+    CRGB color = CRGB::Black;
+    if (fullSettings.useStaticColor && !networkInputEnabled())
+    {
+      color = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
+    }
+    fill_solid(leds, settings.ledCount, color);
+  }
+  showLEDs();
+  bootMark(BOOT_STAGE_FIRST_FRAME);
+  debugLog(bootFrameShown ? "Boot frame restored from RTC snapshot" : "Boot frame from saved settings");
+}
+
+// Startup flash, then the static color or black
+void showStartupPattern()
+{
+  fill_solid(leds, settings.ledCount, CRGB::Red);
+  showLEDs();
+  delay(200);
+  fill_solid(leds, settings.ledCount, CRGB::Green);
+  showLEDs();
+  delay(200);
+  fill_solid(leds, settings.ledCount, CRGB::Blue);
+  showLEDs();
+  delay(200);
+
+  // Show initial color based on static color setting
+  if (fullSettings.useStaticColor)
+  {
+    CRGB staticColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
+    fill_solid(leds, settings.ledCount, staticColor);
+    showLEDs();
+    debugLog("LEDs initialized with static color: RGB(" +
+             String(fullSettings.staticColor.r) + "," +
+             String(fullSettings.staticColor.g) + "," +
+             String(fullSettings.staticColor.b) + ")");
+  }
+  else
+  {
+    // Turn off if no static color
+    fill_solid(leds, settings.ledCount, CRGB::Black);
+    showLEDs();
+  }
+  bootMark(BOOT_STAGE_FIRST_FRAME);
+}
+
 void setup()
 {
   // Start with bare minimum initialization
   Serial.begin(115200);
-  delay(100);
+  bootMark(BOOT_STAGE_SETUP);
 
   // Initialize default settings
   initializeDefaultSettings();
+  effectsBegin();
 
   debugLog("ESP32 ArtNet LED Controller Starting - Full Version");
 
   // Load any saved settings from preferences
   loadSettings();
+  bootMark(BOOT_STAGE_SETTINGS);
 
-  // Initialize network components if network is available
-  if (!networkInitFailed && settings.useWiFi)
+  if (fullSettings.fastBoot)
   {
-    // Create synchronization semaphore
-    networkSemaphore = xSemaphoreCreateBinary();
-    if (networkSemaphore == NULL)
+    // Output first - the strips are lit while WiFi is still connecting
+    debugLog("Fast boot");
+    if (initLEDOutput())
     {
-      debugLog("ERROR: Failed to create network semaphore");
+      bootMark(BOOT_STAGE_OUTPUT);
+      showBootFrame();
     }
-
-    // Create network task on Core 1
-    debugLog("Creating network initialization task on Core 1");
-    xTaskCreatePinnedToCore(
-        networkInitTask,    // Task function
-        "NetworkInitTask",  // Task name
-        16384,              // Stack size (bytes)
-        NULL,               // Task parameter
-        5,                  // Task priority
-        &networkTaskHandle, // Task handle
-        1                   // Core to run the task on (Core 1)
-    );
+    startNetworkInit();
+  }
+  else
+  {
+    delay(100);
+    startNetworkInit();
 
     // Wait for network initialization to complete
     if (networkSemaphore != NULL)
     {
-      if (xSemaphoreTake(networkSemaphore, pdMS_TO_TICKS(10000)) == pdTRUE)
+      if (networkInitDone(pdMS_TO_TICKS(10000)))
       {
         debugLog("Network initialization completed");
       }
@@ -750,163 +1810,98 @@ void setup()
         debugLog("Network initialization timed out");
       }
     }
-  }
-  else
-  {
-    debugLog("Network disabled - skipping initialization");
-  }
-
-  // Initialize LED hardware
-  debugLog("Initializing LEDs - Pin: " + String(fullSettings.pins[0]) + ", Count: " + String(fullSettings.ledsPerStrip));
 
-  // Initialize FastLED with the LED strip configuration
-  if (fullSettings.pins[0] >= 0)
-  {
-    FastLED.addLeds<WS2812B, 12, GRB>(leds, fullSettings.ledsPerStrip); // Using pin 12 (default)
-
-    // Check if custom pin is different from default
-    if (fullSettings.pins[0] != 12)
+    // Initialize LED hardware
+    if (initLEDOutput())
     {
-      // If pin has been changed in settings, reinitialize with correct pin
-      switch (fullSettings.pins[0])
-      {
-      case 2:
-        FastLED.addLeds<WS2812B, 2, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 4:
-        FastLED.addLeds<WS2812B, 4, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 5:
-        FastLED.addLeds<WS2812B, 5, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 13:
-        FastLED.addLeds<WS2812B, 13, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 14:
-        FastLED.addLeds<WS2812B, 14, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 15:
-        FastLED.addLeds<WS2812B, 15, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 16:
-        FastLED.addLeds<WS2812B, 16, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 18:
-        FastLED.addLeds<WS2812B, 18, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 19:
-        FastLED.addLeds<WS2812B, 19, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 21:
-        FastLED.addLeds<WS2812B, 21, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 22:
-        FastLED.addLeds<WS2812B, 22, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 23:
-        FastLED.addLeds<WS2812B, 23, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 25:
-        FastLED.addLeds<WS2812B, 25, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 26:
-        FastLED.addLeds<WS2812B, 26, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 27:
-        FastLED.addLeds<WS2812B, 27, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 32:
-        FastLED.addLeds<WS2812B, 32, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      case 33:
-        FastLED.addLeds<WS2812B, 33, GRB>(leds, fullSettings.ledsPerStrip);
-        break;
-      default:
-        debugLog("WARNING: Using default pin 12 as pin " + String(fullSettings.pins[0]) + " is not explicitly supported");
-        break;
-      }
+      bootMark(BOOT_STAGE_OUTPUT);
+      showStartupPattern();
     }
+  }
 
-    // Set the LED brightness according to settings
-    FastLED.setBrightness(fullSettings.brightness);
+  // OLED status in its own task, the panel is initialized only here
+  statusDisplayBegin();
 
-    // Show startup pattern - flash red, green, blue
-    fill_solid(leds, fullSettings.ledsPerStrip, CRGB::Red);
-    FastLED.show();
-    delay(200);
-    fill_solid(leds, fullSettings.ledsPerStrip, CRGB::Green);
-    FastLED.show();
-    delay(200);
-    fill_solid(leds, fullSettings.ledsPerStrip, CRGB::Blue);
-    FastLED.show();
-    delay(200);
+  // Initialize UART bridge if needed
+  uartBridge.initializeCommunication();
+  uartBridge.setCommandCallback(handleUARTCommand);
+  uartBridge.setDmxDataCallback(handleUARTDmxData);
 
-    // Show initial color based on static color setting
-    if (fullSettings.useStaticColor)
-    {
-      CRGB staticColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
-      fill_solid(leds, fullSettings.ledsPerStrip, staticColor);
-      FastLED.show();
-      debugLog("LEDs initialized with static color: RGB(" +
-               String(fullSettings.staticColor.r) + "," +
-               String(fullSettings.staticColor.g) + "," +
-               String(fullSettings.staticColor.b) + ")");
-    }
-    else
-    {
-      // Turn off if no static color
-      fill_solid(leds, fullSettings.ledsPerStrip, CRGB::Black);
-      FastLED.show();
-    }
-  }
-  else
+  // Register-mapped status for monitor MCUs (code.py) on the second I2C port
+  i2cSlaveBegin();
+
+  // Web requests are queued for loop()
+  controlQueue = xQueueCreate(CONTROL_QUEUE_LENGTH, sizeof(ControlRequest));
+  if (controlQueue == NULL)
   {
-    debugLog("ERROR: LED pin not configured correctly! Pin value: " + String(fullSettings.pins[0]));
+    debugLog("ERROR: Failed to create control queue");
   }
 
-  // Initialize OLED display if available
-  if (!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS))
+  // Status and statistics updates from here on run in the housekeeping task
+  xTaskCreatePinnedToCore(
+      housekeepingTask,            // Task function
+      "Housekeeping",              // Task name
+      HOUSEKEEPING_TASK_STACK_SIZE, // Stack size (bytes)
+      NULL,                        // Task parameter
+      HOUSEKEEPING_TASK_PRIORITY,  // Task priority
+      &housekeepingTaskHandle,     // Task handle
+      HOUSEKEEPING_TASK_CORE       // Core to run the task on
+  );
+
+  // With fast boot, loop() starts the web server and ArtNet once WiFi is up
+  if (!fullSettings.fastBoot)
   {
-    debugLog("OLED initialization failed");
+    startNetworkServices();
   }
-  else
+
+  debugLog("Setup complete");
+}
+
+// Housekeeping task - publishes the status for the I2C register map and the
+// live view and samples the task statistics, so none of it runs between frames
+// on the LED core
+void housekeepingTask(void *parameter)
+{
+  TickType_t lastWake = xTaskGetTickCount();
+  unsigned long lastSample = 0;
+  unsigned long lastStatusUpdate = 0;
+  uint32_t reportedPathAllocs = 0;
+  heapMonitorSetPath(HEAP_PATH_STATUS);
+
+  while (true)
   {
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(SSD1306_WHITE);
-    display.setCursor(0, 0);
-    display.print("ESP32 ArtNet Controller");
-    display.setCursor(0, 10);
-    if (WiFi.status() == WL_CONNECTED)
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(HOUSEKEEPING_PERIOD_MS));
+
+    // Sketch-level status, counters are published by the render path
+    updateI2CStatus();
+
+    // ArtPoll replies, so discovery never runs in the receive path
+    artnetDiscoveryService();
+
+    unsigned long now = millis();
+    if (now - lastSample >= TASK_MONITOR_INTERVAL_MS)
     {
-      display.print("IP: ");
-      display.println(WiFi.localIP());
+      lastSample = now;
+      taskMonitorSample();
     }
-    else
+
+    if (now - lastStatusUpdate >= STATUS_UPDATE_INTERVAL_MS)
     {
-      display.println("WiFi: Not Connected");
+      lastStatusUpdate = now;
+      HeapMonitorStats heap;
+      heapMonitorGetStats(&heap);
+      logRingWrite(LOG_LEVEL_INFO, "Free heap: %u bytes, largest block %u", heap.freeBytes, heap.largestFreeBlock);
+
+      // The static memory budget is broken - say where, once per new batch
+      uint32_t pathAllocs = heapMonitorPathAllocs();
+      if (pathAllocs != reportedPathAllocs)
+      {
+        reportedPathAllocs = pathAllocs;
+        logRingWrite(LOG_LEVEL_WARNING, "Heap: %u steady-state allocations on the packet/render/UART/status paths, last %u bytes on %s",
+                     pathAllocs, heap.lastPathAllocSize, heapPathName(heap.lastPath));
+      }
     }
-    display.display();
-  }
-
-  // Initialize UART bridge if needed
-  uartBridge.initializeCommunication();
-  uartBridge.setCommandCallback(handleUARTCommand);
-
-  // Set up web server
-  server.on("/", handleRoot);
-  server.on("/config", HTTP_POST, handleConfig);
-  server.on("/debug", handleDebugLog);
-  server.begin();
-  debugLog("Web server started on port 80");
-
-  // Initialize ArtNet if WiFi is connected
-  if (WiFi.status() == WL_CONNECTED && fullSettings.useArtnet)
-  {
-    setupArtNet();
   }
-
-  debugLog("Setup complete");
 }
 
 // Create a minimal loop function
@@ -915,129 +1910,129 @@ void loop()
   // Keep the watchdog happy
   yield();
 
-  // Process pending web server requests
-  server.handleClient();
-
-  // Process UART bridge commands
-  uartBridge.processIncomingData();
-
-  // Periodically update status information
-  static unsigned long lastStatusUpdate = 0;
-  unsigned long currentMillis = millis();
+  // Control work may allocate - only the local-mode frames at the end are on the render path
+  heapMonitorSetPath(HEAP_PATH_NONE);
 
-  // Status update every 5 seconds
-  if (currentMillis - lastStatusUpdate > 5000)
+  // Fast boot defers the network services until the network init task is done
+  if (!networkServicesStarted && networkInitDone(0))
   {
-    lastStatusUpdate = currentMillis;
+    startNetworkServices();
+  }
 
-    // Log system status
-    debugLog("Free heap: " + String(ESP.getFreeHeap()) + " bytes");
+  // Config changes and live view controls from the web server, then the live view push
+  applyControlRequests();
+  webServerLoop();
 
-    // Update OLED display if available
-    if (display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS))
-    {
-      display.clearDisplay();
-      display.setTextSize(1);
-      display.setTextColor(SSD1306_WHITE);
+  // Dispatch UART commands queued by the RX task
+  heapMonitorSetPath(HEAP_PATH_UART);
+  uartBridge.processIncomingData();
+  heapMonitorSetPath(HEAP_PATH_NONE);
 
-      // Display header
-      display.setCursor(0, 0);
-      display.print("ESP32 ArtNet Controller");
+  // Write settings changed over UART once they have settled - all NVS writes
+  // stay in this task
+  saveSettingsIfDue();
 
-      // Display IP and connection status
-      display.setCursor(0, 10);
-      if (WiFi.status() == WL_CONNECTED)
-      {
-        display.print("IP: ");
-        display.println(WiFi.localIP());
-      }
-      else
-      {
-        display.println("WiFi: Not Connected");
-      }
+  // The benchmark owns the LEDs until it finishes
+  BenchmarkResult benchmarkResult;
+  if (benchmarkTakeResult(&benchmarkResult))
+  {
+    finishBenchmarkMode(benchmarkResult);
+  }
+  if (benchmarkRunning())
+  {
+    return;
+  }
 
-      // Display ArtNet status
-      display.setCursor(0, 20);
-      if (state.artnetRunning)
-      {
-        display.print("ArtNet: Universe ");
-        display.print(settings.artnetUniverse);
-      }
-      else
-      {
-        display.print("ArtNet: Disabled");
-      }
+  // Serial pixel streaming owns the LEDs while CMD_DMX_DATA keeps arriving
+  if (serialStreamRequested)
+  {
+    serialStreamRequested = false;
+    if (!framePipelineRunning())
+    {
+      startSerialStream();
+    }
+  }
+  if (serialStreamActive)
+  {
+    if (millis() - lastSerialDmx > SERIAL_STREAM_TIMEOUT_MS)
+    {
+      stopSerialStream();
+    }
+    return;
+  }
 
-      display.display();
+  // WiFi may connect long after the network services started - bring the
+  // receivers up then instead of leaving network mode dark until a reboot
+  static unsigned long lastReceiverAttempt = 0;
+  if (networkServicesStarted && !networkInitFailed && networkInputEnabled() && !state.artnetRunning &&
+      WiFi.status() == WL_CONNECTED && millis() - lastReceiverAttempt >= RECEIVER_RETRY_MS)
+  {
+    lastReceiverAttempt = millis();
+    if (startArtNetReceiver())
+    {
+      debugLog("Network receivers started after WiFi connected");
     }
   }
 
+  heapMonitorSetPath(HEAP_PATH_RENDER);
+  unsigned long currentMillis = millis();
+
   // Handle LED updates based on current mode
-  if (WiFi.status() == WL_CONNECTED && fullSettings.useArtnet && state.artnetRunning)
+  if (WiFi.status() == WL_CONNECTED && networkInputEnabled() && state.artnetRunning)
   {
     // ArtNet mode is active and working - let the callbacks handle updates
     // Just check for timeout (no packets received for a while)
     if (state.lastArtnetPacket > 0 && currentMillis - state.lastArtnetPacket > 10000)
     {
       // No packets for 10 seconds - show indicator on the strip
-      if (currentMillis % 2000 < 1000)
-      {
-        fill_solid(leds, settings.ledCount, CRGB::Blue);
-      }
-      else
+      // The render task owns the LEDs in ArtNet mode, so go through the pipeline
+      static unsigned long lastIndicatorUpdate = 0;
+      if (currentMillis - lastIndicatorUpdate >= 100)
       {
-        fill_solid(leds, settings.ledCount, CRGB::Black);
+        lastIndicatorUpdate = currentMillis;
+        if (currentMillis % 2000 < 1000)
+        {
+          framePipelineFill(0, 0, 255);
+        }
+        else
+        {
+          framePipelineFill(0, 0, 0);
+        }
+        framePipelinePresent();
       }
-      FastLED.show();
     }
   }
-  else if (!fullSettings.useArtnet)
+  else if (!networkInputEnabled())
   {
-    // Local control modes
+    // Local control modes - paced by frame deadlines instead of blocking delays,
+    // so the web server and UART keep being serviced between frames
+    static unsigned long nextLocalFrame = 0;
     if (fullSettings.useStaticColor)
     {
       // Static color mode
-      CRGB staticColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
-      fill_solid(leds, settings.ledCount, staticColor);
-      FastLED.show();
-      delay(50); // Small delay to prevent too frequent updates
+      if (localFrameDue(nextLocalFrame, STATIC_REFRESH_MS, currentMillis))
+      {
+        CRGB staticColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
+        fill_solid(leds, settings.ledCount, staticColor);
+        showLEDsIfChanged(currentMillis);
+      }
     }
     else if (fullSettings.useColorCycle)
     {
-      // Color cycle modes
-      static uint8_t hue = 0;
-      uint8_t speed = map(fullSettings.cycleSpeed, 1, 100, 1, 10);
-
-      switch (fullSettings.colorMode)
+      if (!localFrameDue(nextLocalFrame, fullSettings.maxFps ? 1000 / fullSettings.maxFps : EFFECT_FRAME_MS, currentMillis))
       {
-      case COLOR_MODE_RAINBOW:
-        // Rainbow cycle effect
-        fill_rainbow(leds, settings.ledCount, hue, 255 / settings.ledCount);
-        hue += speed;
-        break;
-
-      case COLOR_MODE_PULSE:
-        // Pulsing effect
-        {
-          uint8_t brightness = 128 + 127 * sin(currentMillis / 1000.0);
-          CRGB color = CHSV(hue, 255, brightness);
-          fill_solid(leds, settings.ledCount, color);
-          hue += speed / 2;
-        }
-        break;
+        return;
+      }
 
-      case COLOR_MODE_FIRE:
-        // Fire effect (simplified)
-        for (int i = 0; i < settings.ledCount; i++)
-        {
-          uint8_t flicker = random8(80);
-          leds[i] = CRGB(255 - flicker, 100 - flicker, 0);
-        }
-        break;
+      // Color cycle modes - drawn by the effects engine into every strip of the layout
+      CRGB baseColor = CRGB(fullSettings.staticColor.r, fullSettings.staticColor.g, fullSettings.staticColor.b);
+      effectsSetParams(fullSettings.cycleSpeed, baseColor);
+      if (!effectsRender(fullSettings.colorMode, &ledLayout, leds, settings.ledCount, currentMillis))
+      {
+        return;
       }
 
-      FastLED.show();
-      delay(20); // Small delay to control frame rate
+      showLEDs();
     }
     else
     {
@@ -1045,7 +2040,7 @@ void loop()
       if (currentMillis % 10000 == 0)
       { // Only update occasionally to save power
         fill_solid(leds, settings.ledCount, CRGB::Black);
-        FastLED.show();
+        showLEDs();
       }
     }
   }
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Embedded Web UI Generator
+
+Compresses web/embedded_ui.html with gzip and writes it to EmbeddedWebUI.h (top
+level and esp-gpt-i2c-full/) as a PROGMEM byte array. The web server sends the array straight from flash with
+Content-Encoding: gzip, so the page is never built or copied in RAM.
+
+Run it again after editing the HTML:
+    python3 scripts/embed_web_ui.py
+"""
+
+import gzip
+from pathlib import Path
+
+# Configuration
+PROJECT_ROOT = Path(__file__).resolve().parent.parent
+SOURCE_FILE = PROJECT_ROOT / 'web' / 'embedded_ui.html'
+OUTPUT_FILES = [
+    PROJECT_ROOT / 'EmbeddedWebUI.h',
+    PROJECT_ROOT / 'esp-gpt-i2c-full' / 'EmbeddedWebUI.h',
+]
+BYTES_PER_LINE = 16
+
+def compress(data):
+    """Gzip with a fixed timestamp so the output only changes with the HTML"""
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+def render_header(html, packed):
+    """C header with the compressed page as a PROGMEM array"""
+    lines = [
+        '#ifndef EMBEDDED_WEB_UI_H',
+        '#define EMBEDDED_WEB_UI_H',
+        '',
+        '#include <Arduino.h>',
+        '',
+        '// Generated by scripts/embed_web_ui.py from web/embedded_ui.html - do not edit.',
+        '// Gzip-compressed, served as-is with Content-Encoding: gzip',
+        '// (%d bytes uncompressed).' % len(html),
+        '#define EMBEDDED_UI_GZ_LENGTH %d' % len(packed),
+        '',
+        'static const uint8_t EMBEDDED_UI_GZ[EMBEDDED_UI_GZ_LENGTH] PROGMEM = {',
+    ]
+    for offset in range(0, len(packed), BYTES_PER_LINE):
+        chunk = packed[offset:offset + BYTES_PER_LINE]
+        lines.append('    ' + ', '.join('0x%02x' % b for b in chunk) + ',')
+    lines += [
+        '};',
+        '',
+        '#endif // EMBEDDED_WEB_UI_H',
+        '',
+    ]
+    return '\n'.join(lines)
+
+def main():
+    html = SOURCE_FILE.read_bytes()
+    packed = compress(html)
+    header = render_header(html, packed)
+    for output in OUTPUT_FILES:
+        output.write_text(header)
+        print("Wrote %s: %d bytes -> %d bytes gzip" % (output.relative_to(PROJECT_ROOT), len(html), len(packed)))
+
+if __name__ == "__main__":
+    main()
@@ -31,8 +31,26 @@
 #define LOG_LEVEL_INFO 2
 #define LOG_LEVEL_WARNING 3
 #define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF 5          // Module level that silences the module entirely
 #define LOG_LEVEL LOG_LEVEL_INFO
-#define MAX_LOG_ENTRIES 50
+// Build-time threshold - LOG_* macros below it compile to nothing, so their
+// message expressions are never evaluated. Override with -DLOG_COMPILE_LEVEL=...
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+#define MAX_LOG_ENTRIES 64        // Log ring records, must be a power of two
+#define LOG_MESSAGE_SIZE 80       // Inline text per record, longer messages are cut
+#define LOG_MAX_ARGS 4            // Raw 32-bit arguments per deferred-format record
+#define LOG_TASK_PRIORITY 1
+#define LOG_FLUSH_INTERVAL_MS 20
+
+// Log modules - each translation unit picks one with #define LOG_MODULE before its includes
+#define LOG_MODULE_GENERAL 0
+#define LOG_MODULE_NETWORK 1
+#define LOG_MODULE_SYSTEM 2
+#define LOG_MODULE_ARTNET 3
+#define LOG_MODULE_UART 4
+#define LOG_MODULE_COUNT 5
 
 // Core allocation for tasks
 #define NETWORK_CORE 0          // Core for network operations
@@ -42,6 +60,16 @@
 #define WIFI_TASK_PRIORITY 5
 #define LED_TASK_PRIORITY 4
 #define MDNS_TASK_PRIORITY 3
+#define HOUSEKEEPING_TASK_PRIORITY 1
+
+// Housekeeping task - watchdog, status, task statistics and control requests
+#define HOUSEKEEPING_CORE NETWORK_CORE
+#define HOUSEKEEPING_STACK_SIZE 4096
+#define HOUSEKEEPING_INTERVAL_MS 100
+#define CONTROL_QUEUE_LENGTH 8          // Pending control requests, more are dropped
+
+// Per-task runtime statistics come from the shared TaskMonitor module, sampled
+// by the housekeeping task every TASK_MONITOR_INTERVAL_MS
 
 // Watchdog configuration
 #define WATCHDOG_TIMEOUT_MS 5000
@@ -51,8 +79,18 @@
 // =========================================================================
 
 // WiFi configuration
-#define WIFI_RECONNECT_INTERVAL_MS 30000  // 30 seconds between reconnection attempts
-#define WIFI_CONNECT_TIMEOUT_MS 15000     // 15 seconds timeout for WiFi connection
+#define WIFI_RECONNECT_MIN_MS 250         // First retry delay after a disconnect, doubled per failure
+#define WIFI_RECONNECT_INTERVAL_MS 30000  // Backoff ceiling between reconnection attempts
+// Shared with ESP_GPT_I2C_Common.h - keep the values in step
+#ifndef WIFI_CONNECT_TIMEOUT_MS
+#define WIFI_CONNECT_TIMEOUT_MS 8000      // Outage length before falling back to AP mode
+#endif
+#ifndef WIFI_FAST_CONNECT_TIMEOUT_MS
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 2000 // Timeout for a connect using the cached BSSID/channel
+#endif
+#ifndef WIFI_CACHE_NAMESPACE
+#define WIFI_CACHE_NAMESPACE "wifi-cache" // Preferences namespace for the cached BSSID/channel
+#endif
 #define WIFI_AP_FALLBACK_ENABLED true     // Enable Access Point fallback if station connection fails
 #define WIFI_AP_NAME_PREFIX "ESP32-ArtNet-"  // AP name prefix, will append chip ID
 #define WIFI_AP_PASSWORD "artnet12345"    // Default AP password
@@ -76,7 +114,7 @@
 // =========================================================================
 
 // LED hardware configuration
-#define MAX_LED_STRIPS 4            // Maximum number of LED strips
+#define MAX_LED_STRIPS 12           // Maximum number of LED strips (one data pin each)
 #define MAX_LEDS_PER_STRIP 300      // Maximum number of LEDs per strip
 #define STRIPS_PER_PIN 3            // Number of strips per output pin (for I2SClocklessLedDriver)
 #define DEFAULT_LED_COUNT 144       // Default number of LEDs per strip
@@ -99,6 +137,9 @@
 #define BOOT_COUNT_KEY "bootCnt"
 #define LAST_BOOT_TIME_KEY "lastBoot"
 #define NETWORK_FAILURE_KEY "netFailed"
+#define SETTINGS_BLOB_KEY "settings"   // All of SystemSettings as one StoredSettings record
+#define SETTINGS_BLOB_VERSION 1
+#define SETTINGS_COMMIT_DELAY_MS 2000  // Quiet period before a scheduled save is written
 
 // =========================================================================
 // SYSTEM STRUCTURES
@@ -120,7 +161,7 @@ enum OperatingMode {
   MODE_SAFE = 4          // Safe mode (minimal functionality)
 };
 
-// Effect types for MODE_EFFECT
+// Effect types for MODE_EFFECT - the built-in LedEffects set (EFFECT_ID_* is type + 1)
 enum EffectType {
   EFFECT_RAINBOW = 0,    // Rainbow color cycle
   EFFECT_PULSE = 1,      // Pulsing brightness effect
@@ -141,15 +182,20 @@ enum NetworkState {
 };
 
 // System settings structure (stored in preferences)
+// Credential buffers, terminator included - fixed size, so settings never touch the heap
+#define SETTINGS_SSID_SIZE 33
+#define SETTINGS_PASSWORD_SIZE 65
+#define SETTINGS_DEVICE_NAME_SIZE 33
+
 struct SystemSettings {
   // WiFi settings
-  String ssid;
-  String password;
+  char ssid[SETTINGS_SSID_SIZE];
+  char password[SETTINGS_PASSWORD_SIZE];
   bool useWiFi;
   bool createAP;
   
   // Device identification
-  String deviceName;
+  char deviceName[SETTINGS_DEVICE_NAME_SIZE];
   
   // ArtNet settings
   bool useArtnet;
@@ -170,6 +216,44 @@ struct SystemSettings {
   uint32_t bootCount;           // Number of boots
 };
 
+// SystemSettings as written to NVS in one putBytes(). Fields are only ever
+// appended, so a blob from an older version loads as a prefix.
+struct __attribute__((packed)) StoredSettings {
+  uint8_t version;              // SETTINGS_BLOB_VERSION
+  uint16_t size;                // sizeof(StoredSettings) when written
+  char ssid[SETTINGS_SSID_SIZE];
+  char password[SETTINGS_PASSWORD_SIZE];
+  char deviceName[SETTINGS_DEVICE_NAME_SIZE];
+  uint8_t useWiFi;
+  uint8_t createAP;
+  uint8_t useArtnet;
+  uint16_t artnetUniverse;
+  uint8_t mode;
+  uint8_t effectType;
+  uint8_t effectSpeed;
+  uint16_t numStrips;
+  uint16_t ledsPerStrip;
+  int8_t pins[MAX_LED_STRIPS];
+  uint8_t brightness;
+  uint8_t colorR;
+  uint8_t colorG;
+  uint8_t colorB;
+  uint8_t safeMode;
+};
+
+// Requests for the housekeeping task, posted through SystemManager::postControl()
+enum ControlCommand : uint8_t {
+  CONTROL_SAVE_SETTINGS = 0,
+  CONTROL_RESET_SETTINGS,
+  CONTROL_NETWORK_RECONNECT,
+  CONTROL_RESTART
+};
+
+struct ControlMessage {
+  ControlCommand command;
+  uint32_t value;               // Command argument, unused so far
+};
+
 // System status structure
 struct SystemStatus {
   // Network status
@@ -195,13 +279,25 @@ struct SystemStatus {
   // Task status
   bool ledTaskRunning;
   bool networkTaskRunning;
+  bool housekeepingTaskRunning;
+  uint32_t controlDropped;      // Control requests lost to a full queue
 };
 
-// Log entry structure
+// Log entry structure - fixed size, written in place in the log ring
+#define LOG_ENTRY_TEXT 0xFF     // argCount marker: message holds preformatted text
 struct LogEntry {
-  unsigned long timestamp;      // Time since boot in ms
+  uint32_t sequence;            // Ring index + 1 once complete, 0 while being written
+  uint32_t timestamp;           // Time since boot in ms
   uint8_t level;                // Log level
-  String message;               // Log message
+  uint8_t argCount;             // Deferred-format arguments, or LOG_ENTRY_TEXT
+  uint8_t module;               // LOG_MODULE_*
+  uint16_t line;                // Source line, 0 if none
+  const char *file;             // __FILE__ literal, or nullptr
+  const char *format;           // Format literal for deferred records
+  union {
+    uint32_t args[LOG_MAX_ARGS];
+    char message[LOG_MESSAGE_SIZE];
+  };
 };
 
 #endif // ESP32_ARTNET_CONFIG_H
\ No newline at end of file
@@ -8,63 +8,170 @@
 
 #include "Logger.h"
 #include <ArduinoJson.h>
+#include <stdarg.h>
+
+#define LOG_LINE_SIZE 160
+
+// Print adapter that appends to a String, for the String-returning wrappers
+class StringPrint : public Print {
+public:
+    explicit StringPrint(String& target) : _target(target) {}
+    size_t write(uint8_t c) override {
+        _target += (char)c;
+        return 1;
+    }
+    
+private:
+    String& _target;
+};
 
 // Initialize static members
-std::vector<LogEntry> Logger::_logs;
-int Logger::_logIndex = 0;
+LogEntry Logger::_logs[MAX_LOG_ENTRIES];
+volatile uint32_t Logger::_writeIndex = 0;
+volatile uint32_t Logger::_readIndex = 0;
+uint32_t Logger::_clearIndex = 0;
+volatile uint32_t Logger::_dropped = 0;
 uint8_t Logger::_logLevel = LOG_LEVEL;
+uint8_t Logger::_moduleLevels[LOG_MODULE_COUNT] = {
+    LOG_LEVEL_VERBOSE, LOG_LEVEL_VERBOSE, LOG_LEVEL_VERBOSE, LOG_LEVEL_VERBOSE, LOG_LEVEL_VERBOSE
+};
 bool Logger::_serialOutput = LOG_TO_SERIAL;
-std::mutex Logger::_logMutex;
+TaskHandle_t Logger::_taskHandle = nullptr;
 
 // Initialize the logger
 void Logger::init() {
-    // Reserve memory for logs to prevent reallocations
-    _logs.reserve(MAX_LOG_ENTRIES);
-    
     if (_serialOutput) {
         Serial.begin(115200);
         // Small delay to ensure Serial is ready
         delay(100);
         Serial.println(F("Logger initialized"));
     }
+    
+    if (_taskHandle == nullptr) {
+        xTaskCreatePinnedToCore(
+            formatTask,          // Task function
+            "LogTask",           // Task name
+            3072,                // Stack size (bytes)
+            nullptr,             // Task parameter
+            LOG_TASK_PRIORITY,   // Task priority
+            &_taskHandle,        // Task handle
+            NETWORK_CORE         // Core to run the task on
+        );
+    }
+}
+
+// Claim the next slot - the one atomic add is the only shared write
+LogEntry* Logger::claimEntry(uint32_t* index) {
+    *index = __atomic_fetch_add(&_writeIndex, 1, __ATOMIC_RELAXED);
+    LogEntry* entry = &_logs[*index & (MAX_LOG_ENTRIES - 1)];
+    __atomic_store_n(&entry->sequence, 0, __ATOMIC_RELAXED);
+    return entry;
+}
+
+void Logger::commitEntry(LogEntry* entry, uint32_t index) {
+    __atomic_store_n(&entry->sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+// Copy an entry out only if it still belongs to index (re-checked after the copy)
+bool Logger::readEntry(uint32_t index, LogEntry* copy) {
+    const LogEntry* entry = &_logs[index & (MAX_LOG_ENTRIES - 1)];
+    if (__atomic_load_n(&entry->sequence, __ATOMIC_ACQUIRE) != index + 1) {
+        return false;
+    }
+    memcpy(copy, entry, sizeof(LogEntry));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&entry->sequence, __ATOMIC_RELAXED) == index + 1;
 }
 
 // Log a message with specified level
 void Logger::log(uint8_t level, const String& message) {
-    // Skip logging if message is below current log level
-    if (level < _logLevel) {
+    log(level, LOG_MODULE_GENERAL, nullptr, 0, message.c_str());
+}
+
+void Logger::log(uint8_t level, const char* file, int line, const String& message) {
+    log(level, LOG_MODULE_GENERAL, file, line, message.c_str());
+}
+
+void Logger::log(uint8_t level, const char* file, int line, const char* message) {
+    log(level, LOG_MODULE_GENERAL, file, line, message);
+}
+
+void Logger::log(uint8_t level, uint8_t module, const char* file, int line, const String& message) {
+    log(level, module, file, line, message.c_str());
+}
+
+void Logger::log(uint8_t level, uint8_t module, const char* file, int line, const char* message) {
+    // Skip logging if message is below the global or module level
+    if (!isEnabled(level, module)) {
+        return;
+    }
+    writeText(level, module, file, line, message);
+}
+
+void Logger::logf(uint8_t level, const char* format, ...) {
+    if (!isEnabled(level, LOG_MODULE_GENERAL)) {
         return;
     }
     
-    // Get current timestamp
-    unsigned long timestamp = millis();
-    
-    // Output to Serial if enabled
-    if (_serialOutput) {
-        Serial.print(formatTimestamp(timestamp));
-        Serial.print(F(" ["));
-        Serial.print(levelToString(level));
-        Serial.print(F("] "));
-        Serial.println(message);
+    va_list args;
+    va_start(args, format);
+    writeArgs(level, LOG_MODULE_GENERAL, format, args);
+    va_end(args);
+}
+
+void Logger::logf(uint8_t level, uint8_t module, const char* format, ...) {
+    if (!isEnabled(level, module)) {
+        return;
     }
     
-    // Lock the mutex to ensure thread safety
-    std::lock_guard<std::mutex> lock(_logMutex);
+    va_list args;
+    va_start(args, format);
+    writeArgs(level, module, format, args);
+    va_end(args);
+}
+
+void Logger::writeText(uint8_t level, uint8_t module, const char* file, int line, const char* message) {
+    uint32_t index;
+    LogEntry* entry = claimEntry(&index);
+    entry->timestamp = millis();
+    entry->level = level;
+    entry->module = module;
+    entry->argCount = LOG_ENTRY_TEXT;
+    entry->file = file;
+    entry->line = line;
+    entry->format = nullptr;
+    strlcpy(entry->message, message, sizeof(entry->message));
+    commitEntry(entry, index);
+}
+
+void Logger::writeArgs(uint8_t level, uint8_t module, const char* format, va_list args) {
+    uint32_t index;
+    LogEntry* entry = claimEntry(&index);
+    entry->timestamp = millis();
+    entry->level = level;
+    entry->module = module;
+    entry->file = nullptr;
+    entry->line = 0;
+    entry->format = format;
     
-    // Create a new log entry
-    LogEntry entry;
-    entry.timestamp = timestamp;
-    entry.level = level;
-    entry.message = message;
+    // One argument per conversion, "%%" excluded
+    uint8_t argCount = 0;
+    for (const char* p = format; *p != '\0' && argCount < LOG_MAX_ARGS; p++) {
+        if (*p == '%') {
+            if (p[1] == '%') {
+                p++;
+            } else {
+                argCount++;
+            }
+        }
+    }
     
-    // Store the log entry
-    if (_logs.size() < MAX_LOG_ENTRIES) {
-        _logs.push_back(entry);
-    } else {
-        // Replace oldest entry in circular buffer style
-        _logs[_logIndex] = entry;
-        _logIndex = (_logIndex + 1) % MAX_LOG_ENTRIES;
+    for (uint8_t i = 0; i < argCount; i++) {
+        entry->args[i] = va_arg(args, uint32_t);
     }
+    entry->argCount = argCount;
+    
+    commitEntry(entry, index);
 }
 
 // Convenience methods for different log levels
@@ -88,96 +195,172 @@ void Logger::error(const String& message) {
     log(LOG_LEVEL_ERROR, message);
 }
 
-// Get the most recent log entries as a JSON string
-String Logger::getLogsAsJson(int count) {
-    StaticJsonDocument<4096> doc;
-    JsonArray logsArray = doc.createNestedArray("logs");
-    
-    // Lock the mutex to ensure thread safety
-    std::lock_guard<std::mutex> lock(_logMutex);
-    
-    // Determine how many logs to return
-    int logCount = std::min(static_cast<int>(_logs.size()), count);
-    if (logCount == 0) {
-        // Return empty array if no logs
-        String result;
-        serializeJson(doc, result);
-        return result;
+// Message text of an entry, "[file:line] " prefixed when known
+void Logger::formatEntry(const LogEntry& entry, char* buffer, size_t size, bool withTimestamp) {
+    int used = 0;
+    if (withTimestamp) {
+        used = snprintf(buffer, size, "%s [%s] ", formatTimestamp(entry.timestamp).c_str(),
+                        levelToString(entry.level));
+    }
+    if (entry.module != LOG_MODULE_GENERAL && used >= 0 && (size_t)used < size) {
+        used += snprintf(buffer + used, size - used, "%s: ", moduleToString(entry.module));
+    }
+    if (entry.file != nullptr && used >= 0 && (size_t)used < size) {
+        const char* base = strrchr(entry.file, '/');
+        used += snprintf(buffer + used, size - used, "[%s:%u] ", base ? base + 1 : entry.file, entry.line);
+    }
+    if (used < 0 || (size_t)used >= size) {
+        return;
     }
     
-    // Find the starting index for most recent logs
-    int startIdx;
-    if (_logs.size() < MAX_LOG_ENTRIES) {
-        // Not filled up yet, start from 0
-        startIdx = 0;
+    if (entry.argCount == LOG_ENTRY_TEXT) {
+        strlcpy(buffer + used, entry.message, size - used);
     } else {
-        // Calculate starting index to get most recent entries
-        startIdx = (_logIndex - logCount + MAX_LOG_ENTRIES) % MAX_LOG_ENTRIES;
+        // Every argument is a 32-bit word, so passing all of them is safe for any format
+        snprintf(buffer + used, size - used, entry.format,
+                 entry.args[0], entry.args[1], entry.args[2], entry.args[3]);
     }
+}
+
+// Print everything committed since the last call
+void Logger::drainToSerial() {
+    char line[LOG_LINE_SIZE];
+    LogEntry entry;
     
-    // Add log entries to JSON
-    for (int i = 0; i < logCount; i++) {
-        int idx = (startIdx + i) % std::min(static_cast<int>(_logs.size()), MAX_LOG_ENTRIES);
-        JsonObject logObj = logsArray.createNestedObject();
-        logObj["time"] = _logs[idx].timestamp;
-        logObj["level"] = _logs[idx].level;
-        logObj["levelStr"] = levelToString(_logs[idx].level);
-        logObj["message"] = _logs[idx].message;
+    for (;;) {
+        uint32_t head = __atomic_load_n(&_writeIndex, __ATOMIC_ACQUIRE);
+        if (_readIndex == head) {
+            return;
+        }
+        
+        // Lapped - everything older than one ring is gone
+        if (head - _readIndex > MAX_LOG_ENTRIES) {
+            _dropped += head - _readIndex - MAX_LOG_ENTRIES;
+            _readIndex = head - MAX_LOG_ENTRIES;
+        }
+        
+        if (!readEntry(_readIndex, &entry)) {
+            uint32_t sequence = __atomic_load_n(&_logs[_readIndex & (MAX_LOG_ENTRIES - 1)].sequence, __ATOMIC_ACQUIRE);
+            if (sequence == 0 || sequence <= _readIndex) {
+                return; // Still being written, pick it up next time
+            }
+            _dropped++; // Overwritten by a newer entry
+            _readIndex++;
+            continue;
+        }
+        
+        if (_serialOutput) {
+            formatEntry(entry, line, sizeof(line), true);
+            Serial.println(line);
+        }
+        _readIndex++;
     }
-    
+}
+
+void Logger::formatTask(void* parameter) {
+    for (;;) {
+        drainToSerial();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_FLUSH_INTERVAL_MS));
+    }
+}
+
+// Print everything pending now
+void Logger::flush() {
+    if (_taskHandle == nullptr) {
+        drainToSerial();
+    } else {
+        // Only the formatter task drains - wake it and give it a moment to catch up
+        for (int i = 0; i < 10 && _readIndex != _writeIndex; i++) {
+            xTaskNotifyGive(_taskHandle);
+            vTaskDelay(pdMS_TO_TICKS(5));
+        }
+    }
+    Serial.flush();
+}
+
+// Get the most recent log entries as a JSON string
+String Logger::getLogsAsJson(int count) {
     String result;
-    serializeJson(doc, result);
+    result.reserve(64 + count * 96);
+    StringPrint out(result);
+    printLogsAsJson(out, count);
     return result;
 }
 
+// Stream the most recent log entries as {"logs":[...]}
+int Logger::printLogsAsJson(Print& out, int count) {
+    StaticJsonDocument<LOG_LINE_SIZE + 128> doc;
+    char message[LOG_LINE_SIZE];
+    LogEntry entry;
+    
+    // Determine how many logs to return
+    uint32_t head = __atomic_load_n(&_writeIndex, __ATOMIC_ACQUIRE);
+    uint32_t available = std::min(head - _clearIndex, (uint32_t)MAX_LOG_ENTRIES);
+    uint32_t logCount = std::min(available, (uint32_t)std::max(count, 0));
+    
+    // Serialize one entry at a time, oldest first
+    int written = 0;
+    out.print(F("{\"logs\":["));
+    for (uint32_t index = head - logCount; index != head; index++) {
+        if (!readEntry(index, &entry)) {
+            continue;
+        }
+        formatEntry(entry, message, sizeof(message), false);
+        doc.clear();
+        doc["time"] = entry.timestamp;
+        doc["level"] = entry.level;
+        doc["levelStr"] = levelToString(entry.level);
+        doc["module"] = moduleToString(entry.module);
+        doc["message"] = (const char*)message;
+        if (written++ > 0) {
+            out.print(',');
+        }
+        serializeJson(doc, out);
+    }
+    out.print(F("]}"));
+    
+    return written;
+}
+
 // Get the most recent log entries as a formatted string
 String Logger::getLogsAsText(int count) {
     String result = "";
-    
-    // Lock the mutex to ensure thread safety
-    std::lock_guard<std::mutex> lock(_logMutex);
+    char line[LOG_LINE_SIZE];
+    LogEntry entry;
     
     // Determine how many logs to return
-    int logCount = std::min(static_cast<int>(_logs.size()), count);
+    uint32_t head = __atomic_load_n(&_writeIndex, __ATOMIC_ACQUIRE);
+    uint32_t available = std::min(head - _clearIndex, (uint32_t)MAX_LOG_ENTRIES);
+    uint32_t logCount = std::min(available, (uint32_t)std::max(count, 0));
     if (logCount == 0) {
         return "No logs available";
     }
     
-    // Find the starting index for most recent logs
-    int startIdx;
-    if (_logs.size() < MAX_LOG_ENTRIES) {
-        // Not filled up yet, start from 0
-        startIdx = 0;
-    } else {
-        // Calculate starting index to get most recent entries
-        startIdx = (_logIndex - logCount + MAX_LOG_ENTRIES) % MAX_LOG_ENTRIES;
-    }
-    
     // Add log entries to result string
-    for (int i = 0; i < logCount; i++) {
-        int idx = (startIdx + i) % std::min(static_cast<int>(_logs.size()), MAX_LOG_ENTRIES);
-        result += formatTimestamp(_logs[idx].timestamp);
-        result += " [";
-        result += levelToString(_logs[idx].level);
-        result += "] ";
-        result += _logs[idx].message;
-        result += "\n";
+    for (uint32_t index = head - logCount; index != head; index++) {
+        if (readEntry(index, &entry)) {
+            formatEntry(entry, line, sizeof(line), true);
+            result += line;
+            result += "\n";
+        }
     }
     
     return result;
 }
 
-// Clear all log entries
+// Clear all log entries - they stay in the ring but are no longer reported
 void Logger::clearLogs() {
-    std::lock_guard<std::mutex> lock(_logMutex);
-    _logs.clear();
-    _logIndex = 0;
+    _clearIndex = __atomic_load_n(&_writeIndex, __ATOMIC_ACQUIRE);
 }
 
 // Get the number of stored log entries
 int Logger::getLogCount() {
-    std::lock_guard<std::mutex> lock(_logMutex);
-    return _logs.size();
+    uint32_t head = __atomic_load_n(&_writeIndex, __ATOMIC_ACQUIRE);
+    return std::min(head - _clearIndex, (uint32_t)MAX_LOG_ENTRIES);
+}
+
+uint32_t Logger::getDroppedCount() {
+    return _dropped;
 }
 
 // Enable/disable Serial output
@@ -190,21 +373,48 @@ void Logger::setLogLevel(uint8_t level) {
     _logLevel = level;
 }
 
+void Logger::setModuleLevel(uint8_t module, uint8_t level) {
+    if (module < LOG_MODULE_COUNT) {
+        _moduleLevels[module] = level;
+    }
+}
+
+uint8_t Logger::getModuleLevel(uint8_t module) {
+    return module < LOG_MODULE_COUNT ? _moduleLevels[module] : LOG_LEVEL_OFF;
+}
+
+const char* Logger::moduleToString(uint8_t module) {
+    switch (module) {
+        case LOG_MODULE_GENERAL:
+            return "General";
+        case LOG_MODULE_NETWORK:
+            return "Network";
+        case LOG_MODULE_SYSTEM:
+            return "System";
+        case LOG_MODULE_ARTNET:
+            return "ArtNet";
+        case LOG_MODULE_UART:
+            return "UART";
+        default:
+            return "Unknown";
+    }
+}
+
 // Get log level as string
-String Logger::levelToString(uint8_t level) {
+const char* Logger::levelToString(uint8_t level) {
     switch (level) {
         case LOG_LEVEL_VERBOSE:
-            return F("VERBOSE");
+            return "VERBOSE";
         case LOG_LEVEL_DEBUG:
-            return F("DEBUG");
+            return "DEBUG";
         case LOG_LEVEL_INFO:
-            return F("INFO");
+            return "INFO";
         case LOG_LEVEL_WARNING:
-            return F("WARNING");
+            return "WARNING";
         case LOG_LEVEL_ERROR:
-            return F("ERROR");
+            return "ERROR";
         default:
-            return F("UNKNOWN");
+            return "UNKNOWN";
     }
 }
 
@@ -224,4 +434,4 @@ String Logger::formatTimestamp(unsigned long timestamp) {
             timestamp % 1000);
     
     return String(buffer);
-}
\ No newline at end of file
+}
@@ -7,6 +7,9 @@
  * 
  * This file implements a flexible logging system with multiple verbosity
  * levels, timestamps, and support for both serial output and in-memory logs.
+ * Entries are fixed-size records in a ring: a writer claims a slot with one
+ * atomic index bump and never allocates, locks or touches Serial - a
+ * low-priority task formats the records and prints them.
  */
 
 #ifndef ESP32_ARTNET_LOGGER_H
@@ -14,16 +17,29 @@
 
 #include "Config.h"
 #include <Arduino.h>
-#include <vector>
-#include <mutex>
+#include <stdarg.h>
 
 class Logger {
 public:
-    // Initialize the logger
+    // Initialize the logger and start the formatter task
     static void init();
     
     // Log a message with specified level
     static void log(uint8_t level, const String& message);
+    static void log(uint8_t level, const char* file, int line, const String& message);
+    static void log(uint8_t level, const char* file, int line, const char* message);
+    static void log(uint8_t level, uint8_t module, const char* file, int line, const String& message);
+    static void log(uint8_t level, uint8_t module, const char* file, int line, const char* message);
+    
+    // Deferred printf - the format must be a literal and every argument a 32-bit
+    // integer or a pointer to a string that outlives the record (no floats)
+    static void logf(uint8_t level, const char* format, ...);
+    static void logf(uint8_t level, uint8_t module, const char* format, ...);
+    
+    // Cheap pre-check used by the LOG_* macros before the message is built
+    static inline bool isEnabled(uint8_t level, uint8_t module) {
+        return level >= _logLevel && module < LOG_MODULE_COUNT && level >= _moduleLevels[module];
+    }
     
     // Convenience methods for different log levels
     static void verbose(const String& message);
@@ -35,6 +51,10 @@ public:
     // Get the most recent log entries as a JSON string
     static String getLogsAsJson(int count = MAX_LOG_ENTRIES);
     
+    // Write the same JSON entry by entry to a stream (e.g. an AsyncResponseStream),
+    // so only one entry is ever held in memory. Returns the number of entries written.
+    static int printLogsAsJson(Print& out, int count = MAX_LOG_ENTRIES);
+    
     // Get the most recent log entries as a formatted string
     static String getLogsAsText(int count = MAX_LOG_ENTRIES);
     
@@ -44,31 +64,99 @@ public:
     // Get the number of stored log entries
     static int getLogCount();
     
+    // Records overwritten before the formatter task printed them
+    static uint32_t getDroppedCount();
+    
+    // Print everything pending now, e.g. before a restart
+    static void flush();
+    
     // Enable/disable Serial output
     static void setSerialOutput(bool enabled);
     
     // Set log level (messages below this level will be ignored)
     static void setLogLevel(uint8_t level);
+    
+    // Per-module threshold on top of the global level, LOG_LEVEL_OFF silences the module
+    static void setModuleLevel(uint8_t module, uint8_t level);
+    static uint8_t getModuleLevel(uint8_t module);
+    
+    static const char* moduleToString(uint8_t module);
 
 private:
-    static std::vector<LogEntry> _logs;
-    static int _logIndex;
+    static LogEntry _logs[MAX_LOG_ENTRIES];
+    static volatile uint32_t _writeIndex;
+    static volatile uint32_t _readIndex;   // Next entry for Serial, formatter task only
+    static uint32_t _clearIndex;           // Entries before this were cleared
+    static volatile uint32_t _dropped;
     static uint8_t _logLevel;
+    static uint8_t _moduleLevels[LOG_MODULE_COUNT];
     static bool _serialOutput;
-    static std::mutex _logMutex;
+    static TaskHandle_t _taskHandle;
+    
+    // Ring access
+    static LogEntry* claimEntry(uint32_t* index);
+    static void writeText(uint8_t level, uint8_t module, const char* file, int line, const char* message);
+    static void writeArgs(uint8_t level, uint8_t module, const char* format, va_list args);
+    static void commitEntry(LogEntry* entry, uint32_t index);
+    static bool readEntry(uint32_t index, LogEntry* copy);
+    static void formatEntry(const LogEntry& entry, char* buffer, size_t size, bool withTimestamp);
+    static void drainToSerial();
+    static void formatTask(void* parameter);
     
     // Get log level as string
-    static String levelToString(uint8_t level);
+    static const char* levelToString(uint8_t level);
     
     // Format timestamp for display
     static String formatTimestamp(unsigned long timestamp);
 };
 
-// Macro for including file and line information in logs
-#define LOG_VERBOSE(msg) Logger::verbose("[" + String(__FILE__) + ":" + String(__LINE__) + "] " + msg)
-#define LOG_DEBUG(msg)   Logger::debug("[" + String(__FILE__) + ":" + String(__LINE__) + "] " + msg)
-#define LOG_INFO(msg)    Logger::info(msg)
-#define LOG_WARNING(msg) Logger::warning(msg)
-#define LOG_ERROR(msg)   Logger::error("[" + String(__FILE__) + ":" + String(__LINE__) + "] " + msg)
+// Module of the current translation unit - define LOG_MODULE before any include to change it
+#ifndef LOG_MODULE
+#define LOG_MODULE LOG_MODULE_GENERAL
+#endif
+
+// The level and module are checked before msg is evaluated, so a filtered
+// message costs one compare and never builds its String
+#define LOG_AT(level, file, line, msg) \
+    do { \
+        if (Logger::isEnabled(level, LOG_MODULE)) { \
+            Logger::log(level, LOG_MODULE, file, line, msg); \
+        } \
+    } while (0)
+// Kept type-checked so variables used only in logs stay referenced, but never executed
+#define LOG_DISCARD(msg) do { if (0) { (void)(msg); } } while (0)
+
+// Macros for including file and line information in logs - the file name is
+// stored as a pointer, not concatenated into the message.
+// Levels below LOG_COMPILE_LEVEL are removed at build time.
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(msg) LOG_AT(LOG_LEVEL_VERBOSE, __FILE__, __LINE__, msg)
+#else
+#define LOG_VERBOSE(msg) LOG_DISCARD(msg)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(msg)   LOG_AT(LOG_LEVEL_DEBUG, __FILE__, __LINE__, msg)
+#else
+#define LOG_DEBUG(msg)   LOG_DISCARD(msg)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(msg)    LOG_AT(LOG_LEVEL_INFO, nullptr, 0, msg)
+#else
+#define LOG_INFO(msg)    LOG_DISCARD(msg)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARNING
+#define LOG_WARNING(msg) LOG_AT(LOG_LEVEL_WARNING, nullptr, 0, msg)
+#else
+#define LOG_WARNING(msg) LOG_DISCARD(msg)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(msg)   LOG_AT(LOG_LEVEL_ERROR, __FILE__, __LINE__, msg)
+#else
+#define LOG_ERROR(msg)   LOG_DISCARD(msg)
+#endif
 
-#endif // ESP32_ARTNET_LOGGER_H
\ No newline at end of file
+#endif // ESP32_ARTNET_LOGGER_H
@@ -6,6 +6,8 @@
  * Created: April 2025
  */
 
+#define LOG_MODULE LOG_MODULE_NETWORK
+
 #include "NetworkManager.h"
 #include "esp_netif.h"
 #include "esp_event.h"
@@ -19,6 +21,9 @@ bool NetworkManager::_apFallbackEnabled = WIFI_AP_FALLBACK_ENABLED;
 bool NetworkManager::_networkInitialized = false;
 bool NetworkManager::_networkInitFailed = false;
 unsigned long NetworkManager::_lastReconnectAttempt = 0;
+unsigned long NetworkManager::_outageStartTime = 0;
+unsigned long NetworkManager::_nextReconnectTime = 0;
+uint32_t NetworkManager::_reconnectDelayMs = WIFI_RECONNECT_MIN_MS;
 unsigned long NetworkManager::_apStartTime = 0;
 String NetworkManager::_hostname = MDNS_DEVICE_NAME;
 String NetworkManager::_ssid = "";
@@ -26,6 +31,10 @@ String NetworkManager::_password = "";
 SystemSettings* NetworkManager::_settings = nullptr;
 SystemStatus* NetworkManager::_status = nullptr;
 std::mutex NetworkManager::_networkMutex;
+EventGroupHandle_t NetworkManager::_networkEvents = NULL;
+uint8_t NetworkManager::_cachedBssid[6] = {0};
+uint8_t NetworkManager::_cachedChannel = 0;
+bool NetworkManager::_fastConnectAttempt = false;
 
 // Initialize the network manager
 bool NetworkManager::init(SystemSettings* settings, SystemStatus* status) {
@@ -69,14 +78,27 @@ bool NetworkManager::init(SystemSettings* settings, SystemStatus* status) {
             return false;
         }
         
-        // Configure WiFi
+        // Event group the WiFi event handler signals the network task through
+        if (_networkEvents == NULL) {
+            _networkEvents = xEventGroupCreate();
+            if (_networkEvents == NULL) {
+                LOG_ERROR("Failed to create network event group");
+                disableNetworkOperations();
+                return false;
+            }
+        }
+        
+        // Configure WiFi - reconnection is driven by the network task
         WiFi.persistent(false);
+        WiFi.setAutoReconnect(false);
         WiFi.disconnect(true);
-        delay(200); // Stabilization delay
         
         // Set up WiFi event handler
         WiFi.onEvent(WiFiEvent);
         
+        // Load the access point of the last successful connection
+        loadCachedAccessPoint();
+        
         // Set hostname
         if (!_hostname.isEmpty()) {
             WiFi.setHostname(_hostname.c_str());
@@ -170,21 +192,28 @@ bool NetworkManager::connectToWiFi() {
         return false;
     }
     
-    LOG_INFO("Connecting to WiFi SSID: " + _ssid);
-    
     // Update state
     _networkState = NETWORK_CONNECTING;
+    _lastReconnectAttempt = millis();
+    if (_outageStartTime == 0) {
+        _outageStartTime = _lastReconnectAttempt;
+    }
     updateStatus();
     
-    // Set WiFi mode
     WiFi.mode(WIFI_STA);
-    delay(100);
     
-    // Start connection with timeout
-    _lastReconnectAttempt = millis();
-    WiFi.begin(_ssid.c_str(), _password.c_str());
+    // Skip the scan when the last access point is known; a failed fast
+    // attempt clears the cache so the next one scans all channels
+    _fastConnectAttempt = _cachedChannel != 0;
+    if (_fastConnectAttempt) {
+        LOG_INFO("Connecting to WiFi SSID: " + _ssid + " (cached channel " + String(_cachedChannel) + ")");
+        WiFi.begin(_ssid.c_str(), _password.c_str(), _cachedChannel, _cachedBssid);
+    } else {
+        LOG_INFO("Connecting to WiFi SSID: " + _ssid);
+        WiFi.begin(_ssid.c_str(), _password.c_str());
+    }
     
-    // Non-blocking connection check to be handled in update()
+    // Completion is reported through WiFiEvent()
     return true;
 }
 
@@ -200,11 +229,9 @@ bool NetworkManager::startAccessPoint() {
     
     // Disconnect from any existing network
     WiFi.disconnect(true);
-    delay(100);
     
     // Set WiFi mode
     WiFi.mode(WIFI_AP);
-    delay(100);
     
     // Configure AP
     bool result = WiFi.softAP(
@@ -232,79 +259,97 @@ bool NetworkManager::startAccessPoint() {
     return true;
 }
 
-// Reconnect to WiFi if disconnected
+// Request an immediate reconnection attempt (resets the backoff)
 bool NetworkManager::reconnect() {
     // Don't attempt to reconnect if network is disabled or failed
     if (_networkState == NETWORK_DISABLED || _networkState == NETWORK_FAILED) {
         return false;
     }
     
-    // Check if it's time to attempt reconnection
-    unsigned long currentMillis = millis();
-    if (currentMillis - _lastReconnectAttempt < WIFI_RECONNECT_INTERVAL_MS) {
-        return false; // Not time to reconnect yet
+    if (_networkEvents == NULL) {
+        return false;
     }
     
-    // Attempt to reconnect
-    LOG_INFO("Attempting WiFi reconnection");
-    return connectToWiFi();
+    xEventGroupSetBits(_networkEvents, EVENT_RECONNECT);
+    return true;
 }
 
-// Update network status (call periodically)
+// Refresh the status snapshot - state changes happen in the network task
 void NetworkManager::update() {
     // Skip update if network is disabled or failed
     if (_networkState == NETWORK_DISABLED || _networkState == NETWORK_FAILED) {
         return;
     }
     
-    // Get current time
-    unsigned long currentMillis = millis();
+    // Update system status
+    updateStatus();
+}
+
+// Apply the events signalled since the last wake-up
+void NetworkManager::handleEvents(EventBits_t bits) {
+    unsigned long now = millis();
+    
+    // GOT_IP also fires on DHCP renewals while connected
+    if ((bits & EVENT_GOT_IP) && _networkState != NETWORK_CONNECTED) {
+        LOG_INFO("WiFi connected. IP address: " + WiFi.localIP().toString() +
+                 " (" + String(now - _outageStartTime) + " ms)");
+        _networkState = NETWORK_CONNECTED;
+        _outageStartTime = 0;
+        _reconnectDelayMs = WIFI_RECONNECT_MIN_MS;
+        storeCachedAccessPoint();
+        
+        // Set up mDNS
+        setupMDNS(_hostname.isEmpty() ? MDNS_DEVICE_NAME : _hostname);
+    }
+    
+    if (bits & EVENT_DISCONNECTED) {
+        if (_networkState == NETWORK_CONNECTED && WiFi.status() != WL_CONNECTED) {
+            // The link was up - retry straight away on the cached AP
+            LOG_WARNING("WiFi connection lost");
+            _outageStartTime = now;
+            _reconnectDelayMs = WIFI_RECONNECT_MIN_MS;
+            _networkState = NETWORK_DISCONNECTED;
+            _nextReconnectTime = now;
+        } else if (_networkState == NETWORK_CONNECTING) {
+            connectionFailed(now);
+        }
+    }
     
-    // Handle different network states
+    if ((bits & EVENT_AP_STOP) && _networkState == NETWORK_AP_MODE) {
+        _networkState = NETWORK_DISCONNECTED;
+        scheduleReconnect(now);
+    }
+    
+    if ((bits & EVENT_RECONNECT) && _networkState != NETWORK_CONNECTED) {
+        LOG_INFO("Attempting WiFi reconnection");
+        _reconnectDelayMs = WIFI_RECONNECT_MIN_MS;
+        connectToWiFi();
+    }
+}
+
+// Act on the backoff, connect or AP timeout that has come due
+void NetworkManager::handleDeadline(unsigned long now) {
     switch (_networkState) {
-        case NETWORK_CONNECTING:
-            // Check if connection succeeded
-            if (WiFi.status() == WL_CONNECTED) {
-                LOG_INFO("WiFi connected. IP address: " + WiFi.localIP().toString());
-                _networkState = NETWORK_CONNECTED;
-                
-                // Set up mDNS
-                setupMDNS(_hostname.isEmpty() ? MDNS_DEVICE_NAME : _hostname);
-            }
-            // Check if connection timed out
-            else if (currentMillis - _lastReconnectAttempt > WIFI_CONNECT_TIMEOUT_MS) {
-                LOG_WARNING("WiFi connection timed out");
-                
-                // If AP fallback is enabled, start AP mode
-                if (_apFallbackEnabled) {
-                    LOG_INFO("Falling back to Access Point mode");
-                    startAccessPoint();
-                } else {
-                    _networkState = NETWORK_DISCONNECTED;
-                }
-            }
-            break;
-            
-        case NETWORK_CONNECTED:
-            // Check if we lost connection
-            if (WiFi.status() != WL_CONNECTED) {
-                LOG_WARNING("WiFi connection lost");
-                _networkState = NETWORK_DISCONNECTED;
-                
-                // Attempt to reconnect immediately
-                reconnect();
+        case NETWORK_CONNECTING: {
+            uint32_t timeout = _fastConnectAttempt ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS;
+            if (now - _lastReconnectAttempt >= timeout) {
+                LOG_WARNING("WiFi connection attempt timed out");
+                connectionFailed(now);
             }
             break;
+        }
             
         case NETWORK_DISCONNECTED:
-            // Try to reconnect if it's time
-            reconnect();
+            if ((long)(now - _nextReconnectTime) >= 0) {
+                connectToWiFi();
+            }
             break;
             
         case NETWORK_AP_MODE:
             // Check if AP mode timeout has been reached (if enabled)
-            if (WIFI_AP_TIMEOUT_MS > 0 && currentMillis - _apStartTime > WIFI_AP_TIMEOUT_MS) {
+            if (WIFI_AP_TIMEOUT_MS > 0 && now - _apStartTime > WIFI_AP_TIMEOUT_MS) {
                 LOG_INFO("AP mode timeout reached, attempting to reconnect to WiFi");
+                _outageStartTime = 0;
                 connectToWiFi();
             }
             break;
@@ -312,9 +357,110 @@ void NetworkManager::update() {
         default:
             break;
     }
+}
+
+// Time until the next deadline of the current state, portMAX_DELAY if none
+TickType_t NetworkManager::ticksUntilDeadline(unsigned long now) {
+    unsigned long deadline;
     
-    // Update system status
-    updateStatus();
+    switch (_networkState) {
+        case NETWORK_CONNECTING:
+            deadline = _lastReconnectAttempt +
+                       (_fastConnectAttempt ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_CONNECT_TIMEOUT_MS);
+            break;
+            
+        case NETWORK_DISCONNECTED:
+            deadline = _nextReconnectTime;
+            break;
+            
+        case NETWORK_AP_MODE:
+            if (WIFI_AP_TIMEOUT_MS == 0) {
+                return portMAX_DELAY;
+            }
+            deadline = _apStartTime + WIFI_AP_TIMEOUT_MS + 1;
+            break;
+            
+        default:
+            return portMAX_DELAY;
+    }
+    
+    long remaining = (long)(deadline - now);
+    return remaining > 0 ? pdMS_TO_TICKS(remaining) : 0;
+}
+
+// A connection attempt failed - retry with backoff or fall back to AP mode
+void NetworkManager::connectionFailed(unsigned long now) {
+    if (_fastConnectAttempt) {
+        // The AP may have moved channel; the next attempt does a full scan
+        LOG_INFO("Fast reconnect failed, clearing cached access point");
+        _cachedChannel = 0;
+        _fastConnectAttempt = false;
+    }
+    
+    if (_apFallbackEnabled && now - _outageStartTime >= WIFI_CONNECT_TIMEOUT_MS) {
+        LOG_INFO("Falling back to Access Point mode");
+        startAccessPoint();
+        return;
+    }
+    
+    _networkState = NETWORK_DISCONNECTED;
+    scheduleReconnect(now);
+}
+
+// Arm the next reconnection attempt and double the delay for the one after
+void NetworkManager::scheduleReconnect(unsigned long now) {
+    _nextReconnectTime = now + _reconnectDelayMs;
+    LOG_DEBUG("Next WiFi attempt in " + String(_reconnectDelayMs) + " ms");
+    
+    _reconnectDelayMs *= 2;
+    if (_reconnectDelayMs > WIFI_RECONNECT_INTERVAL_MS) {
+        _reconnectDelayMs = WIFI_RECONNECT_INTERVAL_MS;
+    }
+}
+
+// Load the BSSID/channel saved after the last successful connection
+void NetworkManager::loadCachedAccessPoint() {
+    Preferences cache;
+    _cachedChannel = 0;
+    
+    if (!cache.begin(WIFI_CACHE_NAMESPACE, true)) {
+        return;
+    }
+    
+    // Only valid for the network it was recorded on
+    if (cache.getString("ssid") == _ssid &&
+        cache.getBytes("bssid", _cachedBssid, sizeof(_cachedBssid)) == sizeof(_cachedBssid)) {
+        _cachedChannel = cache.getUChar("channel", 0);
+    }
+    cache.end();
+    
+    if (_cachedChannel != 0) {
+        LOG_DEBUG("Cached access point on channel " + String(_cachedChannel));
+    }
+}
+
+// Save the current BSSID/channel, writing flash only when they changed
+void NetworkManager::storeCachedAccessPoint() {
+    uint8_t* bssid = WiFi.BSSID();
+    uint8_t channel = (uint8_t)WiFi.channel();
+    
+    if (bssid == NULL || channel == 0) {
+        return;
+    }
+    if (channel == _cachedChannel && memcmp(bssid, _cachedBssid, sizeof(_cachedBssid)) == 0) {
+        return;
+    }
+    
+    memcpy(_cachedBssid, bssid, sizeof(_cachedBssid));
+    _cachedChannel = channel;
+    
+    Preferences cache;
+    if (cache.begin(WIFI_CACHE_NAMESPACE, false)) {
+        cache.putString("ssid", _ssid);
+        cache.putBytes("bssid", _cachedBssid, sizeof(_cachedBssid));
+        cache.putUChar("channel", _cachedChannel);
+        cache.end();
+    }
 }
 
 // Get current network state
@@ -420,10 +566,13 @@ void NetworkManager::setCredentials(const String& ssid, const String& password)
     _ssid = ssid;
     _password = password;
     
+    // The cached access point belongs to the old network
+    _cachedChannel = 0;
+    
     // If we're changing credentials and already connected, reconnect
     if (_networkInitialized && _networkState == NETWORK_CONNECTED) {
         LOG_INFO("Credentials changed, reconnecting to WiFi");
-        connectToWiFi();
+        WiFi.disconnect();
     }
 }
 
@@ -442,13 +591,16 @@ void NetworkManager::networkTask(void* parameter) {
         NetworkManager::connectToWiFi();
     }
     
-    // Task loop
+    // Task loop - sleeps until a WiFi event or the next deadline
     while (true) {
-        // Update network status
-        NetworkManager::update();
+        TickType_t wait = ticksUntilDeadline(millis());
+        EventBits_t bits = xEventGroupWaitBits(_networkEvents, EVENT_ALL, pdTRUE, pdFALSE, wait);
+        
+        handleEvents(bits);
+        handleDeadline(millis());
         
-        // Yield to other tasks
-        vTaskDelay(pdMS_TO_TICKS(100));
+        // Update system status
+        updateStatus();
     }
 }
 
@@ -456,27 +608,21 @@ void NetworkManager::networkTask(void* parameter) {
 void NetworkManager::WiFiEvent(WiFiEvent_t event) {
     switch (event) {
         case SYSTEM_EVENT_STA_GOT_IP:
-            LOG_INFO("WiFi connected with IP: " + WiFi.localIP().toString());
-            _networkState = NETWORK_CONNECTED;
+            xEventGroupSetBits(_networkEvents, EVENT_GOT_IP);
             break;
             
         case SYSTEM_EVENT_STA_DISCONNECTED:
             LOG_WARNING("WiFi disconnected");
-            if (_networkState == NETWORK_CONNECTED) {
-                _networkState = NETWORK_DISCONNECTED;
-            }
+            xEventGroupSetBits(_networkEvents, EVENT_DISCONNECTED);
             break;
             
         case SYSTEM_EVENT_AP_START:
             LOG_INFO("Access Point started");
-            _networkState = NETWORK_AP_MODE;
             break;
             
         case SYSTEM_EVENT_AP_STOP:
             LOG_INFO("Access Point stopped");
-            if (_networkState == NETWORK_AP_MODE) {
-                _networkState = NETWORK_DISCONNECTED;
-            }
+            xEventGroupSetBits(_networkEvents, EVENT_AP_STOP);
             break;
             
         case SYSTEM_EVENT_AP_STACONNECTED:
@@ -491,9 +637,6 @@ void NetworkManager::WiFiEvent(WiFiEvent_t event) {
             // Ignore other events
             break;
     }
-    
-    // Update status
-    updateStatus();
 }
 
 // TCP/IP stack initialization
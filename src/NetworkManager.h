@@ -21,6 +21,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/event_groups.h>
+#include <Preferences.h>
 #include <mutex>
 
 class NetworkManager {
@@ -40,10 +41,10 @@ public:
     // Start AP mode
     static bool startAccessPoint();
     
-    // Reconnect to WiFi if disconnected
+    // Request an immediate reconnection attempt (resets the backoff)
     static bool reconnect();
     
-    // Update network status (call periodically)
+    // Refresh the status snapshot (connection handling is event-driven)
     static void update();
     
     // Get current network state
@@ -81,8 +82,30 @@ private:
     static hw_timer_t* _watchdogTimer;
     static void IRAM_ATTR watchdogCallback();
     
-    // Event handlers
+    // Event handlers - WiFiEvent runs in the WiFi event task and only
+    // signals _networkEvents; the network task owns the state machine
     static void WiFiEvent(WiFiEvent_t event);
+    static void handleEvents(EventBits_t bits);
+    static void handleDeadline(unsigned long now);
+    static TickType_t ticksUntilDeadline(unsigned long now);
+    static void connectionFailed(unsigned long now);
+    static void scheduleReconnect(unsigned long now);
+    
+    // Event group bits set by WiFiEvent() and reconnect()
+    static const EventBits_t EVENT_GOT_IP = BIT0;
+    static const EventBits_t EVENT_DISCONNECTED = BIT1;
+    static const EventBits_t EVENT_AP_STOP = BIT2;
+    static const EventBits_t EVENT_RECONNECT = BIT3;
+    static const EventBits_t EVENT_ALL = EVENT_GOT_IP | EVENT_DISCONNECTED | EVENT_AP_STOP | EVENT_RECONNECT;
+    static EventGroupHandle_t _networkEvents;
+    
+    // Cached access point of the last successful connection, so a reconnect
+    // can skip the full channel scan
+    static uint8_t _cachedBssid[6];
+    static uint8_t _cachedChannel;
+    static bool _fastConnectAttempt;
+    static void loadCachedAccessPoint();
+    static void storeCachedAccessPoint();
     
     // Internal state
     static NetworkState _networkState;
@@ -90,6 +113,9 @@ private:
     static bool _networkInitialized;
     static bool _networkInitFailed;
     static unsigned long _lastReconnectAttempt;
+    static unsigned long _outageStartTime;
+    static unsigned long _nextReconnectTime;
+    static uint32_t _reconnectDelayMs;
     static unsigned long _apStartTime;
     static String _hostname;
     static String _ssid;
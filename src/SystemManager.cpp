@@ -6,6 +6,8 @@
  * Created: April 2025
  */
 
+#define LOG_MODULE LOG_MODULE_SYSTEM
+
 #include "SystemManager.h"
 #include <esp_task_wdt.h>
 #include <esp_system.h>
@@ -22,6 +24,12 @@ hw_timer_t* SystemManager::_watchdogTimer = nullptr;
 unsigned long SystemManager::_startTime = 0;
 uint32_t SystemManager::_bootCount = 0;
 unsigned long SystemManager::_lastBootTime = 0;
+TaskHandle_t SystemManager::_housekeepingTaskHandle = nullptr;
+QueueHandle_t SystemManager::_controlQueue = nullptr;
+unsigned long SystemManager::_lastTaskSample = 0;
+StoredSettings SystemManager::_storedSettings;
+volatile bool SystemManager::_settingsDirty = false;
+volatile unsigned long SystemManager::_lastSettingsChange = 0;
 
 // Initialize the system manager
 bool SystemManager::init() {
@@ -107,6 +115,32 @@ bool SystemManager::start() {
     
     // Mark as running
     _running = true;
+    
+    // Housekeeping runs on the network core at low priority, off the LED core
+    if (_controlQueue == nullptr) {
+        _controlQueue = xQueueCreate(CONTROL_QUEUE_LENGTH, sizeof(ControlMessage));
+    }
+    if (_controlQueue == nullptr) {
+        LOG_ERROR("Failed to create control queue");
+    }
+    else if (_housekeepingTaskHandle == nullptr) {
+        BaseType_t result = xTaskCreatePinnedToCore(
+            housekeepingTask,           // Task function
+            "Housekeeping",             // Name
+            HOUSEKEEPING_STACK_SIZE,    // Stack size
+            NULL,                       // Parameters
+            HOUSEKEEPING_TASK_PRIORITY, // Priority
+            &_housekeepingTaskHandle,   // Task handle
+            HOUSEKEEPING_CORE           // Core
+        );
+        
+        if (result != pdPASS) {
+            LOG_ERROR("Failed to create housekeeping task");
+            _housekeepingTaskHandle = nullptr;
+        }
+    }
+    _status.housekeepingTaskRunning = _housekeepingTaskHandle != nullptr;
+    
     LOG_INFO("System started");
     
     return true;
@@ -123,6 +157,13 @@ bool SystemManager::stop() {
     
     // TODO: Stop LED Manager when implemented
     
+    // Stop housekeeping
+    if (_housekeepingTaskHandle != nullptr) {
+        vTaskDelete(_housekeepingTaskHandle);
+        _housekeepingTaskHandle = nullptr;
+    }
+    _status.housekeepingTaskRunning = false;
+    
     // Disable watchdog
     if (_watchdogTimer != nullptr) {
         timerAlarmDisable(_watchdogTimer);
@@ -135,7 +176,7 @@ bool SystemManager::stop() {
     return true;
 }
 
-// Update the system (call from main loop)
+// Update the system - run by the housekeeping task once started
 void SystemManager::update() {
     // Skip if not running
     if (!_running) {
@@ -154,6 +195,83 @@ void SystemManager::update() {
     
     // Update system status
     updateStatus();
+    
+    // Task statistics are sampled at a slower rate than the status
+    unsigned long now = millis();
+    if (now - _lastTaskSample >= TASK_MONITOR_INTERVAL_MS) {
+        _lastTaskSample = now;
+        taskMonitorSample();
+    }
+}
+
+// Queue a request for the housekeeping task
+bool SystemManager::postControl(ControlCommand command, uint32_t value) {
+    ControlMessage message;
+    message.command = command;
+    message.value = value;
+    
+    if (_controlQueue == nullptr || xQueueSend(_controlQueue, &message, 0) != pdTRUE) {
+        _status.controlDropped++;
+        return false;
+    }
+    return true;
+}
+
+// Copy the latest task statistics
+void SystemManager::getTaskStats(TaskMonitorSnapshot* snapshot) {
+    taskMonitorGetSnapshot(snapshot);
+}
+
+// Housekeeping task - control requests, then the periodic update
+void SystemManager::housekeepingTask(void* parameter) {
+    TickType_t lastWake = xTaskGetTickCount();
+    ControlMessage message;
+    
+    while (true) {
+        // Requests wake the task early, otherwise it runs once per interval
+        TickType_t elapsed = xTaskGetTickCount() - lastWake;
+        TickType_t interval = pdMS_TO_TICKS(HOUSEKEEPING_INTERVAL_MS);
+        TickType_t wait = elapsed < interval ? interval - elapsed : 0;
+        
+        if (xQueueReceive(_controlQueue, &message, wait) == pdTRUE) {
+            handleControl(message);
+            continue;
+        }
+        
+        lastWake = xTaskGetTickCount();
+        update();
+        
+        // Scheduled saves are coalesced into one write after the quiet period
+        if (_settingsDirty && millis() - _lastSettingsChange >= SETTINGS_COMMIT_DELAY_MS) {
+            commitSettings();
+        }
+    }
+}
+
+// Act on one control request
+void SystemManager::handleControl(const ControlMessage& message) {
+    switch (message.command) {
+        case CONTROL_SAVE_SETTINGS:
+            commitSettings();
+            break;
+            
+        case CONTROL_RESET_SETTINGS:
+            resetSettings();
+            break;
+            
+        case CONTROL_NETWORK_RECONNECT:
+            if (!_inSafeMode && _settings.useWiFi) {
+                NetworkManager::reconnect();
+            }
+            break;
+            
+        case CONTROL_RESTART:
+            LOG_WARNING("Restart requested");
+            commitSettings();
+            Logger::flush();
+            esp_restart();
+            break;
+    }
 }
 
 // Set up a watchdog timer for system reliability
@@ -210,37 +328,22 @@ bool SystemManager::loadSettings() {
         _bootCount = _preferences.getUInt(BOOT_COUNT_KEY, 0);
         _lastBootTime = _preferences.getULong("lastBootTime", 0);
         
-        // Load network settings
-        _settings.useWiFi = _preferences.getBool("useWiFi", _settings.useWiFi);
-        _settings.useArtnet = _preferences.getBool("useArtnet", _settings.useArtnet);
-        _settings.createAP = _preferences.getBool("createAP", _settings.createAP);
-        _settings.ssid = _preferences.getString("ssid", _settings.ssid);
-        _settings.password = _preferences.getString("password", _settings.password);
-        _settings.deviceName = _preferences.getString("deviceName", _settings.deviceName);
-        _settings.artnetUniverse = _preferences.getUShort("artnetUni", _settings.artnetUniverse);
+        // The whole record in one read
+        StoredSettings stored;
+        packSettings(_storedSettings);
+        memcpy(&stored, &_storedSettings, sizeof(stored));
+        size_t length = _preferences.getBytes(SETTINGS_BLOB_KEY, &stored, sizeof(stored));
         
-        // Load LED settings
-        _settings.mode = _preferences.getUChar("mode", _settings.mode);
-        _settings.effectType = _preferences.getUChar("effectType", _settings.effectType);
-        _settings.effectSpeed = _preferences.getUChar("effectSpeed", _settings.effectSpeed);
-        _settings.numStrips = _preferences.getUShort("numStrips", _settings.numStrips);
-        _settings.ledsPerStrip = _preferences.getUShort("ledsPerStrip", _settings.ledsPerStrip);
-        _settings.brightness = _preferences.getUChar("brightness", _settings.brightness);
-        
-        // Load pins
-        for (int i = 0; i < MAX_LED_STRIPS; i++) {
-            String pinKey = "pin" + String(i);
-            _settings.pins[i] = _preferences.getInt(pinKey.c_str(), _settings.pins[i]);
+        if (length >= offsetof(StoredSettings, ssid) && stored.version != 0 && stored.size == length) {
+            // Fields past an older record's size keep their defaults
+            unpackSettings(stored);
+            _storedSettings = stored;
+        } else {
+            // First boot with the blob - migrate the per-key settings once
+            loadLegacySettings();
+            saveSettings();
         }
         
-        // Load static color
-        _settings.staticColor.r = _preferences.getUChar("colorR", _settings.staticColor.r);
-        _settings.staticColor.g = _preferences.getUChar("colorG", _settings.staticColor.g);
-        _settings.staticColor.b = _preferences.getUChar("colorB", _settings.staticColor.b);
-        
-        // Load safe mode flag
-        _settings.safeMode = _preferences.getBool("safeMode", _settings.safeMode);
-        
         // Close preferences
         _preferences.end();
         
@@ -264,54 +367,134 @@ bool SystemManager::loadSettings() {
     }
 }
 
-// Save settings to persistent storage
-bool SystemManager::saveSettings() {
-    LOG_INFO("Saving settings to persistent storage");
+// Read the settings stored one key per field by earlier firmware - preferences already open
+void SystemManager::loadLegacySettings() {
+    // Load network settings
+    _settings.useWiFi = _preferences.getBool("useWiFi", _settings.useWiFi);
+    _settings.useArtnet = _preferences.getBool("useArtnet", _settings.useArtnet);
+    _settings.createAP = _preferences.getBool("createAP", _settings.createAP);
+    _preferences.getString("ssid", _settings.ssid, sizeof(_settings.ssid));
+    _preferences.getString("password", _settings.password, sizeof(_settings.password));
+    _preferences.getString("deviceName", _settings.deviceName, sizeof(_settings.deviceName));
+    _settings.artnetUniverse = _preferences.getUShort("artnetUni", _settings.artnetUniverse);
+    
+    // Load LED settings
+    _settings.mode = _preferences.getUChar("mode", _settings.mode);
+    _settings.effectType = _preferences.getUChar("effectType", _settings.effectType);
+    _settings.effectSpeed = _preferences.getUChar("effectSpeed", _settings.effectSpeed);
+    _settings.numStrips = _preferences.getUShort("numStrips", _settings.numStrips);
+    _settings.ledsPerStrip = _preferences.getUShort("ledsPerStrip", _settings.ledsPerStrip);
+    _settings.brightness = _preferences.getUChar("brightness", _settings.brightness);
+    
+    // Load pins
+    for (int i = 0; i < MAX_LED_STRIPS; i++) {
+        String pinKey = "pin" + String(i);
+        _settings.pins[i] = _preferences.getInt(pinKey.c_str(), _settings.pins[i]);
+    }
     
+    // Load static color
+    _settings.staticColor.r = _preferences.getUChar("colorR", _settings.staticColor.r);
+    _settings.staticColor.g = _preferences.getUChar("colorG", _settings.staticColor.g);
+    _settings.staticColor.b = _preferences.getUChar("colorB", _settings.staticColor.b);
+    
+    // Load safe mode flag
+    _settings.safeMode = _preferences.getBool("safeMode", _settings.safeMode);
+}
+
+// Copy the settings into their stored form
+void SystemManager::packSettings(StoredSettings& stored) {
+    memset(&stored, 0, sizeof(stored));
+    stored.version = SETTINGS_BLOB_VERSION;
+    stored.size = sizeof(stored);
+    strlcpy(stored.ssid, _settings.ssid, sizeof(stored.ssid));
+    strlcpy(stored.password, _settings.password, sizeof(stored.password));
+    strlcpy(stored.deviceName, _settings.deviceName, sizeof(stored.deviceName));
+    stored.useWiFi = _settings.useWiFi;
+    stored.createAP = _settings.createAP;
+    stored.useArtnet = _settings.useArtnet;
+    stored.artnetUniverse = _settings.artnetUniverse;
+    stored.mode = _settings.mode;
+    stored.effectType = _settings.effectType;
+    stored.effectSpeed = _settings.effectSpeed;
+    stored.numStrips = _settings.numStrips;
+    stored.ledsPerStrip = _settings.ledsPerStrip;
+    for (int i = 0; i < MAX_LED_STRIPS; i++) {
+        stored.pins[i] = _settings.pins[i];
+    }
+    stored.brightness = _settings.brightness;
+    stored.colorR = _settings.staticColor.r;
+    stored.colorG = _settings.staticColor.g;
+    stored.colorB = _settings.staticColor.b;
+    stored.safeMode = _settings.safeMode;
+}
+
+// Copy a stored record into the settings
+void SystemManager::unpackSettings(const StoredSettings& stored) {
+    strlcpy(_settings.ssid, stored.ssid, sizeof(_settings.ssid));
+    strlcpy(_settings.password, stored.password, sizeof(_settings.password));
+    strlcpy(_settings.deviceName, stored.deviceName, sizeof(_settings.deviceName));
+    _settings.useWiFi = stored.useWiFi;
+    _settings.createAP = stored.createAP;
+    _settings.useArtnet = stored.useArtnet;
+    _settings.artnetUniverse = stored.artnetUniverse;
+    _settings.mode = stored.mode;
+    _settings.effectType = stored.effectType;
+    _settings.effectSpeed = stored.effectSpeed;
+    _settings.numStrips = stored.numStrips;
+    _settings.ledsPerStrip = stored.ledsPerStrip;
+    for (int i = 0; i < MAX_LED_STRIPS; i++) {
+        _settings.pins[i] = stored.pins[i];
+    }
+    _settings.brightness = stored.brightness;
+    _settings.staticColor.r = stored.colorR;
+    _settings.staticColor.g = stored.colorG;
+    _settings.staticColor.b = stored.colorB;
+    _settings.safeMode = stored.safeMode;
+}
+
+// Schedule a save - safe to call from any task, the write happens later
+bool SystemManager::saveSettings() {
+    _lastSettingsChange = millis();
+    _settingsDirty = true;
+    return true;
+}
+
+// Write the settings blob if it differs from the stored one
+bool SystemManager::commitSettings() {
     // Lock mutex for thread safety
     std::lock_guard<std::mutex> lock(_systemMutex);
     
+    _settingsDirty = false;
+    StoredSettings stored;
+    packSettings(stored);
+    
+    // An unchanged record costs no flash write
+    if (memcmp(&stored, &_storedSettings, sizeof(stored)) == 0) {
+        return true;
+    }
+    
+    LOG_INFO("Saving settings to persistent storage");
+    
     try {
         // Open preferences
         if (!_preferences.begin(PREFERENCES_NAMESPACE, false)) {
             LOG_ERROR("Failed to open preferences");
+            _settingsDirty = true;
             return false;
         }
         
-        // Save network settings
-        _preferences.putBool("useWiFi", _settings.useWiFi);
-        _preferences.putBool("useArtnet", _settings.useArtnet);
-        _preferences.putBool("createAP", _settings.createAP);
-        _preferences.putString("ssid", _settings.ssid);
-        _preferences.putString("password", _settings.password);
-        _preferences.putString("deviceName", _settings.deviceName);
-        _preferences.putUShort("artnetUni", _settings.artnetUniverse);
-        
-        // Save LED settings
-        _preferences.putUChar("mode", _settings.mode);
-        _preferences.putUChar("effectType", _settings.effectType);
-        _preferences.putUChar("effectSpeed", _settings.effectSpeed);
-        _preferences.putUShort("numStrips", _settings.numStrips);
-        _preferences.putUShort("ledsPerStrip", _settings.ledsPerStrip);
-        _preferences.putUChar("brightness", _settings.brightness);
+        size_t written = _preferences.putBytes(SETTINGS_BLOB_KEY, &stored, sizeof(stored));
+        _preferences.end();
         
-        // Save pins
-        for (int i = 0; i < MAX_LED_STRIPS; i++) {
-            String pinKey = "pin" + String(i);
-            _preferences.putInt(pinKey.c_str(), _settings.pins[i]);
+        if (written != sizeof(stored)) {
+            // Retried after the next quiet period
+            LOG_ERROR("Failed to write settings blob");
+            _lastSettingsChange = millis();
+            _settingsDirty = true;
+            return false;
         }
         
-        // Save static color
-        _preferences.putUChar("colorR", _settings.staticColor.r);
-        _preferences.putUChar("colorG", _settings.staticColor.g);
-        _preferences.putUChar("colorB", _settings.staticColor.b);
-        
-        // Save safe mode flag
-        _preferences.putBool("safeMode", _settings.safeMode);
-        
-        // Close preferences
-        _preferences.end();
-        
+        memcpy(&_storedSettings, &stored, sizeof(stored));
         LOG_INFO("Settings saved successfully");
         return true;
     }
@@ -343,6 +526,8 @@ bool SystemManager::resetSettings() {
         
         // Clear all preferences
         _preferences.clear();
+        memset(&_storedSettings, 0, sizeof(_storedSettings));
+        _settingsDirty = false;
         
         // Close preferences
         _preferences.end();
@@ -484,13 +669,13 @@ bool SystemManager::initHardware() {
 // Load default settings
 void SystemManager::loadDefaultSettings() {
     // WiFi settings
-    _settings.ssid = "";
-    _settings.password = "";
+    _settings.ssid[0] = '\0';
+    _settings.password[0] = '\0';
     _settings.useWiFi = true;
     _settings.createAP = WIFI_AP_FALLBACK_ENABLED;
     
     // Device identification
-    _settings.deviceName = MDNS_DEVICE_NAME;
+    strlcpy(_settings.deviceName, MDNS_DEVICE_NAME, sizeof(_settings.deviceName));
     
     // ArtNet settings
     _settings.useArtnet = true;
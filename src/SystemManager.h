@@ -15,8 +15,12 @@
 #include "Config.h"
 #include "Logger.h"
 #include "NetworkManager.h"
+#include "TaskMonitor.h"
 #include <Arduino.h>
 #include <Preferences.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
 #include <mutex>
 
 class SystemManager {
@@ -24,15 +28,21 @@ public:
     // Initialize the system manager
     static bool init();
     
-    // Start the system
+    // Start the system and its housekeeping task
     static bool start();
     
     // Stop the system
     static bool stop();
     
-    // Update the system (call from main loop)
+    // Update the system - run by the housekeeping task once started
     static void update();
     
+    // Queue a request for the housekeeping task (non-blocking, false if the queue is full)
+    static bool postControl(ControlCommand command, uint32_t value = 0);
+    
+    // Copy the latest task statistics (TaskMonitor snapshot)
+    static void getTaskStats(TaskMonitorSnapshot* snapshot);
+    
     // Set up a watchdog timer for system reliability
     static bool setupWatchdog(uint32_t timeoutMs = WATCHDOG_TIMEOUT_MS);
     
@@ -42,9 +52,13 @@ public:
     // Load settings from persistent storage
     static bool loadSettings();
     
-    // Save settings to persistent storage
+    // Schedule a save - written by the housekeeping task once the settings
+    // have not changed for SETTINGS_COMMIT_DELAY_MS
     static bool saveSettings();
     
+    // Write scheduled changes now; a record equal to the stored one is not rewritten
+    static bool commitSettings();
+    
     // Reset settings to defaults
     static bool resetSettings();
     
@@ -89,6 +103,15 @@ private:
     static hw_timer_t* _watchdogTimer;
     static unsigned long _startTime;
     
+    // Housekeeping task and its control queue
+    static TaskHandle_t _housekeepingTaskHandle;
+    static QueueHandle_t _controlQueue;
+    static void housekeepingTask(void* parameter);
+    static void handleControl(const ControlMessage& message);
+    
+    // Last TaskMonitor sample
+    static unsigned long _lastTaskSample;
+    
     // Watchdog callback
     static void IRAM_ATTR watchdogCallback();
     
@@ -98,6 +121,14 @@ private:
     // Load default settings
     static void loadDefaultSettings();
     
+    // Settings blob - the record last written, and the pending-save state
+    static void packSettings(StoredSettings& stored);
+    static void unpackSettings(const StoredSettings& stored);
+    static void loadLegacySettings();
+    static StoredSettings _storedSettings;
+    static volatile bool _settingsDirty;
+    static volatile unsigned long _lastSettingsChange;
+    
     // Update system status
     static void updateStatus();
     